@@ -0,0 +1,97 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t x_dim = 2;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr size_t burst_dim = 3;
+constexpr Real_T burst_t[burst_dim] = {.5, 1.3, 1.7}; //* burst times [s]
+constexpr Real_T burst_width = 1e-3;                  //* burst width [s]
+constexpr Real_T tol = 1e-8;
+
+struct Dynamics {
+	/*
+	 * Damped oscillator driven by short bursts:
+	 * dt_x = [x2; -x1 - x2/10 + u(t)]
+	 */
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		Real_T u = 0;
+
+		for (size_t i = 0; i < burst_dim; ++i) {
+			const Real_T s = (t - burst_t[i]) / burst_width;
+			u += 1e2 * std::exp(-s * s);
+		}
+		dt_x[0] = x[1];
+		dt_x[1] = -x[0] - x[1] / 10 + u;
+		++eval_count;
+	}
+	size_t eval_count = 0;
+};
+Dynamics dynamics;
+
+/*
+ * Integrates with the fixed-step integrator and returns the final state
+ */
+template <size_t SAMPLE_FREQ>
+void
+run_fixed(Real_T (&x)[x_dim], Real_T &since_s)
+{
+	constexpr size_t t_dim = SAMPLE_FREQ * (t_final - t_init) + 1;
+	Real_T t;
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+	                                                   1. / SAMPLE_FREQ);
+	dynamics.eval_count = 0;
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	since_s = std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	since_s /= 1e9;
+}
+
+int
+main()
+{
+	Real_T x_ref[x_dim];
+	Real_T since_s;
+	run_fixed<static_cast<size_t>(1e6)>(x_ref, since_s);
+
+	printf("Integrating a damped oscillator with %zu bursts of %.3g s for %.3g s.\n", burst_dim,
+	       burst_width, t_final - t_init);
+	printf("%-28s %12s %12s %12s\n", "integrator", "RHS evals", "error", "time (ms)");
+
+	Real_T x[x_dim];
+	run_fixed<static_cast<size_t>(1e3)>(x, since_s);
+	printf("%-28s %12zu %12.3g %12.3g\n", "fixed-step RK4 at 1e3 Hz", dynamics.eval_count,
+	       std::hypot(x[0] - x_ref[0], x[1] - x_ref[1]), since_s * 1e3);
+	run_fixed<static_cast<size_t>(1e4)>(x, since_s);
+	printf("%-28s %12zu %12.3g %12.3g\n", "fixed-step RK4 at 1e4 Hz", dynamics.eval_count,
+	       std::hypot(x[0] - x_ref[0], x[1] - x_ref[1]), since_s * 1e3);
+	run_fixed<static_cast<size_t>(1e5)>(x, since_s);
+	printf("%-28s %12zu %12.3g %12.3g\n", "fixed-step RK4 at 1e5 Hz", dynamics.eval_count,
+	       std::hypot(x[0] - x_ref[0], x[1] - x_ref[1]), since_s * 1e3);
+
+	//* the maximum step size must be small enough not to step over a whole burst
+	Real_T t;
+	rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+	                                                           tol, tol, 10 * burst_width);
+	dynamics.eval_count = 0;
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	const size_t step_count = rk4_solver::loop(integrator, t_init, x_init, t_final, t, x);
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	since_s = std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	since_s /= 1e9;
+	printf("%-28s %12zu %12.3g %12.3g\n", "adaptive DOPRI5 at tol 1e-8", dynamics.eval_count,
+	       std::hypot(x[0] - x_ref[0], x[1] - x_ref[1]), since_s * 1e3);
+	printf("(%zu accepted and %zu rejected adaptive steps)\n", step_count,
+	       integrator.get_reject_count());
+
+	return 0;
+}
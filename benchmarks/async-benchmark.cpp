@@ -0,0 +1,162 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e4;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e2;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t chunk_dim = 256;
+constexpr size_t queue_dim = 16;
+constexpr size_t ring_dim = 4096;
+constexpr size_t repeat_dim = 3;
+constexpr size_t io_delay_us = 200; //* stall of the sinks, e.g. a disk write
+constexpr size_t stall_period = 32;  //* chunks per stall of the stalling sink
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -1e-1 * dt_x[0] - 1e-2 * x[1] - 1e-3 * x[2];
+	}
+};
+Dynamics dynamics;
+
+/*
+ * Sink that stalls for `io_delay_us` every `period`th chunk without using the CPU, and counts the
+ * samples. It keeps up with the integration on average if it stalls every `stall_period`th chunk,
+ * but not if it stalls every chunk.
+ */
+struct SlowSink {
+	static constexpr size_t chunk_dim = ::chunk_dim;
+
+	explicit SlowSink(const size_t period) : period(period)
+	{
+	}
+
+	void
+	write(const Real_T (&)[chunk_dim], const Real_T (&)[chunk_dim][x_dim], const size_t count)
+	{
+		if (chunk_count % period == 0) {
+			std::this_thread::sleep_for(std::chrono::microseconds(io_delay_us));
+		}
+		++chunk_count;
+		sample_count += count;
+	}
+
+	const size_t period;
+	size_t chunk_count = 0;
+	size_t sample_count = 0;
+};
+
+/*
+ * Returns the shortest time of `repeat_dim` runs of `fun` [s].
+ */
+template <typename Fun_T>
+Real_T
+time_runs(Fun_T fun)
+{
+	Real_T min_s = 0;
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		fun();
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s;
+}
+
+void
+print_row(const char *name, const Real_T since_s, const Real_T none_s, const Real_T written_frac)
+{
+	printf("%-28s %16.3g %16.3g %12.3g\n", name, t_dim / since_s, since_s / none_s,
+	       written_frac);
+}
+
+//* times the loop into the sink that stalls every `period`th chunk on the integrating thread
+void
+run_sync(const char *name, const size_t period, const Real_T none_s)
+{
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	SlowSink slow_sink(period);
+
+	const Real_T since_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, slow_sink);
+	});
+	print_row(name, since_s, none_s, 1);
+}
+
+/*
+ * Times the loop into the sink that stalls every `period`th chunk on a consumer thread with
+ * `backpressure`. The loop does not wait for the consumer thread, so the time to write the queued
+ * chunks is not included.
+ */
+void
+run_async(const char *name, const size_t period, const rk4_solver::Backpressure backpressure,
+          const Real_T none_s)
+{
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	SlowSink slow_sink(period);
+	rk4_solver::AsyncSink<queue_dim, x_dim, SlowSink> async_sink(slow_sink, backpressure);
+
+	const Real_T since_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, async_sink);
+	});
+	async_sink.flush();
+	print_row(name, since_s, none_s,
+	          static_cast<Real_T>(slow_sink.sample_count) / async_sink.get_total_count());
+}
+
+int
+main()
+{
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	Real_T t;
+	Real_T x[x_dim];
+
+	printf("Integrating 3rd order linear ODE for %.3g steps, in chunks of %zu samples.\n",
+	       static_cast<Real_T>(t_dim), chunk_dim);
+	printf("The sinks stall for %zu us every %zu chunks or every chunk, the queue holds %zu "
+	       "chunks.\n",
+	       io_delay_us, stall_period, queue_dim);
+	printf("%-28s %16s %16s %12s\n", "output", "steps/s", "relative time", "written");
+
+	const Real_T none_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	});
+	print_row("none", none_s, none_s, 0);
+
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ring_sink;
+	const Real_T ring_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, ring_sink);
+	});
+	print_row("ring buffer sink", ring_s, none_s, 1);
+
+	using rk4_solver::Backpressure;
+	run_sync("stalling sink", stall_period, none_s);
+	run_async("async stalling sink, block", stall_period, Backpressure::block, none_s);
+	run_sync("slow sink", 1, none_s);
+	run_async("async slow sink, block", 1, Backpressure::block, none_s);
+	run_async("async slow sink, drop", 1, Backpressure::drop, none_s);
+	run_async("async slow sink, overwrite", 1, Backpressure::overwrite_oldest, none_s);
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include "rk4_solver/batch_integrator.hpp"
+#include "rk4_solver/integrator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr size_t n_dim = 1024; //* ensemble size
+constexpr size_t step_dim = 1000;
+constexpr Real_T t_init = 0.;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+
+	/*
+	 * dt_x = A * x over the whole ensemble
+	 */
+	void
+	batch_ode_fun(const Real_T, const Real_T (&x)[x_dim][n_dim], Real_T (&dt_x)[x_dim][n_dim])
+	{
+		for (size_t j = 0; j < n_dim; ++j) {
+			dt_x[0][j] = x[1][j];
+			dt_x[1][j] = x[2][j];
+			dt_x[2][j] = -a0 * x[1][j] - a1 * x[1][j] - a2 * x[2][j];
+		}
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+Dynamics dynamics;
+
+int
+main()
+{
+	//* 1. one integrator per ensemble member
+	Real_T t_arr[n_dim];
+	Real_T(&x_arr)[n_dim][x_dim] = *(Real_T(*)[n_dim][x_dim]) new Real_T[n_dim][x_dim];
+	std::vector<rk4_solver::Integrator<x_dim, Dynamics>> integrators;
+	integrators.reserve(n_dim);
+
+	for (size_t j = 0; j < n_dim; ++j) {
+		integrators.emplace_back(dynamics, &Dynamics::ode_fun, time_step);
+		t_arr[j] = t_init;
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			x_arr[j][i] = x_init[i] * (1. + 1e-3 * j);
+		}
+	}
+
+	printf("Integrating %zu copies of 3rd order linear ODE for %zu steps one by one... ", n_dim,
+	       step_dim);
+	auto start_tp = std::chrono::high_resolution_clock::now();
+
+	for (size_t k = 0; k < step_dim; ++k) {
+		for (size_t j = 0; j < n_dim; ++j) {
+			integrators[j].step(t_arr[j], x_arr[j], t_arr[j], x_arr[j]);
+		}
+	}
+	auto now_tp = std::chrono::high_resolution_clock::now();
+	const auto single_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+
+	printf("Done.\nx[0] at t = %.3g s: [%.3g; %.3g; %.3g]\n", t_arr[0], x_arr[0][0],
+	       x_arr[0][1], x_arr[0][2]);
+	printf("Score: %.3g ensemble steps per second (%.3g member steps per second)\n",
+	       static_cast<Real_T>(step_dim) / single_ns * 1e9,
+	       static_cast<Real_T>(step_dim * n_dim) / single_ns * 1e9);
+
+	//* 2. one integrator for the whole ensemble
+	Real_T t = t_init;
+	Real_T(&x)[x_dim][n_dim] = *(Real_T(*)[x_dim][n_dim]) new Real_T[x_dim][n_dim];
+
+	for (size_t j = 0; j < n_dim; ++j) {
+		for (size_t i = 0; i < x_dim; ++i) {
+			x[i][j] = x_init[i] * (1. + 1e-3 * j);
+		}
+	}
+	rk4_solver::BatchIntegrator<n_dim, x_dim, Dynamics> batch_integrator(
+	    dynamics, &Dynamics::batch_ode_fun, time_step);
+
+	printf("Integrating %zu copies of 3rd order linear ODE for %zu steps in lockstep... ",
+	       n_dim, step_dim);
+	start_tp = std::chrono::high_resolution_clock::now();
+
+	for (size_t k = 0; k < step_dim; ++k) {
+		batch_integrator.step(t, x, t, x);
+	}
+	now_tp = std::chrono::high_resolution_clock::now();
+	const auto batch_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+
+	printf("Done.\nx[0] at t = %.3g s: [%.3g; %.3g; %.3g]\n", t, x[0][0], x[1][0], x[2][0]);
+	printf("Score: %.3g ensemble steps per second (%.3g member steps per second)\n",
+	       static_cast<Real_T>(step_dim) / batch_ns * 1e9,
+	       static_cast<Real_T>(step_dim * n_dim) / batch_ns * 1e9);
+	printf("Speed-up: %.3gx\n", static_cast<Real_T>(single_ns) / batch_ns);
+
+	return 0;
+}
@@ -0,0 +1,140 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e3;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t heat_t_dim = 100;
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+
+	void
+	dynamic_ode_fun(const Real_T, rk4_solver::Span<const Real_T> x,
+	                rk4_solver::Span<Real_T> dt_x)
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+Dynamics dynamics;
+
+struct Heat {
+	/*
+	 * Heat equation on [0, 1] with zero boundary values, discretized with central differences
+	 */
+	void
+	ode_fun(const Real_T, rk4_solver::Span<const Real_T> u, rk4_solver::Span<Real_T> dt_u)
+	{
+		const size_t n = u.size;
+		const Real_T inv_dx_sq = static_cast<Real_T>(n + 1) * (n + 1);
+
+		dt_u[0] = (-2 * u[0] + u[1]) * inv_dx_sq;
+		for (size_t i = 1; i < n - 1; ++i) {
+			dt_u[i] = (u[i - 1] - 2 * u[i] + u[i + 1]) * inv_dx_sq;
+		}
+		dt_u[n - 1] = (u[n - 2] - 2 * u[n - 1]) * inv_dx_sq;
+	}
+};
+Heat heat;
+
+/*
+ * Returns an arena aligned to 64 bytes within `buffer`, which also works with `DO_NOT_USE_HEAP`
+ */
+template <typename T>
+rk4_solver::Span<Real_T>
+make_arena(const size_t node_dim, std::vector<Real_T> &buffer)
+{
+	constexpr size_t align_dim = 64 / sizeof(Real_T);
+	const size_t arena_dim = rk4_solver::DynamicIntegrator<T>::get_arena_dim(node_dim);
+	buffer.resize(arena_dim + align_dim);
+	const size_t misalignment = reinterpret_cast<std::uintptr_t>(buffer.data()) % 64;
+	const size_t offset = (64 - misalignment) % 64 / sizeof(Real_T);
+	return {buffer.data() + offset, arena_dim};
+}
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+int
+main()
+{
+	Real_T t;
+	Real_T x[x_dim];
+	Real_T x_dyn[x_dim];
+
+	printf("Integrating 3rd order linear ODE for %.3g steps.\n", static_cast<Real_T>(t_dim));
+	printf("%-28s %16s\n", "integrator", "steps/s");
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	const Real_T fixed_s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x); });
+	printf("%-28s %16.3g\n", "Integrator", t_dim / fixed_s);
+
+	alignas(64) Real_T arena[rk4_solver::DynamicIntegrator<Dynamics>::get_arena_dim(x_dim)];
+	rk4_solver::DynamicIntegrator<Dynamics> dynamic_integrator(
+	    dynamics, &Dynamics::dynamic_ode_fun, x_dim, arena, time_step);
+	const Real_T dynamic_s = time_s(
+	    [&]() { rk4_solver::loop(dynamic_integrator, t_init, x_init, t_dim, t, x_dyn); });
+	printf("%-28s %16.3g\n", "DynamicIntegrator", t_dim / dynamic_s);
+	printf("(relative time: %.3g, final state difference: %.3g)\n\n", dynamic_s / fixed_s,
+	       x_dyn[0] - x[0]);
+
+	printf("Integrating the heat equation for %zu steps.\n", heat_t_dim);
+	printf("%-28s %16s %16s\n", "nodes", "steps/s", "node steps/s");
+
+	for (size_t node_dim = 1000; node_dim <= 1000000; node_dim *= 10) {
+		const Real_T dx = 1. / (node_dim + 1);
+		std::vector<Real_T> u_init(node_dim);
+		std::vector<Real_T> u(node_dim);
+
+		for (size_t i = 0; i < node_dim; ++i) {
+			u_init[i] = std::sin(M_PI * (i + 1) * dx);
+		}
+		//* stable for dx^2/4 * 2.78
+		std::vector<Real_T> buffer;
+		const rk4_solver::Span<Real_T> arena = make_arena<Heat>(node_dim, buffer);
+		rk4_solver::DynamicIntegrator<Heat> heat_integrator(heat, &Heat::ode_fun, node_dim,
+		                                                    arena, dx * dx / 2);
+		const rk4_solver::Span<const Real_T> u_0(u_init.data(), node_dim);
+		const rk4_solver::Span<Real_T> u_f(u.data(), node_dim);
+		const Real_T heat_s = time_s(
+		    [&]() { rk4_solver::loop(heat_integrator, t_init, u_0, heat_t_dim, t, u_f); });
+		printf("%-28zu %16.3g %16.3g\n", node_dim, heat_t_dim / heat_s,
+		       heat_t_dim * node_dim / heat_s);
+	}
+	return 0;
+}
@@ -0,0 +1,174 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e2;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t ball_dim = 32;
+constexpr size_t x_dim = 2 * ball_dim;
+constexpr Real_T e_restitution = .9;
+constexpr Real_T gravity_const = 9.806;
+constexpr size_t repeat_dim = 3;
+
+/*
+ * `ball_dim` balls bouncing on the floor from different heights, x_(2i) is the height and
+ * x_(2i+1) the velocity of the ball i
+ */
+struct Dynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		for (size_t i = 0; i < ball_dim; ++i) {
+			dt_x[2 * i] = x[2 * i + 1];
+			dt_x[2 * i + 1] = -gravity_const;
+		}
+	}
+
+	//* all impacts in one event function, which is not located within the step
+	bool
+	event_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		bool is_hit = false;
+
+		for (size_t i = 0; i < ball_dim; ++i) {
+			is_hit = is_hit || (x[2 * i] <= 0 && x[2 * i + 1] < 0);
+		}
+		if (!is_hit) {
+			return false;
+		}
+		for (size_t i = 0; i < ball_dim; ++i) {
+			const bool is_impact = x[2 * i] <= 0 && x[2 * i + 1] < 0;
+			const Real_T v_i = x[2 * i + 1];
+			x_plus[2 * i] = is_impact ? 0 : x[2 * i];
+			x_plus[2 * i + 1] = is_impact ? -e_restitution * v_i : v_i;
+		}
+		return true;
+	}
+
+	//* one guard and reset function per ball for the event set
+	template <size_t I>
+	Real_T
+	guard_fun(const Real_T, const Real_T (&x)[x_dim])
+	{
+		return x[2 * I];
+	}
+
+	template <size_t I>
+	void
+	reset_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		for (size_t i = 0; i < x_dim; ++i) {
+			x_plus[i] = x[i];
+		}
+		x_plus[2 * I] = 0;
+		x_plus[2 * I + 1] = -e_restitution * x[2 * I + 1];
+	}
+};
+Dynamics dynamics;
+
+template <size_t EVENT_DIM> using EventSet_T = rk4_solver::EventSet<x_dim, Dynamics, EVENT_DIM>;
+
+//* adds the impact events of the first `EVENT_DIM` balls
+template <size_t EVENT_DIM, size_t... I>
+void
+add_events(EventSet_T<EVENT_DIM> &events, std::index_sequence<I...>)
+{
+	constexpr rk4_solver::Crossing crossing = rk4_solver::Crossing::falling;
+	(events.add(&Dynamics::guard_fun<I>, &Dynamics::reset_fun<I>, crossing), ...);
+}
+
+void
+init(Real_T (&x_init)[x_dim])
+{
+	for (size_t i = 0; i < ball_dim; ++i) {
+		x_init[2 * i] = 1 + i % 5;
+		x_init[2 * i + 1] = 0;
+	}
+}
+
+/*
+ * Returns the shortest time of `repeat_dim` runs of `fun` [s].
+ */
+template <typename Fun_T>
+Real_T
+time_runs(Fun_T fun)
+{
+	Real_T min_s = 0;
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		fun();
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s;
+}
+
+//* times the loop with the impact events of the first `EVENT_DIM` balls in an event set
+template <size_t EVENT_DIM>
+void
+run_event_set(const Real_T none_s)
+{
+	auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun>(dynamics, time_step);
+	EventSet_T<EVENT_DIM> events(dynamics);
+	add_events(events, std::make_index_sequence<EVENT_DIM>());
+	Real_T x_init[x_dim];
+	Real_T t;
+	Real_T x[x_dim];
+	size_t hit_count = 0;
+	init(x_init);
+
+	const Real_T since_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, events, t_init, x_init, t, x);
+	});
+
+	for (size_t i = 0; i < EVENT_DIM; ++i) {
+		hit_count += events.get_hit_count(i);
+	}
+	printf("%-24s %4zu %16.3g %16.3g %12.3g\n", "event set", EVENT_DIM, t_dim / since_s,
+	       since_s / none_s, static_cast<Real_T>(hit_count) / repeat_dim);
+}
+
+int
+main()
+{
+	auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun>(dynamics, time_step);
+	Real_T x_init[x_dim];
+	Real_T t;
+	Real_T x[x_dim];
+	init(x_init);
+
+	printf("Integrating %zu bouncing balls for %.3g steps.\n", ball_dim,
+	       static_cast<Real_T>(t_dim));
+	printf("%-24s %4s %16s %16s %12s\n", "Events", "", "Steps/s", "Relative time", "Resets");
+
+	const Real_T none_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	});
+	printf("%-24s %4d %16.3g %16.3g %12s\n", "none", 0, t_dim / none_s, 1., "-");
+
+	rk4_solver::Event<x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+	const Real_T event_s = time_runs([&]() {
+		rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+	});
+	printf("%-24s %4zu %16.3g %16.3g %12s\n", "single event function", ball_dim,
+	       t_dim / event_s, event_s / none_s, "-");
+
+	run_event_set<1>(none_s);
+	run_event_set<8>(none_s);
+	run_event_set<ball_dim>(none_s);
+	return 0;
+}
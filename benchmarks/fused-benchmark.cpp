@@ -0,0 +1,115 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr Real_T time_step = 1e-3;
+constexpr size_t repeat_dim = 3;
+constexpr size_t element_step_dim = 1 << 25; //* steps times elements per run
+
+/*
+ * Passes over memory per step, i.e. loads and stores of `X_DIM` scalars. The ODE functions load
+ * and store 4 * 2, the stage inputs 3 * 3, and the update loads x, k_0...k_3 and the compensations
+ * and stores x_next and the compensations, 8. The fused ODE functions load and store 2 + 3 * 3.
+ */
+constexpr size_t pass_dim = 4 * 2 + 3 * 3 + 8;
+constexpr size_t fused_pass_dim = 2 + 3 * 3 + 8;
+
+/*
+ * Harmonic oscillators, dt_x_(2i) = x_(2i+1), dt_x_(2i+1) = -x_(2i), whose ODE function is cheap,
+ * so that the step is bound by the memory bandwidth
+ */
+template <size_t X_DIM> struct Dynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = 0; i < X_DIM; i += 2) {
+			dt_x[i] = x[i + 1];
+			dt_x[i + 1] = -x[i];
+		}
+	}
+
+	void
+	stage_fun(const Real_T, const Real_T (&x)[X_DIM], const Real_T (&k)[X_DIM], const Real_T a,
+	          Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = 0; i < X_DIM; i += 2) {
+			dt_x[i] = x[i + 1] + a * k[i + 1];
+			dt_x[i + 1] = -(x[i] + a * k[i]);
+		}
+	}
+};
+
+//* returns the shortest time per step of `repeat_dim` loops of `integrator` [s]
+template <size_t X_DIM, typename Integrator_T>
+Real_T
+time_step_loop(Integrator_T &integrator)
+{
+	constexpr size_t t_dim = element_step_dim / X_DIM + 1;
+	static Real_T x_init[X_DIM];
+	static Real_T x[X_DIM];
+	Real_T t;
+	Real_T min_s = 0;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<t_dim>(integrator, 0, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s / (t_dim - 1);
+}
+
+/*
+ * Prints the time per step and the bandwidth of the passes over memory of `Integrator` and
+ * `FusedIntegrator`, and the speed-up of the latter. The integrators are static, since their
+ * workspaces are not on the heap if `DO_NOT_USE_HEAP` is defined.
+ */
+template <size_t X_DIM>
+void
+run()
+{
+	static Dynamics<X_DIM> dynamics;
+	static auto integrator =
+	    rk4_solver::make_integrator<&Dynamics<X_DIM>::ode_fun>(dynamics, time_step);
+	static auto fused_integrator =
+	    rk4_solver::make_fused_integrator<&Dynamics<X_DIM>::stage_fun>(dynamics, time_step);
+	constexpr Real_T state_byte_dim = X_DIM * sizeof(Real_T);
+
+	const Real_T step_s = time_step_loop<X_DIM>(integrator);
+	const Real_T fused_step_s = time_step_loop<X_DIM>(fused_integrator);
+	printf("%8zu %10.3g %8.3g %10.3g %8.3g %8.2fx\n", X_DIM, step_s * 1e6,
+	       pass_dim * state_byte_dim / step_s / 1e9, fused_step_s * 1e6,
+	       fused_pass_dim * state_byte_dim / fused_step_s / 1e9, step_s / fused_step_s);
+}
+
+int
+main()
+{
+	printf("Integrating oscillators for %.3g steps times elements per size.\n",
+	       static_cast<Real_T>(element_step_dim));
+	printf("Passes over the state per step: %zu stage inputs in buffers, %zu fused (%.2fx).\n",
+	       pass_dim, fused_pass_dim, static_cast<Real_T>(pass_dim) / fused_pass_dim);
+	printf("%8s %10s %8s %10s %8s %9s\n", "", "Buffered", "", "Fused", "", "");
+	printf("%8s %10s %8s %10s %8s %9s\n", "X_DIM", "[us/step]", "[GB/s]", "[us/step]", "[GB/s]",
+	       "Speed-up");
+
+	run<1 << 10>(); //* in the L1 or L2 cache
+	run<1 << 14>();
+	run<1 << 17>(); //* in the L3 cache
+	run<1 << 20>(); //* in memory
+	run<1 << 22>();
+	return 0;
+}
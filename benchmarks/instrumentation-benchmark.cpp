@@ -0,0 +1,122 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e3;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t repeat_dim = 5;
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+
+	//* reflects the first state at 10
+	bool
+	event_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		if (x[0] > 1e1) {
+			x_plus[0] = 2e1 - x[0];
+			x_plus[1] = -x[1];
+			x_plus[2] = x[2];
+			return true;
+		}
+		return false;
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+Dynamics dynamics;
+
+using EventBind_T = rk4_solver::StaticMemberBinding<&Dynamics::event_fun>;
+template <typename Instrument_T>
+using Event_T = rk4_solver::Event<x_dim, Dynamics, Real_T, EventBind_T, Instrument_T>;
+
+/*
+ * Prints the score of the event loop with the instrumentation policy `Instrument_T` and returns
+ * its shortest time of `repeat_dim` runs [s].
+ *
+ * 1. `name`: name of the instrumentation
+ * 2. `none_s`: time without instrumentation [s], or 0 for no instrumentation itself
+ */
+template <typename Instrument_T>
+Real_T
+run(const char *name, const Real_T none_s)
+{
+	auto integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun, Instrument_T>(dynamics, time_step);
+	Event_T<Instrument_T> event(EventBind_T(dynamics), integrator.get_instrumentation());
+	Real_T min_s = 0;
+	Real_T t;
+	Real_T x[x_dim];
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	printf("%-24s %16.3g %16.3g   (x[0] = %.3g)\n", name, t_dim / min_s,
+	       none_s > 0 ? min_s / none_s : 1., x[0]);
+	return min_s;
+}
+
+int
+main()
+{
+	printf("Integrating 3rd order linear ODE with an event for %.3g steps.\n",
+	       static_cast<Real_T>(t_dim));
+	printf("%-24s %16s %16s\n", "Instrumentation", "Steps/s", "Relative time");
+
+	const Real_T none_s = run<rk4_solver::NoInstrumentation>("none (default)", 0);
+	run<rk4_solver::Instrumentation<false>>("counters", none_s);
+	run<rk4_solver::Instrumentation<true>>("counters and ticks", none_s);
+
+	//* where the time goes
+	using Timed_T = rk4_solver::Instrumentation<true>;
+	auto integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun, Timed_T>(dynamics, time_step);
+	Event_T<Timed_T> event(EventBind_T(dynamics), integrator.get_instrumentation());
+	Real_T t;
+	Real_T x[x_dim];
+	rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+
+	const rk4_solver::InstrumentationSnapshot snapshot =
+	    integrator.get_instrumentation().snapshot();
+	const Real_T ode_fun_ticks = snapshot.get_ticks(rk4_solver::Section::ode_fun);
+	const Real_T stage_ticks = snapshot.get_ticks(rk4_solver::Section::stage);
+	const Real_T event_ticks = snapshot.get_ticks(rk4_solver::Section::event);
+	const Real_T total_ticks = ode_fun_ticks + stage_ticks + event_ticks;
+
+	printf("\n%.3g steps, %.3g ODE function calls, %.3g event checks, %.3g event hits\n",
+	       static_cast<Real_T>(snapshot.step_count),
+	       static_cast<Real_T>(snapshot.ode_fun_count),
+	       static_cast<Real_T>(snapshot.event_check_count),
+	       static_cast<Real_T>(snapshot.event_hit_count));
+	printf("ODE function %.0f%%, stages %.0f%%, event %.0f%% of %.3g ticks\n",
+	       1e2 * ode_fun_ticks / total_ticks, 1e2 * stage_ticks / total_ticks,
+	       1e2 * event_ticks / total_ticks, total_ticks);
+	return 0;
+}
@@ -0,0 +1,363 @@
+#include "rk4_solver/instrumentation.hpp"
+#include "rk4_solver/integrator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t outlier_dim = 10;
+constexpr size_t default_l2_bytes = 1 << 20;
+constexpr size_t arena_bytes = 4096;
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+Dynamics dynamics;
+
+/*
+ * What happens between two timed steps:
+ * warm: nothing, i.e. a tight control loop
+ * cold: a buffer the size of the L2 cache is touched, i.e. other tasks ran in between
+ * flush: as cold, and all data of the step (the state, the dynamics, the integrator and its
+ * workspace) is flushed from all cache levels, i.e. the step starts from memory, which
+ * approximates the worst case execution time
+ */
+enum class Mode { warm, cold, flush };
+
+struct Options {
+	bool do_run[3] = {true, true, true};
+	size_t sample_dim[3] = {1000000, 100000, 100000};
+	int cpu = 0; //* -1 to not pin
+	bool is_realtime = false;
+	bool is_csv = false;
+	double p999_limit_ns = 0; //* 0 for no limit
+};
+
+struct Outlier {
+	uint64_t ticks;
+	size_t idx;
+	double since_start_us;
+};
+
+const char *
+get_mode_name(const Mode mode)
+{
+	return mode == Mode::warm ? "warm" : (mode == Mode::cold ? "cold" : "flush");
+}
+
+size_t
+get_l2_bytes()
+{
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+	const long byte_dim = sysconf(_SC_LEVEL2_CACHE_SIZE);
+
+	if (byte_dim > 0) {
+		return byte_dim;
+	}
+#endif
+	return default_l2_bytes;
+}
+
+//* ticks of `read_cycle_counter()` per nanosecond, measured against the steady clock
+double
+calibrate_ticks_per_ns()
+{
+	const auto start_tp = std::chrono::steady_clock::now();
+	const uint64_t start_tick = rk4_solver::read_cycle_counter();
+
+	while (std::chrono::steady_clock::now() - start_tp < std::chrono::milliseconds(100)) {
+	}
+	const uint64_t now_tick = rk4_solver::read_cycle_counter();
+	const auto now_tp = std::chrono::steady_clock::now();
+	const double since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return (now_tick - start_tick) / since_ns;
+}
+
+//* smallest number of ticks between two reads of the counter
+uint64_t
+measure_overhead_ticks()
+{
+	uint64_t min_ticks = ~uint64_t(0);
+
+	for (size_t i = 0; i < 100000; ++i) {
+		const uint64_t start_tick = rk4_solver::read_cycle_counter();
+		const uint64_t now_tick = rk4_solver::read_cycle_counter();
+		min_ticks = std::min(min_ticks, now_tick - start_tick);
+	}
+	return min_ticks;
+}
+
+//* touches every cache line of the buffer, and returns a sum so that it is not optimized away
+unsigned
+touch(std::vector<unsigned char> &buffer)
+{
+	unsigned sum = 0;
+
+	for (size_t i = 0; i < buffer.size(); i += rk4_solver::cache_line_size) {
+		buffer[i] += 1;
+		sum += buffer[i];
+	}
+	return sum;
+}
+
+//* flushes `byte_dim` bytes from all cache levels
+void
+flush(const void *ptr, const size_t byte_dim)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	const char *begin = static_cast<const char *>(ptr);
+
+	for (size_t i = 0; i < byte_dim; i += rk4_solver::cache_line_size) {
+		_mm_clflush(begin + i);
+	}
+	_mm_clflush(begin + byte_dim - 1);
+	_mm_mfence();
+#else
+	(void)ptr;
+	(void)byte_dim;
+#endif
+}
+
+/*
+ * Pins the calling thread to `cpu` and optionally switches to the FIFO real-time scheduler and
+ * locks the memory. Prints what could not be done.
+ */
+void
+set_up_thread(const Options &opt)
+{
+#ifdef __linux__
+	if (opt.cpu >= 0) {
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(opt.cpu, &cpu_set);
+
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+			fprintf(stderr, "Could not pin the thread to CPU %d\n", opt.cpu);
+		}
+	}
+
+	if (opt.is_realtime) {
+		sched_param param;
+		param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+
+		if (sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+			fprintf(stderr, "Could not switch to SCHED_FIFO (needs privileges)\n");
+		}
+		if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+			fprintf(stderr, "Could not lock the memory (needs privileges)\n");
+		}
+	}
+#else
+	if (opt.cpu >= 0 || opt.is_realtime) {
+		fprintf(stderr, "Pinning and real-time scheduling are only supported on Linux\n");
+	}
+#endif
+}
+
+/*
+ * Times `sample_dim` single steps in the given mode and prints the percentiles, a histogram and
+ * the largest outliers. Returns the 99.9th percentile [ns].
+ */
+double
+run(const Options &opt, const Mode mode, const double ticks_per_ns, const uint64_t overhead_ticks)
+{
+	const size_t sample_dim = opt.sample_dim[static_cast<size_t>(mode)];
+	const size_t evict_bytes = mode == Mode::warm ? 0 : get_l2_bytes();
+	std::vector<unsigned char> evict_buffer(evict_bytes);
+	std::vector<uint32_t> ticks_arr(sample_dim);
+	unsigned evict_sum = touch(evict_buffer);
+
+	//* the workspace is allocated from an arena, so that it can be flushed
+	alignas(rk4_solver::cache_line_size) static unsigned char arena_buffer[arena_bytes];
+	rk4_solver::Arena arena(arena_buffer, sizeof(arena_buffer));
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step,
+	                                                   t_init, arena.get_allocator());
+	Real_T t = t_init;
+	Real_T x[x_dim];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		x[i] = x_init[i];
+	}
+	//* min-heap of the largest outliers, with the time they occurred at
+	std::vector<Outlier> outliers;
+	const auto is_larger = [](const Outlier &a, const Outlier &b) { return a.ticks > b.ticks; };
+	const uint64_t start_tick = rk4_solver::read_cycle_counter();
+
+	for (size_t i = 0; i < sample_dim; ++i) {
+		if (mode != Mode::warm) {
+			evict_sum += touch(evict_buffer);
+		}
+		if (mode == Mode::flush) {
+			flush(x, sizeof(x));
+			flush(&dynamics, sizeof(dynamics));
+			flush(&integrator, sizeof(integrator));
+			flush(arena_buffer, arena.get_used_byte_dim());
+		}
+		const uint64_t step_tick = rk4_solver::read_cycle_counter();
+		integrator.step(t, x, t, x);
+		const uint64_t now_tick = rk4_solver::read_cycle_counter();
+		const uint64_t ticks = now_tick - step_tick;
+		const uint64_t step_ticks = ticks > overhead_ticks ? ticks - overhead_ticks : 0;
+		ticks_arr[i] = std::min<uint64_t>(step_ticks, ~uint32_t(0));
+
+		if (outliers.size() < outlier_dim || ticks_arr[i] > outliers.front().ticks) {
+			const double since_start_us = (step_tick - start_tick) / ticks_per_ns / 1e3;
+			outliers.push_back({ticks_arr[i], i, since_start_us});
+			std::push_heap(outliers.begin(), outliers.end(), is_larger);
+
+			if (outliers.size() > outlier_dim) {
+				std::pop_heap(outliers.begin(), outliers.end(), is_larger);
+				outliers.pop_back();
+			}
+		}
+	}
+	std::sort(outliers.begin(), outliers.end(), is_larger);
+
+	std::vector<uint32_t> sorted(ticks_arr);
+	std::sort(sorted.begin(), sorted.end());
+	const auto get_ns = [&](const double p) {
+		return sorted[static_cast<size_t>(p / 100 * (sample_dim - 1) + .5)] / ticks_per_ns;
+	};
+	const double p999_ns = get_ns(99.9);
+
+	if (opt.is_csv) {
+		printf("%s,%zu,%.4g,%.4g,%.4g,%.4g,%.4g,%.4g\n", get_mode_name(mode), sample_dim,
+		       get_ns(0), get_ns(50), get_ns(99), p999_ns, get_ns(99.99), get_ns(100));
+		return p999_ns;
+	}
+	printf("\n%s: %zu steps, %zu bytes evicted between steps (x[0] = %.3g, %u)\n",
+	       get_mode_name(mode), sample_dim, evict_bytes, x[0], evict_sum % 2);
+	printf("  min %.4g ns, p50 %.4g ns, p99 %.4g ns, p99.9 %.4g ns, p99.99 %.4g ns, "
+	       "max %.4g ns\n",
+	       get_ns(0), get_ns(50), get_ns(99), p999_ns, get_ns(99.99), get_ns(100));
+
+	//* histogram with power of two bins [ns]
+	size_t bin_counts[32] = {};
+
+	for (size_t i = 0; i < sample_dim; ++i) {
+		size_t bin = 0;
+
+		for (double ns = ticks_arr[i] / ticks_per_ns; ns >= 2 && bin < 31; ns /= 2) {
+			++bin;
+		}
+		++bin_counts[bin];
+	}
+	printf("  histogram:\n");
+
+	for (size_t bin = 0; bin < 32; ++bin) {
+		if (bin_counts[bin] > 0) {
+			const size_t bin_begin_ns = bin == 0 ? 0 : size_t(1) << bin;
+			printf("  %10zu - %10zu ns: %10zu (%.4g%%)\n", bin_begin_ns,
+			       size_t(1) << (bin + 1), bin_counts[bin],
+			       1e2 * bin_counts[bin] / sample_dim);
+		}
+	}
+	printf("  largest outliers:\n");
+
+	for (const Outlier &outlier : outliers) {
+		printf("  %10.4g ns at step %zu, %.4g us after the start\n",
+		       outlier.ticks / ticks_per_ns, outlier.idx, outlier.since_start_us);
+	}
+	return p999_ns;
+}
+
+void
+print_usage(const char *name)
+{
+	printf("Usage: %s [--mode warm|cold|flush] [--samples N] [--cpu K|-1] [--realtime] "
+	       "[--csv] [--p999-limit-ns NS]\n",
+	       name);
+}
+
+int
+main(int argc, char *argv[])
+{
+	Options opt;
+
+	for (int i = 1; i < argc; ++i) {
+		const bool has_value = i + 1 < argc;
+
+		if (strcmp(argv[i], "--mode") == 0 && has_value) {
+			const char *mode_name = argv[++i];
+
+			for (size_t j = 0; j < 3; ++j) {
+				const Mode mode = static_cast<Mode>(j);
+				opt.do_run[j] = strcmp(mode_name, get_mode_name(mode)) == 0;
+			}
+		} else if (strcmp(argv[i], "--samples") == 0 && has_value) {
+			const size_t sample_dim =
+			    std::max<size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+
+			for (size_t j = 0; j < 3; ++j) {
+				opt.sample_dim[j] = sample_dim;
+			}
+		} else if (strcmp(argv[i], "--cpu") == 0 && has_value) {
+			opt.cpu = std::atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--realtime") == 0) {
+			opt.is_realtime = true;
+		} else if (strcmp(argv[i], "--csv") == 0) {
+			opt.is_csv = true;
+		} else if (strcmp(argv[i], "--p999-limit-ns") == 0 && has_value) {
+			opt.p999_limit_ns = std::strtod(argv[++i], nullptr);
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	set_up_thread(opt);
+	const double ticks_per_ns = calibrate_ticks_per_ns();
+	const uint64_t overhead_ticks = measure_overhead_ticks();
+
+	if (opt.is_csv) {
+		printf("mode,samples,min_ns,p50_ns,p99_ns,p999_ns,p9999_ns,max_ns\n");
+	} else {
+		printf("Latency of a single step of a 3rd order linear ODE, %.3g ticks per ns, "
+		       "%.3g ns timer overhead subtracted\n",
+		       ticks_per_ns, overhead_ticks / ticks_per_ns);
+	}
+	bool is_within_limit = true;
+
+	for (size_t j = 0; j < 3; ++j) {
+		const Mode mode = static_cast<Mode>(j);
+
+		if (opt.do_run[j]) {
+			const double p999_ns = run(opt, mode, ticks_per_ns, overhead_ticks);
+
+			if (opt.p999_limit_ns > 0 && p999_ns > opt.p999_limit_ns) {
+				fprintf(stderr, "%s: p99.9 %.4g ns exceeds the limit of %.4g ns\n",
+				        get_mode_name(mode), p999_ns, opt.p999_limit_ns);
+				is_within_limit = false;
+			}
+		}
+	}
+	return is_within_limit ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr size_t u_dim = 1;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e3;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {0, 0, 0};
+constexpr Real_T u[u_dim] = {1};
+
+constexpr Real_T R = 1.4;      //* [ohm]
+constexpr Real_T L = 1.7e-3;   //*  [ohm s]
+constexpr Real_T J = 1.29e-4;  //*  [kg m-2]
+constexpr Real_T b = 3.92e-4;  //*  [N m s]
+constexpr Real_T K_t = 6.4e-2; //*  [N m A-1]
+constexpr Real_T K_b = 6.4e-2; //*  [V s]
+constexpr Real_T A[x_dim][x_dim] = {{0, 1, 0}, {0, -b / J, K_t / J}, {0, -K_b / L, -R / L}};
+constexpr Real_T B[x_dim][u_dim] = {{0}, {0}, {1 / L}};
+
+struct Dynamics {
+	/*
+	 * DC motor, dt_x = A*x + B*u
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		Real_T temp0[x_dim];
+		Real_T temp1[x_dim];
+
+		matrix_op::right_multiply(A, x, temp0);
+		matrix_op::right_multiply(B, u, temp1);
+		matrix_op::sum(temp0, temp1, dt_x);
+	}
+};
+Dynamics dynamics;
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+int
+main()
+{
+	Real_T t;
+	Real_T x[x_dim];
+	Real_T x_lti[x_dim];
+	Real_T x_exact[x_dim];
+
+	printf("Integrating a DC motor for %.3g steps.\n", static_cast<Real_T>(t_dim));
+	printf("%-28s %16s %16s\n", "integrator", "steps/s", "relative time");
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	const Real_T rk4_s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x); });
+	printf("%-28s %16.3g %16.3g\n", "Integrator", t_dim / rk4_s, 1.);
+
+	rk4_solver::LtiIntegrator<x_dim, u_dim> lti_integrator(A, B, time_step);
+	const Real_T lti_s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(lti_integrator, t_init, x_init, u, t, x_lti); });
+	printf("%-28s %16.3g %16.3g\n", "LtiIntegrator (rk4)", t_dim / lti_s, lti_s / rk4_s);
+
+	rk4_solver::LtiIntegrator<x_dim, u_dim> exact_integrator(
+	    A, B, time_step, t_init, rk4_solver::Discretization::exact);
+	const Real_T exact_s = time_s(
+	    [&]() { rk4_solver::loop<t_dim>(exact_integrator, t_init, x_init, u, t, x_exact); });
+	printf("%-28s %16.3g %16.3g\n", "LtiIntegrator (exact)", t_dim / exact_s,
+	       exact_s / rk4_s);
+
+	printf("(final angle: %.6g rad, rk4 difference: %.3g, exact difference: %.3g)\n", x[0],
+	       x_lti[0] - x[0], x_exact[0] - x[0]);
+	return 0;
+}
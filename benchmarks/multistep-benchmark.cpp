@@ -0,0 +1,128 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+//* chain of coupled pendulums, the sines make the ODE function relatively expensive
+constexpr size_t pendulum_dim = 16;
+constexpr size_t x_dim = 2 * pendulum_dim;
+constexpr Real_T gravity_const = 9.806; //* [m s-2]
+constexpr Real_T length = 1.;           //* [m]
+constexpr Real_T k_coupling = 2.;       //* [s-2]
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 100.;
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t ref_t_dim = 4 * (t_dim - 1) + 1;
+
+struct Dynamics {
+	/*
+	 * dt_theta_i = omega_i
+	 * dt_omega_i = -g/l*sin(theta_i) + k*(sin(theta_(i-1) - theta_i) +
+	 *              sin(theta_(i+1) - theta_i))
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		for (size_t i = 0; i < pendulum_dim; ++i) {
+			const Real_T theta = x[i];
+			Real_T coupling = 0;
+
+			if (i > 0) {
+				coupling += std::sin(x[i - 1] - theta);
+			}
+			if (i < pendulum_dim - 1) {
+				coupling += std::sin(x[i + 1] - theta);
+			}
+			dt_x[i] = x[pendulum_dim + i];
+			dt_x[pendulum_dim + i] = -gravity_const / length * std::sin(theta) +
+			                         k_coupling * coupling;
+		}
+		++evaluation_count;
+	}
+
+	size_t evaluation_count = 0;
+};
+Dynamics dynamics;
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+//* largest difference of the states
+Real_T
+compute_difference(const Real_T (&x)[x_dim], const Real_T (&x_ref)[x_dim])
+{
+	Real_T difference = 0;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		difference = std::fmax(difference, std::abs(x[i] - x_ref[i]));
+	}
+	return difference;
+}
+
+//* integrates and prints the results against the reference
+template <typename Integrator_T>
+void
+run(Integrator_T &integrator, const char *name, const Real_T (&x_init)[x_dim],
+    const Real_T (&x_ref)[x_dim], Real_T &rk4_s)
+{
+	Real_T t;
+	Real_T x[x_dim];
+
+	dynamics.evaluation_count = 0;
+	const Real_T s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x); });
+
+	if (rk4_s == 0) {
+		rk4_s = s;
+	}
+	printf("%-32s %12.3g %12.3g %16.3g %12.3g\n", name,
+	       static_cast<Real_T>(dynamics.evaluation_count) / (t_dim - 1), s, s / rk4_s,
+	       compute_difference(x, x_ref));
+}
+
+int
+main()
+{
+	Real_T x_init[x_dim] = {};
+	x_init[0] = 1.; //* [rad]
+
+	//* reference at a 4 times smaller step
+	Real_T t;
+	Real_T x_ref[x_dim];
+	rk4_solver::Integrator<x_dim, Dynamics> ref_integrator(dynamics, &Dynamics::ode_fun,
+	                                                       time_step / 4);
+	rk4_solver::loop<ref_t_dim>(ref_integrator, t_init, x_init, t, x_ref);
+
+	printf("Integrating %zu coupled pendulums for %.3g steps.\n", pendulum_dim,
+	       static_cast<Real_T>(t_dim));
+	printf("%-32s %12s %12s %16s %12s\n", "integrator", "evals/step", "time [s]",
+	       "relative time", "difference");
+
+	Real_T rk4_s = 0;
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	run(integrator, "Integrator", x_init, x_ref, rk4_s);
+
+	rk4_solver::MultistepIntegrator<x_dim, Dynamics> pece_integrator(
+	    dynamics, &Dynamics::ode_fun, time_step, t_init, rk4_solver::PredictorCorrector::pece);
+	run(pece_integrator, "MultistepIntegrator (PECE)", x_init, x_ref, rk4_s);
+
+	rk4_solver::MultistepIntegrator<x_dim, Dynamics> pec_integrator(
+	    dynamics, &Dynamics::ode_fun, time_step, t_init, rk4_solver::PredictorCorrector::pec);
+	run(pec_integrator, "MultistepIntegrator (PEC)", x_init, x_ref, rk4_s);
+
+	return 0;
+}
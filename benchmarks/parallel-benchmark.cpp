@@ -0,0 +1,124 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr Real_T time_step = 1e-3;
+constexpr size_t repeat_dim = 3;
+constexpr size_t element_step_dim = 1 << 24; //* steps times elements per run
+
+/*
+ * Ring of coupled oscillators, dt_x_(2i) = x_(2i+1),
+ * dt_x_(2i+1) = -x_(2i) + (x_(2i-2) + x_(2i+2) - 2*x_(2i))/4
+ */
+template <size_t X_DIM> struct Dynamics {
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		range_ode_fun(t, x, 0, X_DIM, dt_x);
+	}
+
+	void
+	range_ode_fun(const Real_T, const Real_T (&x)[X_DIM], const size_t begin, const size_t end,
+	              Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = begin; i < end; i += 2) {
+			const size_t i_prev = i == 0 ? X_DIM - 2 : i - 2;
+			const size_t i_next = i == X_DIM - 2 ? 0 : i + 2;
+			dt_x[i] = x[i + 1];
+			dt_x[i + 1] = -x[i] + (x[i_prev] + x[i_next] - 2 * x[i]) / 4;
+		}
+	}
+};
+
+//* returns the shortest time per step of `repeat_dim` loops of `integrator` [s]
+template <size_t X_DIM, typename Integrator_T>
+Real_T
+time_step_loop(Integrator_T &integrator)
+{
+	constexpr size_t t_dim = element_step_dim / X_DIM + 1;
+	static Real_T x_init[X_DIM];
+	static Real_T x[X_DIM];
+	Real_T t;
+	Real_T min_s = 0;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<t_dim>(integrator, 0, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s / (t_dim - 1);
+}
+
+/*
+ * Prints the time per step of `Integrator`, and the speed-up of `ParallelIntegrator` over it on
+ * each pool. The integrators are on the heap, since their workspaces are not if `DO_NOT_USE_HEAP`
+ * is defined.
+ */
+template <size_t X_DIM>
+void
+run(const std::vector<std::unique_ptr<rk4_solver::ThreadPool>> &pools)
+{
+	static Dynamics<X_DIM> dynamics;
+	std::unique_ptr<rk4_solver::Integrator<X_DIM, Dynamics<X_DIM>>> integrator(
+	    new rk4_solver::Integrator<X_DIM, Dynamics<X_DIM>>(dynamics, &Dynamics<X_DIM>::ode_fun,
+	                                                       time_step));
+	const Real_T serial_s = time_step_loop<X_DIM>(*integrator);
+	printf("%8zu %10.3g", X_DIM, serial_s * 1e6);
+
+	for (const auto &pool : pools) {
+		using Parallel_T = rk4_solver::ParallelIntegrator<X_DIM, Dynamics<X_DIM>>;
+		std::unique_ptr<Parallel_T> parallel_integrator(
+		    new Parallel_T(*pool, dynamics, &Dynamics<X_DIM>::range_ode_fun, time_step));
+		const Real_T parallel_s = time_step_loop<X_DIM>(*parallel_integrator);
+		printf(" %7.2fx (%zu)", serial_s / parallel_s,
+		       parallel_integrator->get_partition_dim());
+	}
+	printf("\n");
+}
+
+int
+main(int argc, char **argv)
+{
+	//* optionally, the maximum number of threads can be given as the first argument
+	const size_t max_thread_dim = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+	                                       : rk4_solver::ThreadPool::get_default_thread_count();
+	std::vector<std::unique_ptr<rk4_solver::ThreadPool>> pools;
+	printf("Integrating a ring of oscillators for %.3g steps times elements per size.\n",
+	       static_cast<Real_T>(element_step_dim));
+	printf("Speed-up over Integrator (partitions) with:\n");
+	printf("%8s %10s", "X_DIM", "[us/step]");
+
+	for (size_t thread_dim = 1; thread_dim <= max_thread_dim; thread_dim *= 2) {
+		pools.emplace_back(new rk4_solver::ThreadPool(thread_dim));
+		printf(" %3zu threads", thread_dim);
+
+		if (thread_dim < max_thread_dim && thread_dim * 2 > max_thread_dim) {
+			thread_dim = max_thread_dim / 2;
+		}
+	}
+	printf("\n");
+
+	run<1 << 12>(pools); //* a single partition
+	run<1 << 14>(pools);
+	run<1 << 16>(pools);
+	run<1 << 18>(pools);
+	run<1 << 20>(pools);
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include "rk4_solver/parareal.hpp"
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 2;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e3;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {2, 0};
+constexpr Real_T mu = 1;
+constexpr size_t slice_dim = 100;
+constexpr size_t coarse_ratio = 100;
+
+struct Dynamics {
+	/*
+	 * Van der Pol oscillator:
+	 * dt_x = [x_1; mu*(1 - x_0^2)*x_1 - x_0]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = mu * (1 - x[0] * x[0]) * x[1] - x[0];
+	}
+};
+Dynamics dynamics;
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+int
+main(int argc, char *argv[])
+{
+	//* optionally, the maximum number of threads can be given as the first argument
+	const size_t max_thread_dim = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+	                                       : rk4_solver::ThreadPool::get_default_thread_count();
+	Real_T t;
+	Real_T x[x_dim];
+	Real_T t_arr[slice_dim + 1];
+	Real_T x_arr[slice_dim + 1][x_dim];
+
+	printf("Integrating a Van der Pol oscillator for %.3g steps in %zu slices.\n",
+	       static_cast<Real_T>(t_dim), slice_dim);
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	const Real_T serial_s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x); });
+	printf("serial loop: %.3g s\n", serial_s);
+
+	rk4_solver::Parareal<slice_dim, x_dim, Dynamics> parareal(dynamics, &Dynamics::ode_fun,
+	                                                          time_step, coarse_ratio);
+
+	for (size_t thread_dim = 1; thread_dim <= max_thread_dim; thread_dim *= 2) {
+		rk4_solver::ThreadPool pool(thread_dim);
+		size_t iter_dim = 0;
+		const Real_T since_s = time_s(
+		    [&]() { iter_dim = parareal.solve<t_dim>(pool, x_init, t_arr, x_arr); });
+
+		Real_T error = 0;
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			error = std::fmax(error, std::abs(x_arr[slice_dim][i] - x[i]) /
+			                             std::fmax(std::abs(x[i]), 1));
+		}
+		printf("%3zu threads: %.3g s, %zu iterations, ", thread_dim, since_s, iter_dim);
+		printf("speed-up %.3gx, efficiency %.0f%%, error %.3g\n", serial_s / since_s,
+		       1e2 * serial_s / since_s / thread_dim, error);
+
+		if (thread_dim < max_thread_dim && thread_dim * 2 > max_thread_dim) {
+			thread_dim = max_thread_dim / 2;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+using rk4_solver::simd::Isa;
+
+constexpr Real_T time_step = 1e-3;
+constexpr size_t repeat_dim = 5;
+constexpr size_t element_step_dim = 1 << 24; //* steps times elements per run
+constexpr Isa isa_arr[] = {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512};
+constexpr size_t isa_dim = sizeof(isa_arr) / sizeof(isa_arr[0]);
+
+/*
+ * Harmonic oscillators, dt_x_(2i) = x_(2i+1), dt_x_(2i+1) = -x_(2i), whose ODE function is cheap,
+ * so that the stages dominate, and whose state neither grows nor decays into subnormals
+ */
+template <size_t X_DIM> struct Dynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = 0; i < X_DIM; i += 2) {
+			dt_x[i] = x[i + 1];
+			dt_x[i + 1] = -x[i];
+		}
+	}
+};
+
+/*
+ * Returns the shortest time per step of `repeat_dim` loops with the instruction set `isa` [s],
+ * or 0 if it is not supported.
+ */
+template <size_t X_DIM>
+Real_T
+time_step_loop(const Isa isa)
+{
+	constexpr size_t t_dim = element_step_dim / X_DIM + 1;
+
+	if (!rk4_solver::simd::set_isa(isa)) {
+		return 0;
+	}
+	Dynamics<X_DIM> dynamics;
+	auto integrator =
+	    rk4_solver::make_integrator<&Dynamics<X_DIM>::ode_fun>(dynamics, time_step);
+	static Real_T x_init[X_DIM];
+	static Real_T x[X_DIM];
+	Real_T t;
+	Real_T min_s = 0;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<t_dim>(integrator, 0, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s / (t_dim - 1);
+}
+
+//* prints the time per step with each instruction set and the speed-up over the scalar loops
+template <size_t X_DIM>
+void
+run()
+{
+	Real_T step_s[isa_dim];
+	printf("%8zu", X_DIM);
+
+	for (size_t i = 0; i < isa_dim; ++i) {
+		step_s[i] = time_step_loop<X_DIM>(isa_arr[i]);
+
+		if (step_s[i] > 0) {
+			printf(" %10.3g %5.2fx", step_s[i] * 1e9, step_s[0] / step_s[i]);
+		} else {
+			printf(" %10s %6s", "-", "");
+		}
+	}
+	printf("\n");
+}
+
+int
+main()
+{
+	const Isa detected_isa = rk4_solver::simd::detect_isa();
+	printf("Integrating oscillators for %.3g steps times elements per size, detected %s.\n",
+	       static_cast<Real_T>(element_step_dim), rk4_solver::simd::get_isa_name(detected_isa));
+	printf("Time per step [ns] and speed-up over the inlined scalar loops:\n");
+	printf("%8s", "X_DIM");
+
+	for (size_t i = 0; i < isa_dim; ++i) {
+		printf(" %17s", rk4_solver::simd::get_isa_name(isa_arr[i]));
+	}
+	printf("\n");
+
+	run<64>(); //* below `simd::min_dim`, the integrator does not call the kernels
+	run<256>();
+	run<1024>();
+	run<4096>();
+	run<16384>();
+	run<65536>();
+	rk4_solver::simd::set_isa(detected_isa);
+	return 0;
+}
@@ -0,0 +1,98 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/resource.h>
+#endif
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e4;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2e2;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t chunk_dim = 256;
+constexpr size_t ring_dim = 4096;
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -1e-1 * dt_x[0] - 1e-2 * x[1] - 1e-3 * x[2];
+	}
+};
+Dynamics dynamics;
+
+/*
+ * Returns the peak resident set size in MB, or 0 if it is not available
+ */
+Real_T
+get_peak_rss_mb()
+{
+#if defined(__APPLE__)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / (1024. * 1024.); //* bytes
+#elif defined(__unix__)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024.; //* kilobytes
+#else
+	return 0;
+#endif
+}
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+int
+main()
+{
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	Real_T since_s;
+
+	printf("Integrating 3rd order linear ODE for %.3g steps.\n", static_cast<Real_T>(t_dim));
+	printf("%-28s %16s %16s\n", "output", "steps/s", "peak RSS (MB)");
+
+	//* the peak RSS only grows, so the sinks are run first
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ring_sink;
+	since_s = time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, ring_sink); });
+	printf("%-28s %16.3g %16.3g\n", "ring buffer sink", t_dim / since_s, get_peak_rss_mb());
+
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> decimated_sink;
+	since_s = time_s(
+	    [&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, decimated_sink, 100); });
+	printf("%-28s %16.3g %16.3g\n", "ring buffer sink (1/100)", t_dim / since_s,
+	       get_peak_rss_mb());
+
+	Real_T(&t_arr)[t_dim] = *(Real_T(*)[t_dim]) new Real_T[t_dim];
+	Real_T(&x_arr)[t_dim][x_dim] = *(Real_T(*)[t_dim][x_dim]) new Real_T[t_dim][x_dim];
+	since_s = time_s([&]() { rk4_solver::loop(integrator, t_init, x_init, t_arr, x_arr); });
+	printf("%-28s %16.3g %16.3g\n", "full trajectory arrays", t_dim / since_s,
+	       get_peak_rss_mb());
+
+	Real_T t;
+	Real_T x[x_dim];
+	ring_sink.get(ring_sink.get_count() - 1, t, x);
+	printf("(final state difference: %.3g)\n", x[0] - x_arr[t_dim - 1][0]);
+
+	return 0;
+}
@@ -11,6 +11,7 @@ constexpr size_t x_dim = 3;
 constexpr Real_T t_init = 0.;
 constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
 constexpr size_t benchmark_duration_ms = 5;
+constexpr size_t block_step_dim = 1024;
 
 struct Dynamics {
 	/*
@@ -29,8 +30,13 @@ struct Dynamics {
 };
 Dynamics dynamics;
 
-int
-main()
+/*
+ * Steps the integrator in blocks of `block_step_dim` steps for at least `benchmark_duration_ms`
+ * and prints the score.
+ */
+template <typename Integrator_T>
+void
+run(Integrator_T &integrator, const char *binding_name)
 {
 	Real_T t = t_init;
 	Real_T x[x_dim];
@@ -38,28 +44,46 @@ main()
 		x[i] = x_init[i];
 	}
 
-	printf("Integrating 3rd order linear ODE for %zu ms... ", benchmark_duration_ms);
-	auto sample_tp = std::chrono::high_resolution_clock::now();
-	auto now_tp = std::chrono::high_resolution_clock::now();
-	auto since_sample = sample_tp - now_tp;
+	printf("Integrating 3rd order linear ODE (%s) for %zu ms... ", binding_name,
+	       benchmark_duration_ms);
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	auto since_start = std::chrono::high_resolution_clock::duration::zero();
+
+	//* the clock is read once per block, so that it does not distort the time of a step
+	while (since_start < std::chrono::milliseconds(benchmark_duration_ms)) {
+		for (size_t i = 0; i < block_step_dim; ++i) {
+			integrator.step(t, x, t, x);
+		}
+		since_start = std::chrono::high_resolution_clock::now() - start_tp;
+	}
+	const size_t step_count = integrator.get_step_count();
+	const Real_T since_start_s =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(since_start).count() / 1e9;
+
+	printf("Done.\nx at t = %.3g s: [%.3g; %.3g; %.3g]\n", t, x[0], x[1], x[2]);
+	printf("Score: %.3g steps per second (%.3g steps)\n",
+	       static_cast<Real_T>(step_count) / since_start_s, static_cast<Real_T>(step_count));
+}
 
+int
+main()
+{
+	//* member function pointer
 	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	run(integrator, "member pointer");
 
-	while (true) {
-		integrator.step(t, x, t, x);
+	//* member function bound at compile time
+	auto static_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun>(dynamics, time_step);
+	run(static_integrator, "static member");
 
-		now_tp = std::chrono::high_resolution_clock::now();
-		since_sample = now_tp - sample_tp;
+	//* lambda
+	auto lambda_integrator = rk4_solver::make_integrator<x_dim>(
+	    [](const Real_T t, const Real_T(&x)[x_dim], Real_T(&dt_x)[x_dim]) {
+		    dynamics.ode_fun(t, x, dt_x);
+	    },
+	    time_step);
+	run(lambda_integrator, "lambda");
 
-		if (since_sample >= std::chrono::milliseconds(benchmark_duration_ms)) {
-			const size_t step_count = integrator.get_step_count();
-			printf("Done.\nx at t = %.3g s: [%.3g; %.3g; %.3g]\n", t, x[0], x[1], x[2]);
-			printf("Score: %.3g steps per second (%.3g steps)\n",
-			       static_cast<Real_T>(step_count) / benchmark_duration_ms * 1e3,
-			       static_cast<Real_T>(step_count));
-			sample_tp = std::chrono::high_resolution_clock::now();
-			break;
-		}
-	}
 	return 0;
 }
@@ -0,0 +1,116 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+#ifndef M_PI
+	#define M_PI 3.14159265358979323846
+#endif
+
+//* heat conduction along a rod of `x_dim` nodes, the left end follows a slow cosine
+constexpr size_t x_dim = 16;
+constexpr Real_T k_diff = 1e4;     //* [s^-1], the fastest mode is about -4*k_diff
+constexpr Real_T omega = 2 * M_PI; //* [rad s^-1]
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr Real_T x_init[x_dim] = {};
+
+//* the Runge-Kutta 4th Order method is stable for time steps below 2.785/(4*k_diff)
+constexpr size_t rk4_t_dim = 16001;
+constexpr Real_T rk4_time_step = (t_final - t_init) / (rk4_t_dim - 1);
+constexpr size_t rosenbrock_t_dim = 101;
+constexpr Real_T rosenbrock_time_step = (t_final - t_init) / (rosenbrock_t_dim - 1);
+
+struct Dynamics {
+	/*
+	 * dt_x_i = k*(x_(i-1) - 2*x_i + x_(i+1)), x_(-1) = cos(omega*t), x_(x_dim) = 0
+	 */
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		for (size_t i = 0; i < x_dim; ++i) {
+			const Real_T x_left = i == 0 ? std::cos(omega * t) : x[i - 1];
+			const Real_T x_right = i == x_dim - 1 ? 0 : x[i + 1];
+			dt_x[i] = k_diff * (x_left - 2 * x[i] + x_right);
+		}
+	}
+
+	void
+	jacobian_fun(const Real_T, const Real_T (&)[x_dim], Real_T (&jac)[x_dim][x_dim])
+	{
+		for (size_t i = 0; i < x_dim; ++i) {
+			for (size_t j = 0; j < x_dim; ++j) {
+				const bool is_neighbor = i == j + 1 || j == i + 1;
+				jac[i][j] = i == j ? -2 * k_diff : (is_neighbor ? k_diff : 0);
+			}
+		}
+	}
+};
+Dynamics dynamics;
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+//* largest difference of the states
+Real_T
+compute_difference(const Real_T (&x)[x_dim], const Real_T (&x_ref)[x_dim])
+{
+	Real_T difference = 0;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		difference = std::fmax(difference, std::abs(x[i] - x_ref[i]));
+	}
+	return difference;
+}
+
+int
+main()
+{
+	Real_T t;
+	Real_T x_rk4[x_dim];
+	Real_T x_exact[x_dim];
+	Real_T x_fd[x_dim];
+
+	printf("Integrating a stiff heat equation of %zu nodes for %.3g s.\n", x_dim, t_final);
+	printf("%-36s %10s %12s %16s %12s\n", "integrator", "steps", "time [s]", "relative time",
+	       "difference");
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+	                                                   rk4_time_step);
+	const Real_T rk4_s =
+	    time_s([&]() { rk4_solver::loop<rk4_t_dim>(integrator, t_init, x_init, t, x_rk4); });
+	printf("%-36s %10zu %12.3g %16.3g %12s\n", "Integrator (largest stable step)",
+	       rk4_t_dim - 1, rk4_s, 1., "reference");
+
+	//* the system is linear, so the Jacobian and its decomposition are computed once
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> exact_integrator(
+	    dynamics, &Dynamics::ode_fun, &Dynamics::jacobian_fun, rosenbrock_time_step, t_init,
+	    rosenbrock_t_dim);
+	const Real_T exact_s = time_s([&]() {
+		rk4_solver::loop<rosenbrock_t_dim>(exact_integrator, t_init, x_init, t, x_exact);
+	});
+	printf("%-36s %10zu %12.3g %16.3g %12.3g\n", "RosenbrockIntegrator (Jacobian)",
+	       rosenbrock_t_dim - 1, exact_s, exact_s / rk4_s, compute_difference(x_exact, x_rk4));
+
+	//* finite difference Jacobian, recomputed every step
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> fd_integrator(
+	    dynamics, &Dynamics::ode_fun, rosenbrock_time_step);
+	const Real_T fd_s = time_s(
+	    [&]() { rk4_solver::loop<rosenbrock_t_dim>(fd_integrator, t_init, x_init, t, x_fd); });
+	printf("%-36s %10zu %12.3g %16.3g %12.3g\n", "RosenbrockIntegrator (finite diff.)",
+	       rosenbrock_t_dim - 1, fd_s, fd_s / rk4_s, compute_difference(x_fd, x_rk4));
+
+	return 0;
+}
@@ -0,0 +1,324 @@
+#include "rk4_solver/loop.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr Real_T time_step = 1e-3;
+constexpr Real_T t_init = 0.;
+constexpr size_t element_step_dim = 1 << 20; //* state elements advanced in a repetition
+constexpr size_t min_step_dim = 256;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr const char *precision_name = "float";
+#else
+constexpr const char *precision_name = "double";
+#endif
+#ifdef DO_NOT_USE_HEAP
+constexpr const char *storage_name = "stack";
+#else
+constexpr const char *storage_name = "heap";
+#endif
+
+template <size_t X_DIM> struct Dynamics {
+	/*
+	 * A ring of decaying states, each driven by its neighbor:
+	 * dt_x_i = -x_i + x_(i-1)/2
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		dt_x[0] = -x[0] + x[X_DIM - 1] / 2;
+
+		for (size_t i = 1; i < X_DIM; ++i) {
+			dt_x[i] = -x[i] + x[i - 1] / 2;
+		}
+	}
+
+	/*
+	 * Kicks the first state back up when it decays below one half.
+	 */
+	bool
+	event_fun(const Real_T, const Real_T (&x)[X_DIM], Real_T (&x_plus)[X_DIM])
+	{
+		if (x[0] < .5) {
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_plus[i] = x[i];
+			}
+			x_plus[0] = 1;
+			return true;
+		}
+		return false;
+	}
+};
+
+struct Result {
+	char loop_name[16];
+	size_t x_dim;
+	size_t step_dim;
+	size_t rep_dim;
+	double median_ns; //* per step
+	double p10_ns;
+	double p90_ns;
+	double min_ns;
+};
+
+struct Options {
+	size_t rep_dim = 11;
+	size_t warmup_dim = 2;
+	const char *format = "text";
+	const char *output_fname = nullptr;
+	const char *baseline_fname = nullptr;
+	double threshold = .1;
+};
+
+//* nearest-rank percentile of sorted values
+double
+percentile(const std::vector<double> &sorted, const double p)
+{
+	const size_t rank = static_cast<size_t>(p / 100 * (sorted.size() - 1) + .5);
+	return sorted[rank];
+}
+
+/*
+ * Runs `loop<T_DIM>(...)` with or without an event `warmup_dim + rep_dim` times and records the
+ * statistics of the time per step of the last `rep_dim` runs.
+ */
+template <size_t X_DIM, bool USE_EVENT>
+void
+run(const Options &opt, std::vector<Result> &results)
+{
+	constexpr size_t step_dim = std::max(element_step_dim / X_DIM, min_step_dim);
+	constexpr size_t t_dim = step_dim + 1;
+	static Dynamics<X_DIM> dynamics;
+	static Real_T x_init[X_DIM];
+	static Real_T x[X_DIM];
+	Real_T t;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1;
+	}
+	rk4_solver::Integrator<X_DIM, Dynamics<X_DIM>> integrator(
+	    dynamics, &Dynamics<X_DIM>::ode_fun, time_step);
+	rk4_solver::Event<X_DIM, Dynamics<X_DIM>> event(dynamics, &Dynamics<X_DIM>::event_fun);
+	std::vector<double> ns_arr;
+
+	for (size_t k = 0; k < opt.warmup_dim + opt.rep_dim; ++k) {
+		integrator.reset();
+		const auto start_tp = std::chrono::steady_clock::now();
+
+		if (USE_EVENT) {
+			rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+		} else {
+			rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+		}
+		const auto now_tp = std::chrono::steady_clock::now();
+
+		if (k >= opt.warmup_dim) {
+			const double since_ns =
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp)
+			        .count();
+			ns_arr.push_back(since_ns / step_dim);
+		}
+	}
+	std::sort(ns_arr.begin(), ns_arr.end());
+
+	Result result;
+	const char *loop_name = USE_EVENT ? "event" : "loop";
+	std::snprintf(result.loop_name, sizeof(result.loop_name), "%s", loop_name);
+	result.x_dim = X_DIM;
+	result.step_dim = step_dim;
+	result.rep_dim = opt.rep_dim;
+	result.median_ns = percentile(ns_arr, 50);
+	result.p10_ns = percentile(ns_arr, 10);
+	result.p90_ns = percentile(ns_arr, 90);
+	result.min_ns = ns_arr.front();
+	results.push_back(result);
+
+	//* keep the result observable
+	if (x[0] != x[0]) {
+		fprintf(stderr, "%s, x_dim = %zu: the state is not finite\n", loop_name, X_DIM);
+	}
+}
+
+template <size_t X_DIM>
+void
+run_both(const Options &opt, std::vector<Result> &results)
+{
+	run<X_DIM, false>(opt, results);
+	run<X_DIM, true>(opt, results);
+}
+
+void
+write_text(FILE *file, const std::vector<Result> &results)
+{
+	fprintf(file, "Integrator, %s precision, %s workspace\n", precision_name, storage_name);
+	fprintf(file, "%6s %6s %9s %12s %12s %12s %12s %12s\n", "loop", "x_dim", "steps",
+	        "median [ns]", "p10 [ns]", "p90 [ns]", "min [ns]", "ns/element");
+
+	for (const Result &r : results) {
+		fprintf(file, "%6s %6zu %9zu %12.4g %12.4g %12.4g %12.4g %12.4g\n", r.loop_name,
+		        r.x_dim, r.step_dim, r.median_ns, r.p10_ns, r.p90_ns, r.min_ns,
+		        r.median_ns / r.x_dim);
+	}
+}
+
+const char *csv_header =
+    "precision,storage,loop,x_dim,steps,repetitions,median_ns,p10_ns,p90_ns,min_ns\n";
+
+void
+write_csv(FILE *file, const std::vector<Result> &results)
+{
+	fprintf(file, "%s", csv_header);
+
+	for (const Result &r : results) {
+		fprintf(file, "%s,%s,%s,%zu,%zu,%zu,%.6g,%.6g,%.6g,%.6g\n", precision_name,
+		        storage_name, r.loop_name, r.x_dim, r.step_dim, r.rep_dim, r.median_ns,
+		        r.p10_ns, r.p90_ns, r.min_ns);
+	}
+}
+
+void
+write_json(FILE *file, const std::vector<Result> &results)
+{
+	fprintf(file, "{\n  \"precision\": \"%s\",\n  \"storage\": \"%s\",\n  \"results\": [\n",
+	        precision_name, storage_name);
+
+	for (size_t i = 0; i < results.size(); ++i) {
+		const Result &r = results[i];
+		fprintf(file, "    {\"loop\": \"%s\", \"x_dim\": %zu, \"steps\": %zu, ",
+		        r.loop_name, r.x_dim, r.step_dim);
+		fprintf(file, "\"repetitions\": %zu, \"median_ns\": %.6g, \"p10_ns\": %.6g, ",
+		        r.rep_dim, r.median_ns, r.p10_ns);
+		fprintf(file, "\"p90_ns\": %.6g, \"min_ns\": %.6g}%s\n", r.p90_ns, r.min_ns,
+		        i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+}
+
+/*
+ * Compares the medians against the rows of a CSV baseline with the same precision and storage,
+ * and returns the number of regressions, i.e. medians that are slower by more than the threshold.
+ */
+size_t
+compare(const Options &opt, const std::vector<Result> &results)
+{
+	FILE *file = fopen(opt.baseline_fname, "r");
+
+	if (file == nullptr) {
+		fprintf(stderr, "Could not open the baseline %s\n", opt.baseline_fname);
+		return 1;
+	}
+	std::vector<Result> baseline;
+	char line[256];
+
+	while (fgets(line, sizeof(line), file) != nullptr) {
+		char precision[16];
+		char storage[16];
+		Result r;
+
+		if (sscanf(line, "%15[^,],%15[^,],%15[^,],%zu,%zu,%zu,%lf,%lf,%lf,%lf", precision,
+		           storage, r.loop_name, &r.x_dim, &r.step_dim, &r.rep_dim, &r.median_ns,
+		           &r.p10_ns, &r.p90_ns, &r.min_ns) == 10 &&
+		    strcmp(precision, precision_name) == 0 && strcmp(storage, storage_name) == 0) {
+			baseline.push_back(r);
+		}
+	}
+	fclose(file);
+
+	size_t regression_dim = 0;
+	printf("Comparing against %s (threshold %.3g%%)\n", opt.baseline_fname,
+	       opt.threshold * 1e2);
+
+	for (const Result &r : results) {
+		for (const Result &b : baseline) {
+			if (strcmp(r.loop_name, b.loop_name) != 0 || r.x_dim != b.x_dim) {
+				continue;
+			}
+			const double change = r.median_ns / b.median_ns - 1;
+			const bool is_regression = change > opt.threshold;
+			regression_dim += is_regression;
+			printf("%6s %6zu %12.4g -> %12.4g ns %+8.3g%% %s\n", r.loop_name, r.x_dim,
+			       b.median_ns, r.median_ns, change * 1e2,
+			       is_regression ? "REGRESSION" : "");
+		}
+	}
+	printf("%zu regression(s)\n", regression_dim);
+	return regression_dim;
+}
+
+void
+print_usage(const char *name)
+{
+	printf("Usage: %s [--format text|csv|json] [--output FILE] [--repetitions N] "
+	       "[--warmup N] [--compare BASELINE.csv] [--threshold FRACTION]\n",
+	       name);
+}
+
+int
+main(int argc, char *argv[])
+{
+	Options opt;
+
+	for (int i = 1; i < argc; ++i) {
+		const bool has_value = i + 1 < argc;
+
+		if (strcmp(argv[i], "--format") == 0 && has_value) {
+			opt.format = argv[++i];
+		} else if (strcmp(argv[i], "--output") == 0 && has_value) {
+			opt.output_fname = argv[++i];
+		} else if (strcmp(argv[i], "--repetitions") == 0 && has_value) {
+			opt.rep_dim = std::max<size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+		} else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+			opt.warmup_dim = std::strtoul(argv[++i], nullptr, 10);
+		} else if (strcmp(argv[i], "--compare") == 0 && has_value) {
+			opt.baseline_fname = argv[++i];
+		} else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+			opt.threshold = std::strtod(argv[++i], nullptr);
+		} else {
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	std::vector<Result> results;
+	run_both<1>(opt, results);
+	run_both<4>(opt, results);
+	run_both<16>(opt, results);
+	run_both<64>(opt, results);
+	run_both<256>(opt, results);
+	run_both<1024>(opt, results);
+	run_both<4096>(opt, results);
+
+	FILE *file = stdout;
+
+	if (opt.output_fname != nullptr) {
+		file = fopen(opt.output_fname, "w");
+
+		if (file == nullptr) {
+			fprintf(stderr, "Could not open %s\n", opt.output_fname);
+			return 1;
+		}
+	}
+
+	if (strcmp(opt.format, "csv") == 0) {
+		write_csv(file, results);
+	} else if (strcmp(opt.format, "json") == 0) {
+		write_json(file, results);
+	} else {
+		write_text(file, results);
+	}
+
+	if (file != stdout) {
+		fclose(file);
+	}
+
+	if (opt.baseline_fname != nullptr && compare(opt, results) > 0) {
+		return 1;
+	}
+	return 0;
+}
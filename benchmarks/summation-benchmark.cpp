@@ -0,0 +1,134 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::NoInstrumentation;
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr size_t repeat_dim = 5;
+
+//* 3rd order linear ODE of the loop benchmark
+constexpr size_t small_x_dim = 3;
+constexpr size_t small_t_dim = 1e6 + 1;
+constexpr Real_T small_x_init[small_x_dim] = {1e1, 1e0, 0};
+
+//* ring of first order ODEs, where the update is a larger share of the step
+constexpr size_t large_x_dim = 256;
+constexpr size_t large_t_dim = 1e4 + 1;
+
+struct SmallDynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[small_x_dim], Real_T (&dt_x)[small_x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+SmallDynamics small_dynamics;
+
+struct LargeDynamics {
+	/*
+	 * dt_x_i = -x_i + x_(i-1)/2
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[large_x_dim], Real_T (&dt_x)[large_x_dim])
+	{
+		dt_x[0] = -x[0] + x[large_x_dim - 1] / 2;
+
+		for (size_t i = 1; i < large_x_dim; ++i) {
+			dt_x[i] = -x[i] + x[i - 1] / 2;
+		}
+	}
+};
+LargeDynamics large_dynamics;
+Real_T large_x_init[large_x_dim];
+
+/*
+ * Returns the shortest time of `repeat_dim` loops with the summation policy `Summation_T` [s].
+ *
+ * 1. `dynamics`: dynamics object
+ * 2. `x_init`: initial state
+ *
+ * OUT:
+ * 3. `x`: final state
+ */
+template <size_t T_DIM, typename Summation_T, auto FUN, typename T, size_t X_DIM>
+Real_T
+time_loop(T &dynamics, const Real_T (&x_init)[X_DIM], Real_T (&x)[X_DIM])
+{
+	auto integrator =
+	    rk4_solver::make_integrator<FUN, NoInstrumentation, Summation_T>(dynamics, time_step);
+	Real_T min_s = 0;
+	Real_T t;
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<T_DIM>(integrator, t_init, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s;
+}
+
+/*
+ * Prints the throughput of both problems with the summation policy `Summation_T`.
+ *
+ * 1. `name`: name of the summation
+ * 3. `none_s`: times of both problems without compensation [s], or zeros
+ *
+ * OUT:
+ * 2. `s`: times of both problems [s]
+ */
+template <typename Summation_T>
+void
+run(const char *name, Real_T (&s)[2], const Real_T (&none_s)[2])
+{
+	Real_T small_x[small_x_dim];
+	Real_T large_x[large_x_dim];
+	s[0] = time_loop<small_t_dim, Summation_T, &SmallDynamics::ode_fun>(
+	    small_dynamics, small_x_init, small_x);
+	s[1] = time_loop<large_t_dim, Summation_T, &LargeDynamics::ode_fun>(
+	    large_dynamics, large_x_init, large_x);
+
+	printf("%-16s %14.3g %10.3g %14.3g %10.3g   (x[0] = %.3g, %.3g)\n", name,
+	       small_t_dim / s[0], none_s[0] > 0 ? s[0] / none_s[0] : 1., large_t_dim / s[1],
+	       none_s[1] > 0 ? s[1] / none_s[1] : 1., small_x[0], large_x[0]);
+}
+
+int
+main()
+{
+	for (size_t i = 0; i < large_x_dim; ++i) {
+		large_x_init[i] = 1 + i % 7;
+	}
+	printf("Integrating 3rd order linear ODE for %.3g steps and a ring of %zu first order ODEs "
+	       "for %.3g steps.\n",
+	       static_cast<Real_T>(small_t_dim), large_x_dim, static_cast<Real_T>(large_t_dim));
+	printf("%-16s %14s %10s %14s %10s\n", "Summation", "Steps/s", "Relative", "Ring steps/s",
+	       "Relative");
+
+	Real_T none_s[2] = {0, 0};
+	Real_T s[2];
+	run<rk4_solver::summation::None>("none", none_s, none_s);
+	run<rk4_solver::summation::Kahan>("Kahan (default)", s, none_s);
+	run<rk4_solver::summation::Neumaier>("Neumaier", s, none_s);
+	run<rk4_solver::summation::DoubleDouble>("double-double", s, none_s);
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "rk4_solver/sweep.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t grid_dim = 22; //* grid points per parameter
+constexpr size_t task_dim = grid_dim * grid_dim * grid_dim;
+
+struct Param {
+	Real_T a0;
+	Real_T a1;
+	Real_T a2;
+};
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	Real_T a0 = 1e-1;
+	Real_T a1 = 1e-2;
+	Real_T a2 = 1e-3;
+};
+
+//* a0, a1, a2 on a regular grid
+Param
+param_gen(const size_t i)
+{
+	const size_t i0 = i % grid_dim;
+	const size_t i1 = (i / grid_dim) % grid_dim;
+	const size_t i2 = i / (grid_dim * grid_dim);
+	return {static_cast<Real_T>(1e-1 * (1 + i0)), static_cast<Real_T>(1e-2 * (1 + i1)),
+	        static_cast<Real_T>(1e-3 * (1 + i2))};
+}
+
+Dynamics
+factory(const Param &param)
+{
+	Dynamics dynamics;
+	dynamics.a0 = param.a0;
+	dynamics.a1 = param.a1;
+	dynamics.a2 = param.a2;
+	return dynamics;
+}
+
+int
+main(int argc, char *argv[])
+{
+	Real_T(&t_arr)[task_dim] = *(Real_T(*)[task_dim]) new Real_T[task_dim];
+	Real_T(&x_arr)[task_dim][x_dim] = *(Real_T(*)[task_dim][x_dim]) new Real_T[task_dim][x_dim];
+	//* optionally, the maximum number of threads can be given as the first argument
+	const size_t max_thread_dim = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+	                                       : rk4_solver::ThreadPool::get_default_thread_count();
+	Real_T serial_s = 0;
+
+	printf("Sweeping %zu parameter points of 3rd order linear ODE for %.3g steps each.\n",
+	       task_dim, static_cast<Real_T>(t_dim));
+
+	for (size_t thread_dim = 1; thread_dim <= max_thread_dim; thread_dim *= 2) {
+		rk4_solver::ThreadPool pool(thread_dim);
+
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::sweep<t_dim>(pool, param_gen, factory, &Dynamics::ode_fun, time_step,
+		                         t_init, x_init, t_arr, x_arr);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (thread_dim == 1) {
+			serial_s = since_s;
+		}
+		printf("%3zu threads: %.3g steps per second (%.3g s), ", thread_dim,
+		       static_cast<Real_T>(task_dim * (t_dim - 1)) / since_s, since_s);
+		printf("speed-up %.3gx, efficiency %.0f%%\n", serial_s / since_s,
+		       1e2 * serial_s / since_s / thread_dim);
+
+		if (thread_dim < max_thread_dim && thread_dim * 2 > max_thread_dim) {
+			thread_dim = max_thread_dim / 2;
+		}
+	}
+	printf("x of the last task at t = %.3g s: [%.3g; %.3g; %.3g]\n", t_arr[task_dim - 1],
+	       x_arr[task_dim - 1][0], x_arr[task_dim - 1][1], x_arr[task_dim - 1][2]);
+
+	return 0;
+}
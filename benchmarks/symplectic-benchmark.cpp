@@ -0,0 +1,117 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+
+#ifndef M_PI
+	#define M_PI 3.14159265358979323846
+#endif
+
+//* Kepler orbit with the eccentricity 0.5 and the period 2*pi, starting at the periapsis
+constexpr size_t q_dim = 2;
+constexpr size_t x_dim = 2 * q_dim;
+constexpr Real_T eccentricity = .5;
+constexpr Real_T x_init[x_dim] = {1 - eccentricity, 0, 0, 1.7320508075688772};
+constexpr Real_T energy_init = -.5;
+constexpr Real_T t_init = 0.;
+constexpr size_t orbit_dim = 1000;
+constexpr size_t evaluation_dim = 800; //* evaluations of the ODE or acceleration per orbit
+
+struct Dynamics {
+	//* dt_dt_q = -q/|q|^3
+	void
+	acceleration_fun(const Real_T, const Real_T (&q)[q_dim], const Real_T (&)[q_dim],
+	                 Real_T (&a)[q_dim])
+	{
+		const Real_T r = std::sqrt(q[0] * q[0] + q[1] * q[1]);
+		const Real_T r_cubed = r * r * r;
+		a[0] = -q[0] / r_cubed;
+		a[1] = -q[1] / r_cubed;
+	}
+
+	//* dt_x = [v; a]
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		const Real_T q[q_dim] = {x[0], x[1]};
+		const Real_T v[q_dim] = {x[2], x[3]};
+		Real_T a[q_dim];
+		acceleration_fun(t, q, v, a);
+		dt_x[0] = x[2];
+		dt_x[1] = x[3];
+		dt_x[2] = a[0];
+		dt_x[3] = a[1];
+	}
+};
+Dynamics dynamics;
+
+template <typename F>
+Real_T
+time_s(F fun)
+{
+	const auto start_tp = std::chrono::high_resolution_clock::now();
+	fun();
+	const auto now_tp = std::chrono::high_resolution_clock::now();
+	const Real_T since_ns =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp).count();
+	return since_ns / 1e9;
+}
+
+//* relative energy error
+Real_T
+compute_energy_error(const Real_T (&x)[x_dim])
+{
+	const Real_T r = std::sqrt(x[0] * x[0] + x[1] * x[1]);
+	const Real_T energy = (x[2] * x[2] + x[3] * x[3]) / 2 - 1 / r;
+	return std::abs(energy / energy_init - 1);
+}
+
+//* integrates the orbit with `STEP_DIM` steps per orbit and prints the results
+template <size_t STEP_DIM, typename Integrator_T>
+void
+run(Integrator_T &integrator, const char *name, const size_t evaluations_per_step,
+    Real_T &rk4_s)
+{
+	constexpr size_t t_dim = orbit_dim * STEP_DIM + 1;
+	Real_T t;
+	Real_T x[x_dim];
+
+	const Real_T s =
+	    time_s([&]() { rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x); });
+
+	if (rk4_s == 0) {
+		rk4_s = s;
+	}
+	printf("%-28s %10zu %12.3g %16.3g %16.3g\n", name, STEP_DIM * evaluations_per_step, s,
+	       s / rk4_s, compute_energy_error(x));
+}
+
+int
+main()
+{
+	constexpr size_t rk4_step_dim = evaluation_dim / 4;
+	constexpr size_t verlet_step_dim = evaluation_dim;
+	constexpr size_t yoshida_step_dim = evaluation_dim / 3;
+
+	printf("Integrating a Kepler orbit for %zu orbits.\n", orbit_dim);
+	printf("%-28s %10s %12s %16s %16s\n", "integrator", "evals/orbit", "time [s]",
+	       "relative time", "energy error");
+
+	Real_T rk4_s = 0;
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+	                                                   2 * M_PI / rk4_step_dim);
+	run<rk4_step_dim>(integrator, "Integrator", 4, rk4_s);
+
+	rk4_solver::SymplecticIntegrator<q_dim, Dynamics, rk4_solver::symplectic::Verlet>
+	    verlet_integrator(dynamics, &Dynamics::acceleration_fun, 2 * M_PI / verlet_step_dim);
+	run<verlet_step_dim>(verlet_integrator, "SymplecticIntegrator Verlet", 1, rk4_s);
+
+	rk4_solver::SymplecticIntegrator<q_dim, Dynamics, rk4_solver::symplectic::Yoshida4>
+	    yoshida_integrator(dynamics, &Dynamics::acceleration_fun, 2 * M_PI / yoshida_step_dim);
+	run<yoshida_step_dim>(yoshida_integrator, "SymplecticIntegrator Yoshida4", 3, rk4_s);
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+#include "rk4_solver/loop.hpp"
+#include <chrono>
+#include <cstdio>
+
+using rk4_solver::Real_T;
+using rk4_solver::size_t;
+namespace tableau = rk4_solver::tableau;
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t x_dim = 3;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e3;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t repeat_dim = 5;
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	const Real_T a0 = 1e-1;
+	const Real_T a1 = 1e-2;
+	const Real_T a2 = 1e-3;
+};
+Dynamics dynamics;
+
+/*
+ * Returns the shortest time of `repeat_dim` runs of the loop [s]
+ *
+ * 1. `integrator`: integrator object
+ *
+ * OUT:
+ * 2. `x`: final state
+ */
+template <typename Integrator_T>
+Real_T
+time_loop_s(Integrator_T &integrator, Real_T (&x)[x_dim])
+{
+	Real_T min_s = 0;
+	Real_T t;
+
+	for (size_t i = 0; i < repeat_dim; ++i) {
+		const auto start_tp = std::chrono::high_resolution_clock::now();
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+		const auto now_tp = std::chrono::high_resolution_clock::now();
+		const auto since_ns =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(now_tp - start_tp);
+		const Real_T since_s = since_ns.count() / 1e9;
+
+		if (i == 0 || since_s < min_s) {
+			min_s = since_s;
+		}
+	}
+	return min_s;
+}
+
+/*
+ * Prints the score of the integrator and returns its time [s]. Each integrator is constructed and
+ * run in its own function, so that the compiler sees the same context for all of them.
+ *
+ * 1. `name`: name of the integrator
+ * 2. `stage_dim`: number of stages
+ * 3. `rk4_s`: time of `Integrator` [s], or 0 for `Integrator` itself
+ *
+ * OUT:
+ * 4. `x`: final state
+ */
+template <typename Integrator_T>
+Real_T
+run(const char *name, const size_t stage_dim, const Real_T rk4_s, Real_T (&x)[x_dim])
+{
+	//* called through a volatile pointer so that none of the loops are inlined into the caller
+	Real_T (*volatile time_loop)(Integrator_T &, Real_T(&)[x_dim]) = time_loop_s<Integrator_T>;
+	Integrator_T integrator(dynamics, &Dynamics::ode_fun, time_step);
+	const Real_T run_s = time_loop(integrator, x);
+	printf("%-28s %8zu %16.3g %16.3g", name, stage_dim, t_dim / run_s,
+	       rk4_s > 0 ? run_s / rk4_s : 1.);
+	return run_s;
+}
+
+template <typename Tableau_T>
+void
+run_tableau(const char *name, const Real_T rk4_s, const Real_T (&x_rk4)[x_dim])
+{
+	Real_T x[x_dim];
+	run<rk4_solver::ExplicitIntegrator<x_dim, Dynamics, Tableau_T>>(name, Tableau_T::stage_dim,
+	                                                                  rk4_s, x);
+	printf(" %16.3g\n", x[0] - x_rk4[0]);
+}
+
+int
+main()
+{
+	Real_T x[x_dim];
+
+	printf("Integrating 3rd order linear ODE for %.3g steps, best of %zu runs.\n",
+	       static_cast<Real_T>(t_dim), repeat_dim);
+	printf("%-28s %8s %16s %16s %16s\n", "integrator", "stages", "steps/s", "relative time",
+	       "x_0 difference");
+
+	const Real_T rk4_s = run<rk4_solver::Integrator<x_dim, Dynamics>>("Integrator", 4, 0, x);
+	printf(" %16.3g\n", 0.);
+
+	run_tableau<tableau::Rk4>("ExplicitIntegrator<Rk4>", rk4_s, x);
+	run_tableau<tableau::Rk38>("ExplicitIntegrator<Rk38>", rk4_s, x);
+	run_tableau<tableau::Rk3>("ExplicitIntegrator<Rk3>", rk4_s, x);
+	run_tableau<tableau::Heun>("ExplicitIntegrator<Heun>", rk4_s, x);
+	run_tableau<tableau::Ralston>("ExplicitIntegrator<Ralston>", rk4_s, x);
+	run_tableau<tableau::Euler>("ExplicitIntegrator<Euler>", rk4_s, x);
+
+	return 0;
+}
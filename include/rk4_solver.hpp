@@ -32,7 +32,11 @@
 
 //#include "rk4_solver/cum_loop.hpp"
 #include "rk4_solver/loop.hpp"
+#include "rk4_solver/explicit_integrator.hpp"
 #include "rk4_solver/integrator.hpp"
+#include "rk4_solver/parareal.hpp"
+#include "rk4_solver/sweep.hpp"
+#include "rk4_solver/trajectory.hpp"
 #include "rk4_solver/types.hpp"
 
 #endif
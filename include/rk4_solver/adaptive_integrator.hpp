@@ -0,0 +1,380 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ADAPTIVE_INTEGRATOR_HPP_CINARAL_261017_1120
+#define ADAPTIVE_INTEGRATOR_HPP_CINARAL_261017_1120
+
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cmath>
+#include <limits>
+
+namespace rk4_solver
+{
+/*
+ * Adaptive-step integrator using the embedded Dormand-Prince 5(4) method. The step size is chosen
+ * such that the local error estimate stays within `abs_tol + rel_tol * |x|` for each state element.
+ * The last stage of an accepted step is reused as the first stage of the next step (FSAL) if the
+ * next step starts where the last one ended.
+ */
+template <size_t X_DIM, typename T> class AdaptiveIntegrator
+{
+  public:
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, `step(...)` then
+	 * returns false.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `abs_tol`: absolute tolerance
+	 * 4. `rel_tol`: relative tolerance
+	 * 5. `max_step`: maximum step size [s]
+	 * 6. `min_step`: minimum step size [s], steps are not rejected at this size
+	 * 7. `init_step`: initial step size [s], it is estimated if zero
+	 * 8. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	AdaptiveIntegrator(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T abs_tol = 1e-6,
+	                   const Real_T rel_tol = 1e-6,
+	                   const Real_T max_step = std::numeric_limits<Real_T>::infinity(),
+	                   const Real_T min_step = 0, const Real_T init_step = 0,
+	                   const Allocator &allocator = Allocator())
+	    : obj(obj), ode_fun(ode_fun), abs_tol(abs_tol), rel_tol(rel_tol), max_step(max_step),
+	      min_step(min_step), init_step(init_step), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next accepted Dormand-Prince 5(4) step, rejected steps are retried with a
+	 * smaller step size. The step does not go past `t_max`.
+	 * Returns false if the error could not be controlled at `min_step`, the step is then taken
+	 * anyway. A non-finite error is rejected until the step size reaches `min_step`, which is
+	 * a step of size 0 if `min_step` is 0. Also returns false without a step if `is_good()` is
+	 * false.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 * 3. `t_max`: maximum next time [s]
+	 *
+	 * OUT:
+	 * 4. `t_next`: next time [s]
+	 * 5. `x_next`: next_state
+	 */
+	bool
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM],
+	     const Real_T t_max = std::numeric_limits<Real_T>::infinity())
+	{
+		if (!is_good()) {
+			return false;
+		}
+		Buffers &buf = workspace.get();
+
+		//* first same as last
+		if (!is_fsal_valid(t, x)) {
+			(obj.*ode_fun)(t, x, buf.k_0);
+			++eval_counter;
+		}
+
+		if (time_step <= 0) {
+			time_step = init_step > 0 ? init_step : estimate_init_step(t, x);
+		}
+		bool is_within_tol = false;
+
+		while (true) {
+			Real_T h = time_step < max_step ? time_step : max_step;
+			h = h > min_step ? h : min_step;
+			const bool is_last = t + h >= t_max;
+
+			if (is_last) {
+				h = t_max - t;
+			}
+			const Real_T error = try_step(t, x, h);
+			const bool is_finite = std::isfinite(error);
+			is_within_tol = is_finite && error <= 1;
+
+			//* step size control, the error is O(h^5)
+			constexpr Real_T safety = .9;
+			constexpr Real_T min_factor = .2;
+			constexpr Real_T max_factor = 5.;
+			Real_T factor = max_factor;
+
+			if (!is_finite) {
+				factor = min_factor; //* e.g. the ODE function is NaN at the stages
+			} else if (error > 0) {
+				factor = safety * std::pow(error, static_cast<Real_T>(-.2));
+			}
+			factor = factor < min_factor ? min_factor : factor;
+			factor = factor > max_factor ? max_factor : factor;
+
+			if (is_within_tol || h <= min_step) {
+				if (!is_last || factor < 1) {
+					time_step = h * (is_within_tol ? factor : 1);
+				}
+				t_next = is_last ? t_max : t + h;
+				break;
+			}
+			time_step = h * factor;
+			++reject_counter;
+		}
+
+		//* 5th order solution
+		for (size_t i = 0; i < X_DIM; ++i) {
+			//* compensated (Kahan) summation, ffast-math might break this
+			compensated_dx_i = buf.dx[i] - buf.accumulator[i];
+			buf.x_temp[i] = x[i] + compensated_dx_i;
+			buf.accumulator[i] = (buf.x_temp[i] - x[i]) - compensated_dx_i;
+			x_next[i] = buf.x_temp[i];
+			buf.k_0[i] = buf.k_6[i];
+			buf.x_fsal[i] = buf.x_temp[i];
+		}
+		t_fsal = t_next;
+		has_fsal = true;
+		++step_counter;
+		return is_within_tol;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+		reject_counter = 0;
+		eval_counter = 0;
+		time_step = 0;
+		has_fsal = false;
+
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.accumulator[i] = 0;
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	//* current step size [s]
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	//* number of accepted steps
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+	//* number of rejected steps
+	size_t
+	get_reject_count() const
+	{
+		return reject_counter;
+	}
+
+	//* number of ODE function evaluations
+	size_t
+	get_eval_count() const
+	{
+		return eval_counter;
+	}
+
+  private:
+	T &obj;
+	const OdeFun_T<X_DIM, T> ode_fun;
+	const Real_T abs_tol;
+	const Real_T rel_tol;
+	const Real_T max_step;
+	const Real_T min_step;
+	const Real_T init_step;
+	Real_T time_step;
+	size_t step_counter;
+	size_t reject_counter;
+	size_t eval_counter;
+	Real_T compensated_dx_i;
+	bool has_fsal;
+	Real_T t_fsal;
+
+	/*
+	 * Computes the stages and the increment `dx` for a step of size `h` from (t, x), `k_0` must
+	 * already be `ode_fun(t, x)`. Returns the RMS norm of the scaled error estimate.
+	 */
+	Real_T
+	try_step(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T h)
+	{
+		Buffers &buf = workspace.get();
+
+		//* Dormand-Prince 5(4) Butcher tableau
+		constexpr Real_T c1 = 1. / 5., c2 = 3. / 10., c3 = 4. / 5., c4 = 8. / 9.;
+		constexpr Real_T a10 = 1. / 5.;
+		constexpr Real_T a20 = 3. / 40., a21 = 9. / 40.;
+		constexpr Real_T a30 = 44. / 45., a31 = -56. / 15., a32 = 32. / 9.;
+		constexpr Real_T a40 = 19372. / 6561., a41 = -25360. / 2187., a42 = 64448. / 6561.,
+		                 a43 = -212. / 729.;
+		constexpr Real_T a50 = 9017. / 3168., a51 = -355. / 33., a52 = 46732. / 5247.,
+		                 a53 = 49. / 176., a54 = -5103. / 18656.;
+		constexpr Real_T b0 = 35. / 384., b2 = 500. / 1113., b3 = 125. / 192.,
+		                 b4 = -2187. / 6784., b5 = 11. / 84.;
+		//* difference between the 5th and the 4th order weights
+		constexpr Real_T e0 = 71. / 57600., e2 = -71. / 16695., e3 = 71. / 1920.,
+		                 e4 = -17253. / 339200., e5 = 22. / 525., e6 = -1. / 40.;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] = x[i] + h * a10 * buf.k_0[i];
+		}
+		(obj.*ode_fun)(t + c1 * h, buf.x_temp, buf.k_1);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] = x[i] + h * (a20 * buf.k_0[i] + a21 * buf.k_1[i]);
+		}
+		(obj.*ode_fun)(t + c2 * h, buf.x_temp, buf.k_2);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] =
+			    x[i] + h * (a30 * buf.k_0[i] + a31 * buf.k_1[i] + a32 * buf.k_2[i]);
+		}
+		(obj.*ode_fun)(t + c3 * h, buf.x_temp, buf.k_3);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] = x[i] + h * (a40 * buf.k_0[i] + a41 * buf.k_1[i] +
+			                            a42 * buf.k_2[i] + a43 * buf.k_3[i]);
+		}
+		(obj.*ode_fun)(t + c4 * h, buf.x_temp, buf.k_4);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] = x[i] + h * (a50 * buf.k_0[i] + a51 * buf.k_1[i] +
+			                            a52 * buf.k_2[i] + a53 * buf.k_3[i] +
+			                            a54 * buf.k_4[i]);
+		}
+		(obj.*ode_fun)(t + h, buf.x_temp, buf.k_5);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.dx[i] = h * (b0 * buf.k_0[i] + b2 * buf.k_2[i] + b3 * buf.k_3[i] +
+			                 b4 * buf.k_4[i] + b5 * buf.k_5[i]);
+			buf.x_temp[i] = x[i] + buf.dx[i];
+		}
+		(obj.*ode_fun)(t + h, buf.x_temp, buf.k_6);
+		eval_counter += 6;
+
+		Real_T error_sq = 0;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const Real_T error_i =
+			    h * (e0 * buf.k_0[i] + e2 * buf.k_2[i] + e3 * buf.k_3[i] +
+			         e4 * buf.k_4[i] + e5 * buf.k_5[i] + e6 * buf.k_6[i]);
+			const Real_T scale_i =
+			    abs_tol + rel_tol * std::fmax(std::abs(x[i]), std::abs(buf.x_temp[i]));
+			error_sq += (error_i / scale_i) * (error_i / scale_i);
+		}
+		return std::sqrt(error_sq / X_DIM);
+	}
+
+	/*
+	 * Estimates the initial step size from the derivatives at (t, x), see
+	 * E. Hairer, S. P. Norsett, G. Wanner, Solving Ordinary Differential Equations I, II.4.
+	 * `k_0` must already be `ode_fun(t, x)`.
+	 */
+	Real_T
+	estimate_init_step(const Real_T &t, const Real_T (&x)[X_DIM])
+	{
+		Buffers &buf = workspace.get();
+
+		Real_T d0 = 0;
+		Real_T d1 = 0;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const Real_T scale_i = abs_tol + rel_tol * std::abs(x[i]);
+			d0 += (x[i] / scale_i) * (x[i] / scale_i);
+			d1 += (buf.k_0[i] / scale_i) * (buf.k_0[i] / scale_i);
+		}
+		d0 = std::sqrt(d0 / X_DIM);
+		d1 = std::sqrt(d1 / X_DIM);
+		const Real_T h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : .01 * d0 / d1;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.x_temp[i] = x[i] + h0 * buf.k_0[i];
+		}
+		(obj.*ode_fun)(t + h0, buf.x_temp, buf.k_1);
+		++eval_counter;
+
+		Real_T d2 = 0;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const Real_T scale_i = abs_tol + rel_tol * std::abs(x[i]);
+			const Real_T d_k_i = (buf.k_1[i] - buf.k_0[i]) / scale_i;
+			d2 += d_k_i * d_k_i;
+		}
+		d2 = std::sqrt(d2 / X_DIM) / h0;
+
+		const Real_T d_max = d1 > d2 ? d1 : d2;
+		const Real_T h1 = d_max <= 1e-15 ? std::fmax(static_cast<Real_T>(1e-6), h0 * 1e-3)
+		                                 : std::pow(.01 / d_max, static_cast<Real_T>(.2));
+		const Real_T h = h1 < 100 * h0 ? h1 : 100 * h0;
+		return h > 0 && std::isfinite(h) ? h : 1e-6; //* e.g. the ODE function is NaN at `x`
+	}
+
+	bool
+	is_fsal_valid(const Real_T &t, const Real_T (&x)[X_DIM]) const
+	{
+		const Buffers &buf = workspace.get();
+
+		if (!has_fsal || t != t_fsal) {
+			return false;
+		}
+		for (size_t i = 0; i < X_DIM; ++i) {
+			if (x[i] != buf.x_fsal[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T k_0[X_DIM];
+		alignas(cache_line_size) Real_T k_1[X_DIM];
+		alignas(cache_line_size) Real_T k_2[X_DIM];
+		alignas(cache_line_size) Real_T k_3[X_DIM];
+		alignas(cache_line_size) Real_T k_4[X_DIM];
+		alignas(cache_line_size) Real_T k_5[X_DIM];
+		alignas(cache_line_size) Real_T k_6[X_DIM];
+		alignas(cache_line_size) Real_T dx[X_DIM];
+		alignas(cache_line_size) Real_T x_temp[X_DIM];
+		alignas(cache_line_size) Real_T x_fsal[X_DIM];
+		alignas(cache_line_size) Real_T accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASYNC_SINK_HPP_CINARAL_261017_2345
+#define ASYNC_SINK_HPP_CINARAL_261017_2345
+
+#include "types.hpp"
+#include "workspace.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace rk4_solver
+{
+//* what `AsyncSink` does with a new chunk when its queue is full
+enum class Backpressure {
+	block,           //* wait for the consumer thread, no chunk is lost
+	drop,            //* drop the new chunk
+	overwrite_oldest //* drop the oldest chunk in the queue to make room for the new one
+};
+
+/*
+ * Bounded lock-free queue of up to `N` slot indices. Only one thread may push, any thread may pop.
+ * The head and the tail only grow, so a pop that raced with another one fails its
+ * compare-and-swap instead of taking a slot twice.
+ */
+template <size_t N> class IndexQueue
+{
+  public:
+	//* false if the queue is full
+	bool
+	push(const size_t idx)
+	{
+		const size_t h = head.load(std::memory_order_relaxed);
+
+		if (h - tail.load(std::memory_order_acquire) == N) {
+			return false;
+		}
+		arr[h % N].store(idx, std::memory_order_relaxed);
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	//* false if the queue is empty
+	bool
+	pop(size_t &idx)
+	{
+		size_t t = tail.load(std::memory_order_acquire);
+
+		while (t != head.load(std::memory_order_acquire)) {
+			idx = arr[t % N].load(std::memory_order_relaxed);
+
+			if (tail.compare_exchange_weak(t, t + 1, std::memory_order_acq_rel,
+			                               std::memory_order_acquire)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool
+	is_empty() const
+	{
+		return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+	}
+
+  private:
+	//* the head and the tail are written by different threads, so they are on their own lines
+	alignas(cache_line_size) std::atomic<size_t> head{0};
+	alignas(cache_line_size) std::atomic<size_t> tail{0};
+	alignas(cache_line_size) std::atomic<size_t> arr[N];
+};
+
+/*
+ * Sink that passes the chunks to `sink` on a consumer thread, so that a slow sink, e.g. a
+ * `FileSink`, does not stall the integration. The integrating thread fills the chunks in place
+ * and queues up to `Q_DIM` of them in a lock-free queue, and the consumer thread writes them to
+ * `sink` in order. When the queue is full, `backpressure` decides whether the integrating thread
+ * waits or a chunk is dropped.
+ *
+ * Only one thread may write to the async sink. `sink` must not be used by other threads until
+ * `flush()` returns or the async sink is destroyed, which writes the queued chunks first.
+ */
+template <size_t Q_DIM, size_t X_DIM, typename Sink_T> class AsyncSink
+{
+  public:
+	static constexpr size_t chunk_dim = Sink_T::chunk_dim;
+
+	/*
+	 * 1. `sink`: sink object that is written by the consumer thread
+	 * 2. `backpressure`: what to do with a new chunk when the queue is full
+	 * 3. `allocator`: allocator of the chunks
+	 */
+	explicit AsyncSink(Sink_T &sink, const Backpressure backpressure = Backpressure::block,
+	                   const Allocator &allocator = Allocator())
+	    : sink(sink), backpressure(backpressure), workspace(allocator)
+	{
+		for (size_t i = 1; i < S_DIM; ++i) {
+			free_queue.push(i);
+		}
+		consumer = std::thread(&AsyncSink::consume, this);
+	}
+
+	~AsyncSink()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			is_stopping.store(true, std::memory_order_release);
+		}
+		condition.notify_one();
+		consumer.join();
+	}
+
+	AsyncSink(const AsyncSink &) = delete;
+	AsyncSink &operator=(const AsyncSink &) = delete;
+
+	void
+	write(const Real_T (&t)[chunk_dim], const Real_T (&x)[chunk_dim][X_DIM], const size_t count)
+	{
+		if (!is_good()) {
+			return;
+		}
+		Real_T(&t_chunk)[chunk_dim] = get_t_chunk();
+		Real_T(&x_chunk)[chunk_dim][X_DIM] = get_x_chunk();
+
+		for (size_t i = 0; i < count; ++i) {
+			t_chunk[i] = t[i];
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_chunk[i][j] = x[i][j];
+			}
+		}
+		commit(count);
+	}
+
+	//* time of the chunk that is being filled, valid until the next `commit`, if `is_good()`
+	Real_T (&get_t_chunk())[chunk_dim]
+	{
+		return workspace.get().slots[write_idx].t;
+	}
+
+	//* states of the chunk that is being filled, valid until the next `commit`, if `is_good()`
+	Real_T (&get_x_chunk())[chunk_dim][X_DIM]
+	{
+		return workspace.get().slots[write_idx].x;
+	}
+
+	/*
+	 * Queues the chunk that is being filled, and starts filling the next one.
+	 *
+	 * 1. `count`: number of valid rows of the chunk
+	 */
+	void
+	commit(const size_t count)
+	{
+		if (!is_good() || count == 0) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+		buf.slots[write_idx].count = count;
+		sample_count += count;
+
+		for (size_t i = 0; !full_queue.push(write_idx); ++i) {
+			if (backpressure == Backpressure::drop) {
+				dropped_count += count;
+				return; //* keep filling the same slot
+			}
+			size_t oldest_idx;
+
+			if (backpressure == Backpressure::overwrite_oldest &&
+			    full_queue.pop(oldest_idx)) {
+				//* the consumer did not take the oldest chunk, so it is reused
+				dropped_count += buf.slots[oldest_idx].count;
+				full_queue.push(write_idx);
+				write_idx = oldest_idx;
+				wake_consumer();
+				return;
+			}
+			if (i > spin_dim) {
+				std::this_thread::yield();
+			}
+		}
+		wake_consumer();
+
+		//* there is always a free slot after a push, since the queue holds one less
+		while (!free_queue.pop(write_idx)) {
+			std::this_thread::yield();
+		}
+	}
+
+	//* blocks until the consumer thread has written all queued chunks to the sink
+	void
+	flush()
+	{
+		const size_t queued_count = sample_count - dropped_count;
+
+		while (written_count.load(std::memory_order_acquire) != queued_count) {
+			std::this_thread::yield();
+		}
+	}
+
+	//* true if the chunks could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	//* number of samples committed
+	size_t
+	get_total_count() const
+	{
+		return sample_count;
+	}
+
+	//* number of committed samples that were dropped because the queue was full
+	size_t
+	get_dropped_count() const
+	{
+		return dropped_count;
+	}
+
+  private:
+	static constexpr size_t spin_dim = 1 << 10; //* busy-wait iterations before waiting
+	//* one slot is filled, `Q_DIM` are queued and one is written by the consumer thread
+	static constexpr size_t S_DIM = Q_DIM + 2;
+
+	Sink_T &sink;
+	const Backpressure backpressure;
+	size_t write_idx = 0;
+	size_t sample_count = 0;
+	size_t dropped_count = 0;
+	IndexQueue<Q_DIM> full_queue;
+	IndexQueue<S_DIM> free_queue;
+	alignas(cache_line_size) std::atomic<size_t> written_count{0};
+	std::atomic<bool> is_sleeping{false};
+	std::atomic<bool> is_stopping{false};
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::thread consumer;
+
+	struct alignas(cache_line_size) Slot {
+		Real_T t[chunk_dim];
+		Real_T x[chunk_dim][X_DIM];
+		size_t count;
+	};
+	struct Buffers {
+		Slot slots[S_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	//* the consumer thread only sleeps when it is idle, so this is one load per chunk
+	void
+	wake_consumer()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (is_sleeping.load(std::memory_order_relaxed)) {
+			std::lock_guard<std::mutex> lock(mutex);
+			condition.notify_one();
+		}
+	}
+
+	void
+	consume()
+	{
+		size_t idx;
+
+		while (true) {
+			size_t i = 0;
+
+			for (; i < spin_dim; ++i) {
+				if (full_queue.pop(idx)) {
+					break;
+				}
+			}
+
+			if (i == spin_dim) {
+				std::unique_lock<std::mutex> lock(mutex);
+				is_sleeping.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				condition.wait(lock, [&] {
+					return !full_queue.is_empty() ||
+					       is_stopping.load(std::memory_order_acquire);
+				});
+				is_sleeping.store(false, std::memory_order_relaxed);
+
+				if (!full_queue.pop(idx)) {
+					if (is_stopping.load(std::memory_order_acquire)) {
+						return;
+					}
+					continue; //* the producer took the chunk back to reuse it
+				}
+			}
+			const Slot &slot = workspace.get().slots[idx];
+			sink.write(slot.t, slot.x, slot.count);
+			written_count.fetch_add(slot.count, std::memory_order_release);
+			free_queue.push(idx);
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATCH_INTEGRATOR_HPP_CINARAL_261017_0910
+#define BATCH_INTEGRATOR_HPP_CINARAL_261017_0910
+
+#include "types.hpp"
+#include "workspace.hpp"
+
+namespace rk4_solver
+{
+/*
+ * Runge-Kutta 4th Order integrator for an ensemble of `N` initial conditions that are advanced in
+ * lockstep. The ensemble is stored in structure-of-arrays layout, i.e. `x[i][j]` is the state
+ * element `i` of the ensemble member `j`, so that the stage sums and the compensated update are
+ * contiguous loops over the ensemble that the compiler can vectorize.
+ */
+template <size_t N, size_t X_DIM, typename T> class BatchIntegrator
+{
+  public:
+	BatchIntegrator(T &obj, BatchOdeFun_T<N, X_DIM, T> ode_fun, const Real_T time_step,
+	                const Real_T t_init = 0, const Allocator &allocator = Allocator())
+	    : obj(obj), ode_fun(ode_fun), time_step(time_step), t_init(t_init), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next Runge-Kutta 4th Order step for all ensemble members.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: ensemble state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next ensemble state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM][N], Real_T &t_next,
+	     Real_T (&x_next)[X_DIM][N])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				for (size_t j = 0; j < N; ++j) {
+					x_next[i][j] = x[i][j];
+				}
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		//* ode_fun(ti, xi)
+		(obj.*ode_fun)(t, x, buf.k_0);
+
+		//* ode_fun(ti + h/2, xi + h/2*k_0)
+		weighted_sum(time_step / 2, buf.k_0, x, buf.x_temp);
+		(obj.*ode_fun)(t + time_step / 2, buf.x_temp, buf.k_1);
+
+		//* ode_fun(ti + h/2, xi + h/2*k_1)
+		weighted_sum(time_step / 2, buf.k_1, x, buf.x_temp);
+		(obj.*ode_fun)(t + time_step / 2, buf.x_temp, buf.k_2);
+
+		//* ode_fun(ti + h, xi + k_2)
+		weighted_sum(time_step, buf.k_2, x, buf.x_temp);
+		(obj.*ode_fun)(t + time_step, buf.x_temp, buf.k_3);
+
+		constexpr Real_T w0 = 1. / 6.;
+		constexpr Real_T w1 = 1. / 3.;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				const Real_T dx_ij =
+				    time_step * (w0 * buf.k_0[i][j] + w1 * buf.k_1[i][j] +
+				                 w1 * buf.k_2[i][j] + w0 * buf.k_3[i][j]);
+				//* compensated (Kahan) summation, ffast-math might break this
+				const Real_T compensated_dx_ij = dx_ij - buf.accumulator[i][j];
+				const Real_T x_next_ij = x[i][j] + compensated_dx_ij;
+				buf.accumulator[i][j] = (x_next_ij - x[i][j]) - compensated_dx_ij;
+				x_next[i][j] = x_next_ij;
+			}
+		}
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				buf.accumulator[i][j] = 0;
+			}
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	T &obj;
+	const BatchOdeFun_T<N, X_DIM, T> ode_fun;
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter;
+
+	/*
+	 * c = a*k + x over the whole ensemble
+	 */
+	static void
+	weighted_sum(const Real_T a, const Real_T (&k)[X_DIM][N], const Real_T (&x)[X_DIM][N],
+	             Real_T (&c)[X_DIM][N])
+	{
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				c[i][j] = a * k[i][j] + x[i][j];
+			}
+		}
+	}
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T k_0[X_DIM][N];
+		alignas(cache_line_size) Real_T k_1[X_DIM][N];
+		alignas(cache_line_size) Real_T k_2[X_DIM][N];
+		alignas(cache_line_size) Real_T k_3[X_DIM][N];
+		alignas(cache_line_size) Real_T x_temp[X_DIM][N];
+		alignas(cache_line_size) Real_T accumulator[X_DIM][N];
+	};
+	Workspace<Buffers> workspace;
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BINDING_HPP_CINARAL_261017_1810
+#define BINDING_HPP_CINARAL_261017_1810
+
+#include "types.hpp"
+#include <utility>
+
+/*
+ * Bindings call the ODE and event functions. A binding is a callable with the signature of the
+ * bound function, e.g. `void(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])`.
+ * The integrators store the binding by value, so a binding whose function is known at compile time
+ * can be inlined into the stage evaluations.
+ */
+
+namespace rk4_solver
+{
+/*
+ * Calls a member function through a pointer that is stored at run time, i.e. `(obj.*fun)(...)`.
+ */
+template <typename T, typename Fun_T> class MemberBinding
+{
+  public:
+	MemberBinding(T &obj, Fun_T fun) : obj(obj), fun(fun)
+	{
+	}
+
+	template <typename... Args_T>
+	decltype(auto)
+	operator()(Args_T &&...args) const
+	{
+		return (obj.*fun)(std::forward<Args_T>(args)...);
+	}
+
+  private:
+	T &obj;
+	Fun_T fun;
+};
+
+//* class, state dimension and scalar type of an ODE member function of type `OdeFun_T<X_DIM, T, R>`
+template <typename Fun_T> struct OdeFunTraits;
+
+template <size_t X_DIM, typename T, typename R> struct OdeFunTraits<OdeFun_T<X_DIM, T, R>> {
+	using Class_T = T;
+	using Value_T = R;
+	static constexpr size_t x_dim = X_DIM;
+};
+
+//* class, state dimension and scalar type of a stage-aware ODE member function of type
+//* `StageFun_T<X_DIM, T, R>`
+template <typename Fun_T> struct StageFunTraits;
+
+template <size_t X_DIM, typename T, typename R> struct StageFunTraits<StageFun_T<X_DIM, T, R>> {
+	using Class_T = T;
+	using Value_T = R;
+	static constexpr size_t x_dim = X_DIM;
+};
+
+//* class, state dimension and scalar type of a range ODE member function of type
+//* `RangeOdeFun_T<X_DIM, T, R>`
+template <typename Fun_T> struct RangeOdeFunTraits;
+
+template <size_t X_DIM, typename T, typename R>
+struct RangeOdeFunTraits<RangeOdeFun_T<X_DIM, T, R>> {
+	using Class_T = T;
+	using Value_T = R;
+	static constexpr size_t x_dim = X_DIM;
+};
+
+//* class of a member function
+template <typename Fun_T> struct MemberTraits;
+
+template <typename R, typename T, typename... Args_T> struct MemberTraits<R (T::*)(Args_T...)> {
+	using Class_T = T;
+};
+
+/*
+ * Calls the member function `FUN` which is known at compile time, e.g.
+ * `StaticMemberBinding<&Dynamics::ode_fun>`.
+ */
+template <auto FUN> class StaticMemberBinding
+{
+	using T = typename MemberTraits<decltype(FUN)>::Class_T;
+
+  public:
+	explicit StaticMemberBinding(T &obj) : obj(obj)
+	{
+	}
+
+	template <typename... Args_T>
+	decltype(auto)
+	operator()(Args_T &&...args) const
+	{
+		return (obj.*FUN)(std::forward<Args_T>(args)...);
+	}
+
+  private:
+	T &obj;
+};
+
+/*
+ * Calls a lambda, a functor or a free function, which is stored by value.
+ */
+template <typename F> class CallableBinding
+{
+  public:
+	explicit CallableBinding(F fun) : fun(std::move(fun))
+	{
+	}
+
+	template <typename... Args_T>
+	decltype(auto)
+	operator()(Args_T &&...args)
+	{
+		return fun(std::forward<Args_T>(args)...);
+	}
+
+  private:
+	F fun;
+};
+} // namespace rk4_solver
+
+#endif
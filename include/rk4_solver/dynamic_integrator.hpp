@@ -0,0 +1,263 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DYNAMIC_INTEGRATOR_HPP_CINARAL_261017_1610
+#define DYNAMIC_INTEGRATOR_HPP_CINARAL_261017_1610
+
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cstdint>
+
+namespace rk4_solver
+{
+/*
+ * Runge-Kutta 4th Order integrator for systems whose size is only known at run time. The stage
+ * buffers are 64 byte aligned slices of a single arena, which is either allocated once by the
+ * integrator with an `Allocator` or supplied by the caller.
+ */
+template <typename T> class DynamicIntegrator
+{
+  public:
+	static constexpr size_t alignment = cache_line_size; //* [bytes]
+	static constexpr size_t buffer_dim = 6;  //* k_0, k_1, k_2, k_3, x_temp, accumulator
+
+	//* number of `Real_T`s per buffer, rounded up to a multiple of the alignment
+	static constexpr size_t
+	get_padded_dim(const size_t x_dim)
+	{
+		constexpr size_t align_dim = alignment / sizeof(Real_T);
+		return (x_dim + align_dim - 1) / align_dim * align_dim;
+	}
+
+	//* number of `Real_T`s of the arena for `x_dim` states
+	static constexpr size_t
+	get_arena_dim(const size_t x_dim)
+	{
+		return buffer_dim * get_padded_dim(x_dim);
+	}
+
+#ifndef DO_NOT_USE_HEAP
+	/*
+	 * Allocates the arena with `allocator`, `is_good()` returns false if the allocation fails.
+	 */
+	DynamicIntegrator(T &obj, DynamicOdeFun_T<T> ode_fun, const size_t x_dim,
+	                  const Real_T time_step, const Real_T t_init = 0,
+	                  const Allocator &allocator = Allocator())
+	    : obj(obj), ode_fun(ode_fun), x_dim(x_dim), time_step(time_step), t_init(t_init),
+	      allocator(allocator),
+	      arena(static_cast<Real_T *>(allocator.allocate(get_arena_byte_dim(x_dim), alignment,
+	                                                     allocator.context))),
+	      is_owner(arena != nullptr)
+	{
+		assign_buffers();
+		reset();
+	}
+#endif
+
+	/*
+	 * Uses an arena supplied by the caller, which must be aligned to `alignment` bytes and hold
+	 * at least `get_arena_dim(x_dim)` elements, otherwise `is_good()` returns false.
+	 */
+	DynamicIntegrator(T &obj, DynamicOdeFun_T<T> ode_fun, const size_t x_dim,
+	                  Span<Real_T> arena, const Real_T time_step, const Real_T t_init = 0)
+	    : obj(obj), ode_fun(ode_fun), x_dim(x_dim), time_step(time_step), t_init(t_init),
+	      arena(is_valid_arena(x_dim, arena) ? arena.data : nullptr), is_owner(false)
+	{
+		assign_buffers();
+		reset();
+	}
+
+	DynamicIntegrator(DynamicIntegrator &&other)
+	    : obj(other.obj), ode_fun(other.ode_fun), x_dim(other.x_dim),
+	      time_step(other.time_step), t_init(other.t_init), allocator(other.allocator),
+	      arena(other.arena), is_owner(other.is_owner)
+	{
+		step_counter = other.step_counter;
+		assign_buffers();
+		other.arena = nullptr;
+		other.is_owner = false;
+		other.assign_buffers();
+	}
+
+	DynamicIntegrator(const DynamicIntegrator &) = delete;
+	DynamicIntegrator &operator=(const DynamicIntegrator &) = delete;
+	DynamicIntegrator &operator=(DynamicIntegrator &&) = delete;
+
+	~DynamicIntegrator()
+	{
+#ifndef DO_NOT_USE_HEAP
+		if (is_owner) {
+			allocator.deallocate(arena, get_arena_byte_dim(x_dim), alignment,
+			                     allocator.context);
+		}
+#endif
+	}
+
+	/*
+	 * Computes the next Runge-Kutta 4th Order step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 * true if the sizes of `x` and `x_next` match the integrator
+	 */
+	bool
+	step(const Real_T &t, Span<const Real_T> x, Real_T &t_next, Span<Real_T> x_next)
+	{
+		if (!is_good() || x.size != x_dim || x_next.size != x_dim) {
+			return false;
+		}
+		step_by(t, x.data, time_step, x_next.data);
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+		return true;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		for (size_t i = 0; i < x_dim && is_good(); ++i) {
+			accumulator[i] = 0;
+		}
+	}
+
+	//* true if the integrator has an arena
+	bool
+	is_good() const
+	{
+		return arena != nullptr;
+	}
+
+	size_t
+	get_x_dim() const
+	{
+		return x_dim;
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	T &obj;
+	const DynamicOdeFun_T<T> ode_fun;
+	const size_t x_dim;
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter = 0;
+	Allocator allocator;
+	Real_T *arena;
+	bool is_owner;
+	Real_T *k_0;
+	Real_T *k_1;
+	Real_T *k_2;
+	Real_T *k_3;
+	Real_T *x_temp;
+	Real_T *accumulator;
+
+	static constexpr size_t
+	get_arena_byte_dim(const size_t x_dim)
+	{
+		return get_arena_dim(x_dim) * sizeof(Real_T);
+	}
+
+	static bool
+	is_valid_arena(const size_t x_dim, const Span<Real_T> &arena)
+	{
+		return arena.data != nullptr && arena.size >= get_arena_dim(x_dim) &&
+		       reinterpret_cast<std::uintptr_t>(arena.data) % alignment == 0;
+	}
+
+	void
+	assign_buffers()
+	{
+		//* all null without an arena
+		const size_t padded_dim = arena != nullptr ? get_padded_dim(x_dim) : 0;
+		k_0 = arena;
+		k_1 = arena + padded_dim;
+		k_2 = arena + 2 * padded_dim;
+		k_3 = arena + 3 * padded_dim;
+		x_temp = arena + 4 * padded_dim;
+		accumulator = arena + 5 * padded_dim;
+	}
+
+	void
+	step_by(const Real_T &t, const Real_T *x, const Real_T h, Real_T *x_next)
+	{
+		const Span<const Real_T> x_temp_span(x_temp, x_dim);
+
+		//* ode_fun(ti, xi)
+		(obj.*ode_fun)(t, Span<const Real_T>(x, x_dim), Span<Real_T>(k_0, x_dim));
+
+		//* ode_fun(ti + h/2, xi + h/2*k_0)
+		for (size_t i = 0; i < x_dim; ++i) {
+			x_temp[i] = h / 2 * k_0[i] + x[i];
+		}
+		(obj.*ode_fun)(t + h / 2, x_temp_span, Span<Real_T>(k_1, x_dim));
+
+		//* ode_fun(ti + h/2, xi + h/2*k_1)
+		for (size_t i = 0; i < x_dim; ++i) {
+			x_temp[i] = h / 2 * k_1[i] + x[i];
+		}
+		(obj.*ode_fun)(t + h / 2, x_temp_span, Span<Real_T>(k_2, x_dim));
+
+		//* ode_fun(ti + h, xi + k_2)
+		for (size_t i = 0; i < x_dim; ++i) {
+			x_temp[i] = h * k_2[i] + x[i];
+		}
+		(obj.*ode_fun)(t + h, x_temp_span, Span<Real_T>(k_3, x_dim));
+
+		constexpr Real_T w0 = 1. / 6.;
+		constexpr Real_T w1 = 1. / 3.;
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			const Real_T dx_i =
+			    h * (w0 * k_0[i] + w1 * k_1[i] + w1 * k_2[i] + w0 * k_3[i]);
+			//* compensated (Kahan) summation, ffast-math might break this
+			const Real_T compensated_dx_i = dx_i - accumulator[i];
+			x_temp[i] = x[i] + compensated_dx_i;
+			accumulator[i] = (x_temp[i] - x[i]) - compensated_dx_i;
+			x_next[i] = x_temp[i];
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
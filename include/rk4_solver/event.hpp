@@ -27,26 +27,646 @@
 #ifndef EVENT_HPP_CINARAL_230321_1039
 #define EVENT_HPP_CINARAL_230321_1039
 
+#include "binding.hpp"
+#include "instrumentation.hpp"
 #include "types.hpp"
+#include <cmath>
+#include <limits>
+#include <optional>
 
 namespace rk4_solver
 {
-template <size_t X_DIM, typename T> class Event
+/*
+ * Event that is checked after every step. The event function is called through the binding
+ * `Bind_T` (see binding.hpp). The checks and the hits are counted by the instrumentation policy
+ * `Instrument_T` (see instrumentation.hpp), which does nothing by default. Since the loops take
+ * the event by value, an instrumented event refers to an instrumentation object instead of owning
+ * one, e.g. `integrator.get_instrumentation()` to count everything in one place. The scalar type
+ * `R` is `Real_T` by default, as in `Integrator`.
+ */
+template <size_t X_DIM, typename T, typename R = Real_T,
+          typename Bind_T = MemberBinding<T, EventFun_T<X_DIM, T, R>>,
+          typename Instrument_T = NoInstrumentation>
+class Event
 {
   public:
-	Event(T &obj, EventFun_T<X_DIM, T> event_fun) : obj(obj), event_fun(event_fun)
+	Event(T &obj, EventFun_T<X_DIM, T, R> event_fun,
+	      Instrument_T &instrumentation = Instrument_T::get_default())
+	    : event_fun(obj, event_fun), instrumentation(&instrumentation)
+	{
+	}
+
+	explicit Event(Bind_T event_fun,
+	               Instrument_T &instrumentation = Instrument_T::get_default())
+	    : event_fun(std::move(event_fun)), instrumentation(&instrumentation)
 	{
 	}
 
 	int
-	check(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&x_plus)[X_DIM])
+	check(const R t, const R (&x)[X_DIM], R (&x_plus)[X_DIM])
+	{
+		const uint64_t tick = instrumentation->start();
+		const int is_hit = event_fun(t, x, x_plus);
+		instrumentation->lap(Section::event, tick);
+		instrumentation->count_event_check(is_hit != 0);
+		return is_hit;
+	}
+
+  private:
+	Bind_T event_fun;
+	Instrument_T *instrumentation;
+};
+
+/*
+ * Creates an event that calls a lambda, a functor or a free function with the signature
+ * `int(const R t, const R (&x)[X_DIM], R (&x_plus)[X_DIM])`.
+ */
+template <size_t X_DIM, typename R = Real_T, typename F>
+Event<X_DIM, CallableBinding<F>, R, CallableBinding<F>>
+make_event(F fun)
+{
+	using Event_T = Event<X_DIM, CallableBinding<F>, R, CallableBinding<F>>;
+	return Event_T(CallableBinding<F>(std::move(fun)));
+}
+
+//* direction of a zero-crossing of the guard function
+enum class Crossing { rising, falling, both };
+
+/*
+ * Checks whether a guard function crossed zero in the direction `crossing`.
+ *
+ * 1. `crossing`: direction of the zero-crossing
+ * 2. `g`: guard at the start of the step
+ * 3. `g_next`: guard at the end of the step
+ */
+template <typename R>
+bool
+is_zero_crossing(const Crossing crossing, const R g, const R g_next)
+{
+	const bool is_falling = g > 0 && g_next <= 0;
+	const bool is_rising = g < 0 && g_next >= 0;
+
+	switch (crossing) {
+	case Crossing::falling:
+		return is_falling;
+	case Crossing::rising:
+		return is_rising;
+	default:
+		return is_falling || is_rising;
+	}
+}
+
+/*
+ * Locates the zero-crossing of `guard(t, x)` within the last step of the integrator using its
+ * dense output and the Illinois variant of the regula falsi method. Returns the crossing time,
+ * which is at or just after the crossing.
+ *
+ * 1. `integrator`: integrator that took the last step
+ * 2. `guard`: guard function, callable with the signature of `GuardFun_T`
+ * 3. `crossing`: direction of the zero-crossing
+ * 4. `time_tol`: tolerance of the crossing time [s]
+ * 5. `t`: time the last step started from [s]
+ * 6. `x`: state the last step started from
+ * 7. `theta_start`: fraction of the step the search starts from, see `evaluate_reset_guard`
+ * 8. `g`: guard at `theta_start`
+ * 9. `g_next`: guard at the end of the step
+ *
+ * OUT:
+ * 10. `x_cross`: state at the crossing time
+ */
+template <size_t X_DIM, typename R, typename Integrator_T, typename Guard_T>
+R
+locate_zero_crossing(const Integrator_T &integrator, Guard_T &&guard, const Crossing crossing,
+                     const NonDeduced_T<R> time_tol, const R &t, const R (&x)[X_DIM],
+                     const NonDeduced_T<R> theta_start, R g, R g_next, R (&x_cross)[X_DIM])
+{
+	const R h = integrator.get_last_step_size();
+	const R theta_tol = time_tol / h;
+	constexpr size_t max_iter_dim = 64;
+	R theta_a = theta_start;
+	R theta_b = 1;
+	R g_a = g;
+	R g_b = g_next;
+	int side = 0;
+
+	for (size_t i = 0; i < max_iter_dim && theta_b - theta_a > theta_tol; ++i) {
+		R theta = (theta_a * g_b - theta_b * g_a) / (g_b - g_a);
+
+		if (!(theta > theta_a && theta < theta_b)) {
+			theta = (theta_a + theta_b) / 2; //* bisection fallback
+		}
+		integrator.interpolate(theta, x, x_cross);
+		const R g_theta = guard(t + theta * h, x_cross);
+
+		if (is_zero_crossing(crossing, g, g_theta)) {
+			theta_b = theta;
+			g_b = g_theta;
+
+			if (side == -1) {
+				g_a /= 2; //* Illinois modification
+			}
+			side = -1;
+		} else {
+			theta_a = theta;
+			g_a = g_theta;
+
+			if (side == 1) {
+				g_b /= 2;
+			}
+			side = 1;
+		}
+	}
+	integrator.interpolate(theta_b, x, x_cross);
+	return t + theta_b * h;
+}
+
+/*
+ * Evaluates the guard after a reset at the start of the last step of the integrator, i.e. the
+ * step restarted from the reset. The located crossing time is at or just after the crossing, so
+ * the guard at the reset state can still have the sign it crossed to, e.g. a bounce that keeps
+ * the position. If the guard is not farther from zero than before the reset, it is at zero within
+ * the tolerance, and it is taken from the dense output at `time_tol`, `2 * time_tol`, ... after
+ * the reset once it has left zero, where the search of the next crossing within the step starts.
+ * Returns the guard at `theta_start`.
+ *
+ * 1. `integrator`: integrator that took the step from the reset
+ * 2. `guard`: guard function, callable with the signature of `GuardFun_T`
+ * 3. `time_tol`: tolerance of the crossing time [s]
+ * 4. `t`: time of the reset [s]
+ * 5. `x`: state after the reset
+ * 6. `g_cross`: guard at the time of the reset, before the reset
+ *
+ * OUT:
+ * 7. `theta_start`: fraction of the step the search of the next crossing starts from
+ */
+template <size_t X_DIM, typename R, typename Integrator_T, typename Guard_T>
+R
+evaluate_reset_guard(const Integrator_T &integrator, Guard_T &&guard,
+                     const NonDeduced_T<R> time_tol, const R &t, const R (&x)[X_DIM],
+                     const NonDeduced_T<R> g_cross, R &theta_start)
+{
+	const R g_tol = std::abs(g_cross);
+	constexpr size_t max_probe_dim = 64;
+	R theta = 0;
+	R g_theta = guard(t, x);
+
+	if (std::abs(g_theta) <= g_tol) {
+		const R h = integrator.get_last_step_size();
+		R x_theta[X_DIM];
+		R dt = time_tol;
+
+		for (size_t i = 0; i < max_probe_dim && theta < 1 && std::abs(g_theta) <= g_tol;
+		     ++i, dt *= 2) {
+			theta = dt < h ? dt / h : 1;
+			integrator.interpolate(theta, x, x_theta);
+			g_theta = guard(t + theta * h, x_theta);
+		}
+	}
+	theta_start = theta;
+	return g_theta;
+}
+
+/*
+ * Event that occurs when the guard function `guard_fun(t, x)` crosses zero in the given direction.
+ * The crossing is located within the step using the dense output of the integrator, and the reset
+ * function `reset_fun(t, x, x_plus)` is applied at the located crossing time. If the event is
+ * terminal, the integration stops at the crossing. The scalar type `R` is `Real_T` by default, as
+ * in `Integrator`.
+ */
+template <size_t X_DIM, typename T, typename R = Real_T> class ZeroCrossingEvent
+{
+  public:
+	/*
+	 * 1. `obj`: object of the guard and the reset functions
+	 * 2. `guard_fun`: guard function, the event occurs when it crosses zero
+	 * 3. `reset_fun`: reset function, computes the state after the event
+	 * 4. `crossing`: direction of the zero-crossing
+	 * 5. `is_terminal`: stop at the event
+	 * 6. `time_tol`: tolerance of the crossing time [s]
+	 */
+	ZeroCrossingEvent(T &obj, GuardFun_T<X_DIM, T, R> guard_fun,
+	                  ResetFun_T<X_DIM, T, R> reset_fun,
+	                  const Crossing crossing = Crossing::both, const bool is_terminal = false,
+	                  const R time_tol = 64 * std::numeric_limits<R>::epsilon())
+	    : obj(obj), guard_fun(guard_fun), reset_fun(reset_fun), crossing(crossing),
+	      is_terminal(is_terminal), time_tol(time_tol)
+	{
+	}
+
+	R
+	guard(const R t, const R (&x)[X_DIM])
+	{
+		return (obj.*guard_fun)(t, x);
+	}
+
+	void
+	reset(const R t, const R (&x)[X_DIM], R (&x_plus)[X_DIM])
+	{
+		(obj.*reset_fun)(t, x, x_plus);
+	}
+
+	/*
+	 * Checks whether the guard function crossed zero in the event direction.
+	 *
+	 * 1. `g`: guard at the start of the step
+	 * 2. `g_next`: guard at the end of the step
+	 */
+	bool
+	is_crossing(const R g, const R g_next) const
+	{
+		return is_zero_crossing(crossing, g, g_next);
+	}
+
+	/*
+	 * Locates the crossing within the last step of the integrator, see `locate_zero_crossing`.
+	 *
+	 * 1. `integrator`: integrator that took the last step
+	 * 2. `t`: time the last step started from [s]
+	 * 3. `x`: state the last step started from
+	 * 4. `theta_start`: fraction of the step the search starts from
+	 * 5. `g`: guard at `theta_start`
+	 * 6. `g_next`: guard at the end of the step
+	 *
+	 * OUT:
+	 * 7. `x_cross`: state at the crossing time
+	 */
+	template <typename Integrator_T>
+	R
+	locate(const Integrator_T &integrator, const R &t, const R (&x)[X_DIM],
+	       const R theta_start, R g, R g_next, R (&x_cross)[X_DIM])
+	{
+		auto guard_fun = [this](const R t_theta, const R(&x_theta)[X_DIM]) {
+			return guard(t_theta, x_theta);
+		};
+		return locate_zero_crossing(integrator, guard_fun, crossing, time_tol, t, x,
+		                            theta_start, g, g_next, x_cross);
+	}
+
+	/*
+	 * Evaluates the guard after a reset at the start of the last step of the integrator, see
+	 * `evaluate_reset_guard`.
+	 *
+	 * 1. `integrator`: integrator that took the step from the reset
+	 * 2. `t`: time of the reset [s]
+	 * 3. `x`: state after the reset
+	 * 4. `g_cross`: guard at the time of the reset, before the reset
+	 *
+	 * OUT:
+	 * 5. `theta_start`: fraction of the step the search of the next crossing starts from
+	 */
+	template <typename Integrator_T>
+	R
+	reset_guard(const Integrator_T &integrator, const R &t, const R (&x)[X_DIM],
+	            const R g_cross, R &theta_start)
+	{
+		auto guard_fun = [this](const R t_theta, const R(&x_theta)[X_DIM]) {
+			return guard(t_theta, x_theta);
+		};
+		return evaluate_reset_guard(integrator, guard_fun, time_tol, t, x, g_cross,
+		                            theta_start);
+	}
+
+	bool
+	get_is_terminal() const
 	{
-		return (obj.*event_fun)(t, x, x_plus);
+		return is_terminal;
 	}
 
   private:
 	T &obj;
-	EventFun_T<X_DIM, T> event_fun;
+	const GuardFun_T<X_DIM, T, R> guard_fun;
+	const ResetFun_T<X_DIM, T, R> reset_fun;
+	const Crossing crossing;
+	const bool is_terminal;
+	const R time_tol;
+};
+
+/*
+ * Set of up to `EVENT_DIM` zero-crossing events of the same object, e.g. the contact surfaces and
+ * the mode switches of a hybrid model. Each event has a guard function, a reset function, a
+ * direction, a priority and a terminal flag as in `ZeroCrossingEvent`. After every step, the
+ * guards are evaluated once each, and only the events whose guard changed sign are located and
+ * reset, see `step_event_set`.
+ *
+ * The earliest crossing is handled first. Crossings within `time_tol` of it are simultaneous,
+ * and their reset functions are applied in one pass at the latest of their crossing times, in the
+ * order of descending priority, then in the order they were added, each to the state after the
+ * previous one. A terminal event stops the pass and the integration after its own reset. After
+ * its reset, the guard of an event is evaluated on the restarted step by `evaluate_reset_guard`
+ * as in `step_zero_crossing`, so that it can cross again within the rest of the step.
+ *
+ * The guard and the reset functions are called through the bindings `GuardBind_T` and
+ * `ResetBind_T` (see binding.hpp), which by default call member functions of `T` through
+ * pointers. The guard checks after every step and the resets are counted by the instrumentation
+ * policy of the integrator, as the checks and the hits of `Event`.
+ */
+template <size_t X_DIM, typename T, size_t EVENT_DIM, typename R = Real_T,
+          typename GuardBind_T = MemberBinding<T, GuardFun_T<X_DIM, T, R>>,
+          typename ResetBind_T = MemberBinding<T, ResetFun_T<X_DIM, T, R>>>
+class EventSet
+{
+  public:
+	/*
+	 * 1. `obj`: object of the guard and the reset member functions
+	 * 2. `time_tol`: tolerance of the crossing times [s]
+	 */
+	explicit EventSet(T &obj, const R time_tol = 64 * std::numeric_limits<R>::epsilon())
+	    : obj(&obj), time_tol(time_tol)
+	{
+	}
+
+	/*
+	 * Event set without an object, whose events are added as bindings, e.g. of
+	 * `CallableBinding`.
+	 *
+	 * 1. `time_tol`: tolerance of the crossing times [s]
+	 */
+	explicit EventSet(const R time_tol = 64 * std::numeric_limits<R>::epsilon())
+	    : obj(nullptr), time_tol(time_tol)
+	{
+	}
+
+	/*
+	 * Adds an event of member functions of the object, returns false if the set is full or
+	 * has no object.
+	 *
+	 * 1. `guard_fun`: guard function, the event occurs when it crosses zero
+	 * 2. `reset_fun`: reset function, computes the state after the event
+	 * 3. `crossing`: direction of the zero-crossing
+	 * 4. `priority`: events of higher priority are reset first when they are simultaneous
+	 * 5. `is_terminal`: stop at the event
+	 */
+	bool
+	add(GuardFun_T<X_DIM, T, R> guard_fun, ResetFun_T<X_DIM, T, R> reset_fun,
+	    const Crossing crossing = Crossing::both, const int priority = 0,
+	    const bool is_terminal = false)
+	{
+		if (obj == nullptr) {
+			return false;
+		}
+		return add(GuardBind_T(*obj, guard_fun), ResetBind_T(*obj, reset_fun), crossing,
+		           priority, is_terminal);
+	}
+
+	/*
+	 * Adds an event of bound functions, returns false if the set is full.
+	 *
+	 * 1. `guard_fun`: binding of the guard function, the event occurs when it crosses zero
+	 * 2. `reset_fun`: binding of the reset function, computes the state after the event
+	 * 3. `crossing`: direction of the zero-crossing
+	 * 4. `priority`: events of higher priority are reset first when they are simultaneous
+	 * 5. `is_terminal`: stop at the event
+	 */
+	bool
+	add(GuardBind_T guard_fun, ResetBind_T reset_fun, const Crossing crossing = Crossing::both,
+	    const int priority = 0, const bool is_terminal = false)
+	{
+		if (event_dim >= EVENT_DIM) {
+			return false;
+		}
+		Entry &entry = entries[event_dim];
+		entry.guard_fun.emplace(std::move(guard_fun));
+		entry.reset_fun.emplace(std::move(reset_fun));
+		entry.crossing = crossing;
+		entry.priority = priority;
+		entry.is_terminal = is_terminal;
+		entry.hit_count = 0;
+
+		//* insertion into the order of resets, after the events of the same priority
+		size_t j = event_dim;
+
+		for (; j > 0 && entries[order[j - 1]].priority < priority; --j) {
+			order[j] = order[j - 1];
+		}
+		order[j] = event_dim;
+		++event_dim;
+		return true;
+	}
+
+	//* evaluates all guards, e.g. at the initial time or after the state was changed externally
+	void
+	init(const R t, const R (&x)[X_DIM])
+	{
+		evaluate(t, x, g);
+		last_terminal_idx = EVENT_DIM;
+
+		for (size_t k = 0; k < event_dim; ++k) {
+			is_pending_arr[k] = false;
+		}
+	}
+
+	/*
+	 * Handles the crossings within the last step of the integrator from `t`, `x` to `t_next`,
+	 * `x_next`. The guards at `t`, `x` were evaluated by `init(...)` or by the last call.
+	 * Returns true if a terminal event occurred.
+	 *
+	 * 1. `integrator`: integrator that took the last step
+	 * 2. `t`: time the last step started from [s]
+	 * 3. `x`: state the last step started from
+	 * 4. `t_next`: time at the end of the step [s]
+	 * 5. `x_next`: state at the end of the step
+	 *
+	 * OUT:
+	 * 6. `t_reset`: time of the resets [s], if the function returns true or `is_reset`
+	 * 7. `x_reset`: state after the resets, if the function returns true or `is_reset`
+	 * 8. `is_reset`: true if non-terminal resets were applied, after which the step must be
+	 * restarted from `t_reset`, `x_reset` and the guards are already evaluated there
+	 */
+	template <typename Integrator_T>
+	bool
+	handle(Integrator_T &integrator, const R &t, const R (&x)[X_DIM], const R t_next,
+	       const R (&x_next)[X_DIM], R &t_reset, R (&x_reset)[X_DIM], bool &is_reset)
+	{
+		auto &instrumentation = integrator.get_instrumentation();
+		const uint64_t tick = instrumentation.start();
+		bool is_hit_arr[EVENT_DIM] = {};
+		const bool is_terminal = resolve(integrator, t, x, t_next, x_next, t_reset, x_reset,
+		                                 is_reset, is_hit_arr);
+		instrumentation.lap(Section::event, tick);
+
+		for (size_t k = 0; k < event_dim; ++k) {
+			instrumentation.count_event_check(is_hit_arr[k]);
+		}
+		return is_terminal;
+	}
+
+	//* number of events in the set
+	size_t
+	get_event_dim() const
+	{
+		return event_dim;
+	}
+
+	//* number of resets of the event `idx` since it was added
+	size_t
+	get_hit_count(const size_t idx) const
+	{
+		return entries[idx].hit_count;
+	}
+
+	//* index of the terminal event that stopped the integration, or `EVENT_DIM` if none
+	size_t
+	get_terminal_idx() const
+	{
+		return last_terminal_idx;
+	}
+
+  private:
+	struct Entry {
+		//* empty until added, since the bindings need not be default-constructible
+		std::optional<GuardBind_T> guard_fun;
+		std::optional<ResetBind_T> reset_fun;
+		Crossing crossing = Crossing::both;
+		int priority = 0;
+		bool is_terminal = false;
+		size_t hit_count = 0;
+	};
+
+	T *obj;
+	const R time_tol;
+	Entry entries[EVENT_DIM];
+	size_t order[EVENT_DIM] = {}; //* indices of the events in the order of their resets
+	size_t event_dim = 0;
+	size_t last_terminal_idx = EVENT_DIM;
+	R g[EVENT_DIM] = {}; //* guards at the start of the next step
+	bool is_pending_arr[EVENT_DIM] = {}; //* reset, the guard is evaluated on the restarted step
+	R g_cross_arr[EVENT_DIM] = {};       //* guards at the time of the reset, before the reset
+
+	/*
+	 * Handles the crossings as `handle(...)`, and marks the events that were reset in
+	 * `is_hit_arr`.
+	 */
+	template <typename Integrator_T>
+	bool
+	resolve(const Integrator_T &integrator, const R &t, const R (&x)[X_DIM], const R t_next,
+	        const R (&x_next)[X_DIM], R &t_reset, R (&x_reset)[X_DIM], bool &is_reset,
+	        bool (&is_hit_arr)[EVENT_DIM])
+	{
+		R g_next[EVENT_DIM];
+		R theta_start_arr[EVENT_DIM];
+		evaluate(t_next, x_next, g_next);
+		is_reset = false;
+
+		//* the guards of the events that were reset, on the step restarted from `t`, `x`
+		for (size_t k = 0; k < event_dim; ++k) {
+			theta_start_arr[k] = 0;
+
+			if (is_pending_arr[k]) {
+				Entry &entry = entries[k];
+				auto guard_fun = [&entry](const R t_theta,
+				                          const R(&x_theta)[X_DIM]) {
+					return (*entry.guard_fun)(t_theta, x_theta);
+				};
+				g[k] = evaluate_reset_guard(integrator, guard_fun, time_tol, t, x,
+				                            g_cross_arr[k], theta_start_arr[k]);
+				is_pending_arr[k] = false;
+			}
+		}
+
+		//* the earliest crossing, only the events whose guard changed sign are located
+		bool is_crossing_arr[EVENT_DIM] = {};
+		R t_cross_arr[EVENT_DIM] = {};
+		R t_first = t_next;
+		R x_cross[X_DIM];
+
+		for (size_t k = 0; k < event_dim; ++k) {
+			Entry &entry = entries[k];
+			is_crossing_arr[k] = is_zero_crossing(entry.crossing, g[k], g_next[k]);
+
+			if (is_crossing_arr[k]) {
+				auto guard_fun = [&entry](const R t_theta,
+				                          const R(&x_theta)[X_DIM]) {
+					return (*entry.guard_fun)(t_theta, x_theta);
+				};
+				t_cross_arr[k] = locate_zero_crossing(
+				    integrator, guard_fun, entry.crossing, time_tol, t, x,
+				    theta_start_arr[k], g[k], g_next[k], x_cross);
+				t_first = t_cross_arr[k] < t_first ? t_cross_arr[k] : t_first;
+				is_reset = true;
+			}
+		}
+
+		if (!is_reset) {
+			for (size_t k = 0; k < event_dim; ++k) {
+				g[k] = g_next[k];
+			}
+			return false;
+		}
+
+		//* the simultaneous crossings are reset at the latest of their times
+		t_reset = t_first;
+
+		for (size_t k = 0; k < event_dim; ++k) {
+			if (!is_crossing_arr[k]) {
+				continue;
+			}
+			is_crossing_arr[k] = t_cross_arr[k] <= t_first + time_tol;
+
+			if (is_crossing_arr[k] && t_cross_arr[k] > t_reset) {
+				t_reset = t_cross_arr[k];
+			}
+		}
+		const R h = integrator.get_last_step_size();
+		integrator.interpolate((t_reset - t) / h, x, x_reset);
+
+		for (size_t k = 0; k < event_dim; ++k) {
+			if (is_crossing_arr[k]) {
+				g_cross_arr[k] = (*entries[k].guard_fun)(t_reset, x_reset);
+			}
+		}
+
+		for (size_t j = 0; j < event_dim; ++j) {
+			const size_t k = order[j];
+
+			if (!is_crossing_arr[k]) {
+				continue;
+			}
+			Entry &entry = entries[k];
+			R x_plus[X_DIM];
+			(*entry.reset_fun)(t_reset, x_reset, x_plus);
+			++entry.hit_count;
+			is_hit_arr[k] = true;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_reset[i] = x_plus[i];
+			}
+
+			if (entry.is_terminal) {
+				last_terminal_idx = k;
+				is_reset = false;
+				evaluate_reset(t_reset, x_reset, is_crossing_arr, j + 1);
+				return true;
+			}
+		}
+		evaluate_reset(t_reset, x_reset, is_crossing_arr, event_dim);
+		return false;
+	}
+
+	void
+	evaluate(const R t, const R (&x)[X_DIM], R (&g_out)[EVENT_DIM])
+	{
+		for (size_t k = 0; k < event_dim; ++k) {
+			g_out[k] = (*entries[k].guard_fun)(t, x);
+		}
+	}
+
+	/*
+	 * Evaluates the guards after the resets of the first `reset_dim` events in the order of
+	 * the resets. The guards of the events that were reset are evaluated again on the
+	 * restarted step, by the next call of `handle(...)`.
+	 */
+	void
+	evaluate_reset(const R t, const R (&x)[X_DIM],
+	               const bool (&is_reset_arr)[EVENT_DIM], const size_t reset_dim)
+	{
+		evaluate(t, x, g);
+
+		for (size_t j = 0; j < reset_dim; ++j) {
+			if (is_reset_arr[order[j]]) {
+				is_pending_arr[order[j]] = true;
+			}
+		}
+	}
 };
 } // namespace rk4_solver
 #endif
\ No newline at end of file
@@ -0,0 +1,269 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef EXPLICIT_INTEGRATOR_HPP_CINARAL_261017_1935
+#define EXPLICIT_INTEGRATOR_HPP_CINARAL_261017_1935
+
+#include "binding.hpp"
+#include "matrix_op.hpp"
+#include "tableau.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <utility>
+
+namespace rk4_solver
+{
+//* index of the first nonzero weight of a tableau, which starts the weighted sum of the stages
+template <typename Tableau_T>
+constexpr size_t
+find_first_weight()
+{
+	size_t j = 0;
+
+	while (j < Tableau_T::stage_dim - 1 && Tableau_T::b[j] == 0) {
+		++j;
+	}
+	return j;
+}
+
+//* index of the first nonzero coefficient of the stage `S`, or `S` if there are none
+template <typename Tableau_T, size_t S>
+constexpr size_t
+find_first_coefficient()
+{
+	size_t j = 0;
+
+	while (j < S && Tableau_T::a[S][j] == 0) {
+		++j;
+	}
+	return j;
+}
+
+/*
+ * Explicit Runge-Kutta integrator of the method given by the Butcher tableau `Tableau_T` (see
+ * tableau.hpp). The stages are unrolled at compile time and the terms with zero coefficients are
+ * skipped, so e.g. `ExplicitIntegrator<X_DIM, T, tableau::Rk4>` does the same arithmetic as
+ * `Integrator<X_DIM, T>`.
+ */
+template <size_t X_DIM, typename T, typename Tableau_T,
+          typename Bind_T = MemberBinding<T, OdeFun_T<X_DIM, T>>>
+class ExplicitIntegrator
+{
+  public:
+	static constexpr size_t stage_dim = Tableau_T::stage_dim;
+	static constexpr size_t order = Tableau_T::order;
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	ExplicitIntegrator(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T time_step,
+	                   const Real_T t_init = 0, const Allocator &allocator = Allocator())
+	    : ode_fun(obj, ode_fun), time_step(time_step), t_init(t_init), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `ode_fun`: binding of the ODE function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	ExplicitIntegrator(Bind_T ode_fun, const Real_T time_step, const Real_T t_init = 0,
+	                   const Allocator &allocator = Allocator())
+	    : ode_fun(std::move(ode_fun)), time_step(time_step), t_init(t_init),
+	      workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+		//* local copy, since the stores to the buffers could alias the member
+		const Real_T h = time_step;
+
+		compute_stages(t, x, h, buf, std::make_index_sequence<stage_dim>());
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			Real_T sum_i = Tableau_T::b[first_weight] * buf.k[first_weight][i];
+			add_weights(i, buf, sum_i, std::make_index_sequence<stage_dim>());
+			const Real_T dx_i = h * sum_i;
+			//* compensated (Kahan) summation, ffast-math might break this
+			const Real_T compensated_dx_i = dx_i - buf.accumulator[i];
+			const Real_T x_next_i = x[i] + compensated_dx_i;
+			buf.accumulator[i] = (x_next_i - x[i]) - compensated_dx_i;
+			x_next[i] = x_next_i;
+		}
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.accumulator[i] = 0;
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	Bind_T ode_fun;
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T k[stage_dim][X_DIM];
+		alignas(cache_line_size) Real_T x_temp[X_DIM];
+		alignas(cache_line_size) Real_T accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	static constexpr size_t first_weight = find_first_weight<Tableau_T>();
+
+	template <size_t... S>
+	void
+	compute_stages(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T h, Buffers &buf,
+	               std::index_sequence<S...>)
+	{
+		(compute_stage<S>(t, x, h, buf), ...);
+	}
+
+	/*
+	 * k_S = ode_fun(t + c_S*h, x + h*(a_S0*k_0 + ... + a_S(S-1)*k_(S-1)))
+	 */
+	template <size_t S>
+	void
+	compute_stage(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T h, Buffers &buf)
+	{
+		constexpr size_t J = find_first_coefficient<Tableau_T, S>();
+		const Real_T t_stage = Tableau_T::c[S] == 0 ? t : t + Tableau_T::c[S] * h;
+
+		if constexpr (J == S) {
+			//* no terms, e.g. the first stage
+			ode_fun(t_stage, x, buf.k[S]);
+		} else {
+			constexpr Real_T a_sj = Tableau_T::a[S][J];
+			matrix_op::weighted_sum(a_sj * h, buf.k[J], 1., x, buf.x_temp);
+			add_stage_terms<S, J>(h, buf, std::make_index_sequence<S>());
+			ode_fun(t_stage, buf.x_temp, buf.k[S]);
+		}
+	}
+
+	//* x_temp += h*a_SJ*k_J for the nonzero coefficients after the first one `J_0`
+	template <size_t S, size_t J_0, size_t... J>
+	static void
+	add_stage_terms(const Real_T h, Buffers &buf, std::index_sequence<J...>)
+	{
+		(add_stage_term<S, J_0, J>(h, buf), ...);
+	}
+
+	template <size_t S, size_t J_0, size_t J>
+	static void
+	add_stage_term(const Real_T h, Buffers &buf)
+	{
+		if constexpr (J > J_0 && Tableau_T::a[S][J] != 0) {
+			matrix_op::weighted_sum(Tableau_T::a[S][J] * h, buf.k[J], 1., buf.x_temp,
+			                        buf.x_temp);
+		}
+	}
+
+	template <size_t... J>
+	static void
+	add_weights(const size_t i, const Buffers &buf, Real_T &sum_i, std::index_sequence<J...>)
+	{
+		(add_weight<J>(i, buf, sum_i), ...);
+	}
+
+	template <size_t J>
+	static void
+	add_weight(const size_t i, const Buffers &buf, Real_T &sum_i)
+	{
+		if constexpr (J > first_weight && Tableau_T::b[J] != 0) {
+			sum_i += Tableau_T::b[J] * buf.k[J][i];
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
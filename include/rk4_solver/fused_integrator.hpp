@@ -0,0 +1,232 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FUSED_INTEGRATOR_HPP_CINARAL_261017_2120
+#define FUSED_INTEGRATOR_HPP_CINARAL_261017_2120
+
+#include "binding.hpp"
+#include "simd.hpp"
+#include "summation.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace rk4_solver
+{
+/*
+ * Runge-Kutta 4th Order integrator with a stage-aware ODE function of type `StageFun_T`, which
+ * is passed the state `x`, the previous stage `k` and the coefficient `a` and computes
+ * `dt_x = f(t, x + a * k)`. The first stage is passed `k = x` and `a = 0`.
+ *
+ * `Integrator` writes each stage input `x + a * k` to a buffer, which the ODE function reads
+ * back, so a large state makes 25 passes over memory per step (in units of the state). Forming
+ * the stage input inside the ODE function makes 19, and no stage input buffer is needed. The
+ * results are the same as those of `Integrator` if the ODE function forms `x[i] + a * k[i]`.
+ */
+template <size_t X_DIM, typename T, typename Bind_T = MemberBinding<T, StageFun_T<X_DIM, T>>,
+          typename Summation_T = summation::Kahan>
+class FusedIntegrator
+{
+  public:
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `stage_fun`: stage-aware ODE function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	FusedIntegrator(T &obj, StageFun_T<X_DIM, T> stage_fun, const Real_T time_step,
+	                const Real_T t_init = 0, const Allocator &allocator = Allocator())
+	    : stage_fun(obj, stage_fun), time_step(time_step), t_init(t_init), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `stage_fun`: binding of the stage-aware ODE function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	FusedIntegrator(Bind_T stage_fun, const Real_T time_step, const Real_T t_init = 0,
+	                const Allocator &allocator = Allocator())
+	    : stage_fun(std::move(stage_fun)), time_step(time_step), t_init(t_init),
+	      workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next Runge-Kutta 4th Order step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+		const Real_T h = time_step;
+
+		//* reads x, writes k_0
+		stage_fun(t, x, x, 0, buf.k_0);
+		//* reads x and k_(j-1), writes k_j
+		stage_fun(t + h / 2, x, buf.k_0, h / 2, buf.k_1);
+		stage_fun(t + h / 2, x, buf.k_1, h / 2, buf.k_2);
+		stage_fun(t + h, x, buf.k_2, h, buf.k_3);
+		//* reads x, k_0...k_3 and the accumulator, writes x_next and the accumulator
+		update(x, h, buf, x_next);
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			Summation_T::reset(buf.accumulator[i]);
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	Bind_T stage_fun;
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter;
+
+	struct Buffers;
+
+	//* x_next = x + h * (k_0 + 2 * k_1 + 2 * k_2 + k_3) / 6, added by the summation policy
+	static void
+	update(const Real_T (&x)[X_DIM], const Real_T h, Buffers &buf, Real_T (&x_next)[X_DIM])
+	{
+		if constexpr (X_DIM >= simd::min_dim && simd::is_vectorized<Real_T> &&
+		              std::is_same<Summation_T, summation::Kahan>::value) {
+			if (simd::get_isa() != simd::Isa::scalar) {
+				static_assert(sizeof(buf.accumulator) == sizeof(Real_T[X_DIM]),
+				              "the compensations must be contiguous");
+				Real_T *c = reinterpret_cast<Real_T *>(buf.accumulator);
+				simd::kahan_update(X_DIM, x, h, buf.k_0, buf.k_1, buf.k_2,
+				                   buf.k_3, c, x_next);
+				return;
+			}
+		}
+		constexpr Real_T w0 = 1. / 6.;
+		constexpr Real_T w1 = 1. / 3.;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const Real_T dx_i = h * (w0 * buf.k_0[i] + w1 * buf.k_1[i] +
+			                         w1 * buf.k_2[i] + w0 * buf.k_3[i]);
+			x_next[i] = Summation_T::add(x[i], dx_i, buf.accumulator[i]);
+		}
+	}
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T k_0[X_DIM];
+		alignas(cache_line_size) Real_T k_1[X_DIM];
+		alignas(cache_line_size) Real_T k_2[X_DIM];
+		alignas(cache_line_size) Real_T k_3[X_DIM];
+		alignas(cache_line_size) typename Summation_T::template Accumulator<Real_T>
+		    accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+};
+
+/*
+ * Creates a fused integrator that calls the stage-aware member function `FUN` which is known at
+ * compile time, e.g. `make_fused_integrator<&Dynamics::stage_fun>(dynamics, time_step)`.
+ */
+template <auto FUN, typename Summation_T = summation::Kahan,
+          typename T = typename StageFunTraits<decltype(FUN)>::Class_T,
+          size_t X_DIM = StageFunTraits<decltype(FUN)>::x_dim>
+FusedIntegrator<X_DIM, T, StaticMemberBinding<FUN>, Summation_T>
+make_fused_integrator(T &obj, const Real_T time_step, const Real_T t_init = 0,
+                      const Allocator &allocator = Allocator())
+{
+	return {StaticMemberBinding<FUN>(obj), time_step, t_init, allocator};
+}
+
+/*
+ * Creates a fused integrator that calls a lambda, a functor or a free function with the signature
+ * `void(const Real_T t, const Real_T (&x)[X_DIM], const Real_T (&k)[X_DIM], const Real_T a,
+ * Real_T (&dt_x)[X_DIM])`.
+ */
+template <size_t X_DIM, typename Summation_T = summation::Kahan, typename F>
+FusedIntegrator<X_DIM, CallableBinding<F>, CallableBinding<F>, Summation_T>
+make_fused_integrator(F fun, const Real_T time_step, const Real_T t_init = 0,
+                      const Allocator &allocator = Allocator())
+{
+	return {CallableBinding<F>(std::move(fun)), time_step, t_init, allocator};
+}
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INSTRUMENTATION_HPP_CINARAL_261017_1410
+#define INSTRUMENTATION_HPP_CINARAL_261017_1410
+
+#include "types.hpp"
+#include "workspace.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace rk4_solver
+{
+//* sections of the hot path whose time is recorded by `Instrumentation<true>`
+enum class Section : size_t {
+	ode_fun, //* the ODE function
+	stage,   //* the stage sums and the update of the integrator
+	event,   //* the event function
+	count
+};
+constexpr size_t section_dim = static_cast<size_t>(Section::count);
+
+/*
+ * Counters of an instrumented integrator and event since the last reset.
+ */
+struct InstrumentationSnapshot {
+	uint64_t step_count = 0;
+	uint64_t ode_fun_count = 0;
+	uint64_t event_check_count = 0;
+	uint64_t event_hit_count = 0;
+	uint64_t ticks[section_dim] = {}; //* ticks of `read_cycle_counter()` spent in each section
+
+	uint64_t
+	get_ticks(const Section section) const
+	{
+		return ticks[static_cast<size_t>(section)];
+	}
+};
+
+//* time stamp counter on x86, otherwise the steady clock in nanoseconds
+inline uint64_t
+read_cycle_counter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+#endif
+}
+
+/*
+ * Default instrumentation policy of `Integrator` and `Event`, which does nothing and is optimized
+ * away entirely.
+ */
+struct NoInstrumentation {
+	void
+	count_step()
+	{
+	}
+
+	void
+	count_ode_fun(const size_t = 1)
+	{
+	}
+
+	void
+	count_event_check(const bool)
+	{
+	}
+
+	uint64_t
+	start() const
+	{
+		return 0;
+	}
+
+	uint64_t
+	lap(const Section, const uint64_t)
+	{
+		return 0;
+	}
+
+	//* shared by all uninstrumented events, which do not need an instance
+	static NoInstrumentation &
+	get_default()
+	{
+		static NoInstrumentation instrumentation;
+		return instrumentation;
+	}
+};
+
+/*
+ * Instrumentation policy that counts the steps, the ODE function evaluations, the event checks
+ * and the event hits, and if `IS_TIMED`, records the ticks of `read_cycle_counter()` spent in each
+ * `Section` of the hot path.
+ *
+ * The counters are written by the thread that integrates, and `snapshot()` and `reset()` can be
+ * called from any other thread. The counters are updated with relaxed loads and stores instead of
+ * atomic read-modify-write operations, which is only correct with a single writer, so an
+ * instrumentation must not be shared by integrators on different threads. Each counter is read
+ * atomically, but not at the same instant as the others.
+ */
+template <bool IS_TIMED = false> class Instrumentation
+{
+  public:
+	Instrumentation()
+	{
+		for (size_t i = 0; i < counter_dim; ++i) {
+			counters[i].store(0, std::memory_order_relaxed);
+			offsets[i] = 0;
+		}
+	}
+
+	Instrumentation(const Instrumentation &) = delete;
+	Instrumentation &operator=(const Instrumentation &) = delete;
+
+	void
+	count_step()
+	{
+		increment(step_idx, 1);
+	}
+
+	void
+	count_ode_fun(const size_t count = 1)
+	{
+		increment(ode_fun_idx, count);
+	}
+
+	void
+	count_event_check(const bool is_hit)
+	{
+		increment(event_check_idx, 1);
+		increment(event_hit_idx, is_hit);
+	}
+
+	//* starts timing a section
+	uint64_t
+	start() const
+	{
+		return IS_TIMED ? read_cycle_counter() : 0;
+	}
+
+	/*
+	 * Adds the ticks since `since` to `section` and returns the current tick, which starts
+	 * the next section.
+	 */
+	uint64_t
+	lap(const Section section, const uint64_t since)
+	{
+		if (!IS_TIMED) {
+			return 0;
+		}
+		const uint64_t now = read_cycle_counter();
+		increment(tick_idx + static_cast<size_t>(section), now - since);
+		return now;
+	}
+
+	//* counters since the last `reset()`
+	InstrumentationSnapshot
+	snapshot() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		uint64_t values[counter_dim];
+
+		for (size_t i = 0; i < counter_dim; ++i) {
+			values[i] = counters[i].load(std::memory_order_relaxed) - offsets[i];
+		}
+		InstrumentationSnapshot snapshot;
+		snapshot.step_count = values[step_idx];
+		snapshot.ode_fun_count = values[ode_fun_idx];
+		snapshot.event_check_count = values[event_check_idx];
+		snapshot.event_hit_count = values[event_hit_idx];
+
+		for (size_t i = 0; i < section_dim; ++i) {
+			snapshot.ticks[i] = values[tick_idx + i];
+		}
+		return snapshot;
+	}
+
+	/*
+	 * Restarts the counters from zero. The counters themselves are never written by the
+	 * reader, instead their current values are subtracted from the later snapshots.
+	 */
+	void
+	reset()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (size_t i = 0; i < counter_dim; ++i) {
+			offsets[i] = counters[i].load(std::memory_order_relaxed);
+		}
+	}
+
+  private:
+	static constexpr size_t step_idx = 0;
+	static constexpr size_t ode_fun_idx = 1;
+	static constexpr size_t event_check_idx = 2;
+	static constexpr size_t event_hit_idx = 3;
+	static constexpr size_t tick_idx = 4;
+	static constexpr size_t counter_dim = tick_idx + section_dim;
+
+	void
+	increment(const size_t idx, const uint64_t count)
+	{
+		std::atomic<uint64_t> &counter = counters[idx];
+		counter.store(counter.load(std::memory_order_relaxed) + count,
+		              std::memory_order_relaxed);
+	}
+
+	//* the counters of the writer are on their own cache line
+	alignas(cache_line_size) std::atomic<uint64_t> counters[counter_dim];
+	alignas(cache_line_size) uint64_t offsets[counter_dim];
+	mutable std::mutex mutex;
+};
+} // namespace rk4_solver
+
+#endif
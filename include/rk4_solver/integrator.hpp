@@ -29,16 +29,61 @@
 
 #include "matrix_op.hpp"
 #include "matrix_op/row_operations.hpp"
+#include "binding.hpp"
+#include "instrumentation.hpp"
+#include "simd.hpp"
+#include "summation.hpp"
 #include "types.hpp"
+#include "workspace.hpp"
 
 namespace rk4_solver
 {
-template <size_t X_DIM, typename T> class Integrator
+/*
+ * Runge-Kutta 4th Order integrator. The ODE function is called through the binding `Bind_T` (see
+ * binding.hpp), which by default calls a member function of `T` through a pointer. Use
+ * `make_integrator(...)` to bind a member function at compile time or a callable, so that it can
+ * be inlined. The instrumentation policy `Instrument_T` (see instrumentation.hpp) counts the
+ * steps and the ODE function evaluations, and does nothing by default. The summation policy
+ * `Summation_T` (see summation.hpp) adds the increment of a step to the state. The scalar type
+ * `R` of the time and the state is `Real_T` by default, and the default binding calls a member
+ * function of that scalar type, e.g. `Integrator<X_DIM, T, float>`.
+ */
+template <size_t X_DIM, typename T, typename R = Real_T,
+          typename Bind_T = MemberBinding<T, OdeFun_T<X_DIM, T, R>>,
+          typename Instrument_T = NoInstrumentation, typename Summation_T = summation::Kahan>
+class Integrator
 {
   public:
-	Integrator(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T time_step,
-	           const Real_T t_init = 0)
-	    : obj(obj), ode_fun(ode_fun), time_step(time_step), t_init(t_init)
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	Integrator(T &obj, OdeFun_T<X_DIM, T, R> ode_fun, const R time_step,
+	           const R t_init = 0, const Allocator &allocator = Allocator())
+	    : ode_fun(obj, ode_fun), time_step(time_step), t_init(t_init), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `ode_fun`: binding of the ODE function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	Integrator(Bind_T ode_fun, const R time_step, const R t_init = 0,
+	           const Allocator &allocator = Allocator())
+	    : ode_fun(std::move(ode_fun)), time_step(time_step), t_init(t_init),
+	      workspace(allocator)
 	{
 		reset();
 	}
@@ -55,38 +100,86 @@ template <size_t X_DIM, typename T> class Integrator
 	 * 4. `x_next`: next_state
 	 */
 	void
-	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	step(const R &t, const R (&x)[X_DIM], R &t_next, R (&x_next)[X_DIM])
 	{
-		//* ode_fun(ti, xi)
-		(obj.*ode_fun)(t, x, k_0);
+		if (!is_good()) { //* hold the state
+			t_next = t;
 
-		//* zero-order hold, i.e. no ODE_FUN(,, i+.5), ODE_FUN(,, i+1,) etc.
-		//* ode_fun(ti + h/2, xi + h/2*k_0)
-		matrix_op::weighted_sum(time_step / 2, k_0, 1., x, x_temp);
-		(obj.*ode_fun)(t + time_step / 2, x_temp, k_1);
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		step_by(t, x, time_step, x_next);
 
-		//* ode_fun(ti + h/2, xi + h/2*k_1)
-		matrix_op::weighted_sum(time_step / 2, k_1, 1., x, x_temp);
-		(obj.*ode_fun)(t + time_step / 2, x_temp, k_2);
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+		instrumentation.count_step();
+	}
 
-		//* ode_fun(ti + h, xi + k_2)
-		matrix_op::weighted_sum(time_step, k_2, 1., x, x_temp);
-		(obj.*ode_fun)(t + time_step, x_temp, k_3);
+	/*
+	 * Computes a Runge-Kutta 4th Order step of size `h` which is not counted as a step, e.g. to
+	 * restart from an event back onto the time grid.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 * 3. `h`: step size [s]
+	 *
+	 * OUT:
+	 * 4. `x_next`: state at `t + h`
+	 */
+	void
+	partial_step(const R &t, const R (&x)[X_DIM], const R h,
+	             R (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		step_by(t, x, h, x_next);
+	}
+
+	/*
+	 * Interpolates the last step using its stages (dense output). The interpolant is 3rd order
+	 * accurate and matches the step at both ends.
+	 *
+	 * 1. `theta`: fraction of the last step, from 0 to 1
+	 * 2. `x`: state the last step started from
+	 *
+	 * OUT:
+	 * 3. `x_theta`: state at `t + theta * h`
+	 */
+	void
+	interpolate(const R theta, const R (&x)[X_DIM], R (&x_theta)[X_DIM]) const
+	{
+		if (!is_good()) { //* hold the state
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_theta[i] = x[i];
+			}
+			return;
+		}
+		const Buffers &buf = workspace.get();
 
-		constexpr Real_T w0 = 1. / 6.;
-		constexpr Real_T w1 = 1. / 3.;
+		const R theta_sq = theta * theta;
+		const R theta_cb = theta_sq * theta;
+		const R b0 = theta - 3 * theta_sq / 2 + 2 * theta_cb / 3;
+		const R b1 = theta_sq - 2 * theta_cb / 3;
+		const R b3 = -theta_sq / 2 + 2 * theta_cb / 3;
 
 		for (size_t i = 0; i < X_DIM; ++i) {
-			dx_i = time_step * (w0 * k_0[i] + w1 * k_1[i] + w1 * k_2[i] + w0 * k_3[i]);
-			//* compensated (Kahan) summation, ffast-math might break this
-			compensated_dx_i = dx_i - accumulator[i];
-			x_temp[i] = x[i] + compensated_dx_i;
-			accumulator[i] = (x_temp[i] - x[i]) - compensated_dx_i;
-			x_next[i] = x_temp[i];
+			const R k_12_i = buf.k_1[i] + buf.k_2[i];
+			x_theta[i] =
+			    x[i] + last_step * (b0 * buf.k_0[i] + b1 * k_12_i + b3 * buf.k_3[i]);
 		}
+	}
 
-		t_next = t_init + (step_counter + 1) * time_step;
-		++step_counter;
+	//* size of the last step [s]
+	R
+	get_last_step_size() const
+	{
+		return last_step;
 	}
 
 	void
@@ -94,12 +187,24 @@ template <size_t X_DIM, typename T> class Integrator
 	{
 		step_counter = 0;
 
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
 		for (size_t i = 0; i < X_DIM; ++i) {
-			accumulator[i] = 0;
+			Summation_T::reset(buf.accumulator[i]);
 		}
 	}
 
-	Real_T
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	R
 	get_step_size() const
 	{
 		return time_step;
@@ -111,35 +216,148 @@ template <size_t X_DIM, typename T> class Integrator
 		return step_counter;
 	}
 
+	Instrument_T &
+	get_instrumentation()
+	{
+		return instrumentation;
+	}
+
+	const Instrument_T &
+	get_instrumentation() const
+	{
+		return instrumentation;
+	}
+
   private:
-	T &obj;
-	const OdeFun_T<X_DIM, T> ode_fun;
-	const Real_T time_step;
-	const Real_T t_init;
+	Bind_T ode_fun;
+	const R time_step;
+	const R t_init;
 	size_t step_counter;
-	Real_T dx_i;
-	Real_T compensated_dx_i;
-
-#ifdef DO_NOT_USE_HEAP
-	Real_T k_0[X_DIM];
-	Real_T k_1[X_DIM];
-	Real_T k_2[X_DIM];
-	Real_T k_3[X_DIM];
-	Real_T x_temp[X_DIM];
-	Real_T accumulator[X_DIM];
-#else
-	/*
-	 * Dereferencing pointers that point to `Real_T[X_DIM]`s which are allocated on the heap, in
-	 * order to get rvalue references to the `Real_T[X_DIM]`s.
-	 */
-	Real_T (&k_0)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-	Real_T (&k_1)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-	Real_T (&k_2)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-	Real_T (&k_3)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-	Real_T (&x_temp)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-	Real_T (&accumulator)[X_DIM] = *(Real_T(*)[X_DIM]) new Real_T[X_DIM];
-#endif
+	R last_step = 0;
+	Instrument_T instrumentation;
+
+	void
+	step_by(const R &t, const R (&x)[X_DIM], const R h, R (&x_next)[X_DIM])
+	{
+		Buffers &buf = workspace.get();
+		uint64_t tick = instrumentation.start();
+
+		//* ode_fun(ti, xi)
+		ode_fun(t, x, buf.k_0);
+		tick = instrumentation.lap(Section::ode_fun, tick);
+
+		//* zero-order hold, i.e. no ODE_FUN(,, i+.5), ODE_FUN(,, i+1,) etc.
+		//* ode_fun(ti + h/2, xi + h/2*k_0)
+		stage_input(x, h / 2, buf.k_0, buf.x_temp);
+		tick = instrumentation.lap(Section::stage, tick);
+		ode_fun(t + h / 2, buf.x_temp, buf.k_1);
+		tick = instrumentation.lap(Section::ode_fun, tick);
+
+		//* ode_fun(ti + h/2, xi + h/2*k_1)
+		stage_input(x, h / 2, buf.k_1, buf.x_temp);
+		tick = instrumentation.lap(Section::stage, tick);
+		ode_fun(t + h / 2, buf.x_temp, buf.k_2);
+		tick = instrumentation.lap(Section::ode_fun, tick);
+
+		//* ode_fun(ti + h, xi + k_2)
+		stage_input(x, h, buf.k_2, buf.x_temp);
+		tick = instrumentation.lap(Section::stage, tick);
+		ode_fun(t + h, buf.x_temp, buf.k_3);
+		tick = instrumentation.lap(Section::ode_fun, tick);
+
+		update(x, h, buf, x_next);
+		last_step = h;
+		instrumentation.lap(Section::stage, tick);
+		instrumentation.count_ode_fun(4);
+	}
+
+	//* the stages of larger systems use the vectorized kernels of simd.hpp
+	static constexpr bool is_vectorized = X_DIM >= simd::min_dim && simd::is_vectorized<R>;
+
+	//* x_stage = x + a * k
+	static void
+	stage_input(const R (&x)[X_DIM], const R a, const R (&k)[X_DIM], R (&x_stage)[X_DIM])
+	{
+		if constexpr (is_vectorized) {
+			if (simd::get_isa() != simd::Isa::scalar) {
+				simd::stage_input(X_DIM, x, a, k, x_stage);
+				return;
+			}
+		}
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			x_stage[i] = a * k[i] + x[i];
+		}
+	}
+
+	struct Buffers;
+
+	//* x_next = x + h * (k_0 + 2 * k_1 + 2 * k_2 + k_3) / 6, added by the summation policy
+	static void
+	update(const R (&x)[X_DIM], const R h, Buffers &buf, R (&x_next)[X_DIM])
+	{
+		if constexpr (is_vectorized && std::is_same<Summation_T, summation::Kahan>::value) {
+			if (simd::get_isa() != simd::Isa::scalar) {
+				static_assert(sizeof(buf.accumulator) == sizeof(R[X_DIM]),
+				              "the compensations must be contiguous");
+				R *c = reinterpret_cast<R *>(buf.accumulator);
+				simd::kahan_update(X_DIM, x, h, buf.k_0, buf.k_1, buf.k_2, buf.k_3,
+				                   c, x_next);
+				return;
+			}
+		}
+		constexpr R w0 = 1. / 6.;
+		constexpr R w1 = 1. / 3.;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const R dx_i = h * (w0 * buf.k_0[i] + w1 * buf.k_1[i] + w1 * buf.k_2[i] +
+			                    w0 * buf.k_3[i]);
+			x_next[i] = Summation_T::add(x[i], dx_i, buf.accumulator[i]);
+		}
+	}
+
+	struct Buffers {
+		alignas(cache_line_size) R k_0[X_DIM];
+		alignas(cache_line_size) R k_1[X_DIM];
+		alignas(cache_line_size) R k_2[X_DIM];
+		alignas(cache_line_size) R k_3[X_DIM];
+		alignas(cache_line_size) R x_temp[X_DIM];
+		alignas(cache_line_size) typename Summation_T::template Accumulator<R>
+		    accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
 };
+
+/*
+ * Creates an integrator that calls the member function `FUN` which is known at compile time, e.g.
+ * `make_integrator<&Dynamics::ode_fun>(dynamics, time_step)`.
+ */
+template <auto FUN, typename Instrument_T = NoInstrumentation,
+          typename Summation_T = summation::Kahan,
+          typename T = typename OdeFunTraits<decltype(FUN)>::Class_T,
+          size_t X_DIM = OdeFunTraits<decltype(FUN)>::x_dim,
+          typename R = typename OdeFunTraits<decltype(FUN)>::Value_T>
+Integrator<X_DIM, T, R, StaticMemberBinding<FUN>, Instrument_T, Summation_T>
+make_integrator(T &obj, const NonDeduced_T<R> time_step, const NonDeduced_T<R> t_init = 0,
+                const Allocator &allocator = Allocator())
+{
+	return {StaticMemberBinding<FUN>(obj), time_step, t_init, allocator};
+}
+
+/*
+ * Creates an integrator that calls a lambda, a functor or a free function with the signature
+ * `void(const R t, const R (&x)[X_DIM], R (&dt_x)[X_DIM])`, e.g.
+ * `make_integrator<x_dim>([](auto t, auto &x, auto &dt_x) { ... }, time_step)`. The binding is
+ * also used as the class `T` of the integrator, since `F` need not be a class.
+ */
+template <size_t X_DIM, typename R = Real_T, typename Instrument_T = NoInstrumentation,
+          typename Summation_T = summation::Kahan, typename F>
+Integrator<X_DIM, CallableBinding<F>, R, CallableBinding<F>, Instrument_T, Summation_T>
+make_integrator(F fun, const NonDeduced_T<R> time_step, const NonDeduced_T<R> t_init = 0,
+                const Allocator &allocator = Allocator())
+{
+	return {CallableBinding<F>(std::move(fun)), time_step, t_init, allocator};
+}
 } // namespace rk4_solver
 
 #endif
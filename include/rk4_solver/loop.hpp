@@ -27,9 +27,22 @@
 #ifndef LOOP_HPP_CINARAL_220924_1755
 #define LOOP_HPP_CINARAL_220924_1755
 
+#include "adaptive_integrator.hpp"
+#include "async_sink.hpp"
+#include "batch_integrator.hpp"
+#include "binding.hpp"
+#include "dynamic_integrator.hpp"
 #include "event.hpp"
+#include "explicit_integrator.hpp"
+#include "fused_integrator.hpp"
 #include "integrator.hpp"
+#include "lti_integrator.hpp"
 #include "matrix_op.hpp"
+#include "multistep_integrator.hpp"
+#include "parallel_integrator.hpp"
+#include "rosenbrock_integrator.hpp"
+#include "sink.hpp"
+#include "symplectic_integrator.hpp"
 #include "types.hpp"
 
 namespace rk4_solver
@@ -45,11 +58,13 @@ namespace rk4_solver
  * 4. `t`: final time [s]
  * 5. `x`: final state
  */
-template <size_t T_DIM, size_t X_DIM, typename T>
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R>
 void
-loop(Integrator<X_DIM, T> integrator, const Real_T &t_init, const Real_T (&x_init)[X_DIM],
-     Real_T &t, Real_T (&x)[X_DIM])
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], R &t, R (&x)[X_DIM])
 {
+	integrator.reset(); //* start from the first step
 	t = t_init; //* initialize t
 
 	for (size_t i = 0; i < X_DIM; ++i) {
@@ -72,11 +87,192 @@ loop(Integrator<X_DIM, T> integrator, const Real_T &t_init, const Real_T (&x_ini
  * 4. `t_arr`: time history
  * 5. `x_arr`: state history
  */
-template <size_t T_DIM, size_t X_DIM, typename T>
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R>
+void
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], R (&t_arr)[T_DIM],
+     R (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t j = 0; j < X_DIM; ++j) {
+		x_arr[0][j] = x_init[j]; //* initialize x
+	}
+
+	R t_next;
+	R x_next[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const R t = t_arr[i];
+		const R(&x)[X_DIM] = x_arr[i];
+		integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+		t_arr[i + 1] = t_next;
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			x_arr[i + 1][j] = x_next[j];
+		}
+	}
+}
+
+/*
+ * Loops the fused Runge-Kutta 4th Order step `T_DIM` times.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Summation_T>
+void
+loop(FusedIntegrator<X_DIM, T, Bind_T, Summation_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops the fused Runge-Kutta 4th Order step `T_DIM` times and cumulatively saves the results
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Summation_T>
+void
+loop(FusedIntegrator<X_DIM, T, Bind_T, Summation_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t j = 0; j < X_DIM; ++j) {
+		x_arr[0][j] = x_init[j]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t_arr[i], x_arr[i], t_arr[i + 1], x_arr[i + 1]);
+	}
+}
+
+/*
+ * Loops the parallel Runge-Kutta 4th Order step `T_DIM` times.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Summation_T>
+void
+loop(ParallelIntegrator<X_DIM, T, Bind_T, Summation_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops the parallel Runge-Kutta 4th Order step `T_DIM` times and cumulatively saves the results
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Summation_T>
+void
+loop(ParallelIntegrator<X_DIM, T, Bind_T, Summation_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t j = 0; j < X_DIM; ++j) {
+		x_arr[0][j] = x_init[j]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t_arr[i], x_arr[i], t_arr[i + 1], x_arr[i + 1]);
+	}
+}
+
+/*
+ * Loops the explicit Runge-Kutta step `T_DIM` times.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Tableau_T, typename Bind_T>
+void
+loop(ExplicitIntegrator<X_DIM, T, Tableau_T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops the explicit Runge-Kutta step `T_DIM` times and cumulatively saves the results
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Tableau_T, typename Bind_T>
 void
-loop(Integrator<X_DIM, T> integrator, const Real_T &t_init, const Real_T (&x_init)[X_DIM],
-     Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+loop(ExplicitIntegrator<X_DIM, T, Tableau_T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
 {
+	integrator.reset(); //* start from the first step
 	t_arr[0] = t_init;                               //* initialize t
 	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
 
@@ -93,90 +289,1140 @@ loop(Integrator<X_DIM, T> integrator, const Real_T &t_init, const Real_T (&x_ini
 }
 
 /*
- * Loops Runge-Kutta 4th Order step `T_DIM` times or until event_fun returns true.
- * `event_fun` can be used to modify x when certain conditions are met.
+ * Loops the linear time-invariant step `T_DIM` times with a constant input.
  *
  * 1. `integrator`: integrator object
- * 2. `integrator`: event object
- * 3. `t_init`: initial time [s]
- * 4. `x_init`: initial state
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `u`: input
  *
  * OUT:
- * 5. `t`: final time
+ * 5. `t`: final time [s]
  * 6. `x`: final state
  */
-template <size_t T_DIM, size_t X_DIM, typename T>
-size_t
-loop(Integrator<X_DIM, T> integrator, Event<X_DIM, T> event, const Real_T &t_init,
-     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM], bool halt_on_event = false)
+template <size_t T_DIM, size_t X_DIM, size_t U_DIM>
+void
+loop(LtiIntegrator<X_DIM, U_DIM> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], const Real_T (&u)[U_DIM], Real_T &t, Real_T (&x)[X_DIM])
 {
+	integrator.reset(); //* start from the first step
 	t = t_init; //* initialize t
 
 	for (size_t i = 0; i < X_DIM; ++i) {
 		x[i] = x_init[i]; //* initialize x
 	}
-	Real_T x_plus[X_DIM];
 
 	for (size_t i = 0; i < T_DIM - 1; ++i) {
-		if (event.check(t, x, x_plus)) {
-			for (size_t j = 0; j < X_DIM; ++j) {
-				x[j] = x_plus[j];
-			}
-
-			if (halt_on_event) {
-				break;
-			}
-		}
-		integrator.step(t, x, t, x); //* update t, x to the next t, x
+		integrator.step(t, x, u, t, x); //* update t, x to the next t, x
 	}
-	return integrator.get_step_count();
 }
 
 /*
- * Loops Runge-Kutta 4th Order step `T_DIM` times or until event_fun returns true and cumulatively
- * saves all points. `event_fun` can be used to modify x when certain conditions are met.
+ * Loops the linear time-invariant step `T_DIM` times and cumulatively saves the results. The
+ * input `u_arr[i]` is held over the step from `t_arr[i]`, the last input is not used.
  *
  * 1. `integrator`: integrator object
- * 2. `integrator`: event object
- * 3. `t_init`: initial time [s]
- * 4. `x_init`: initial state
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `u_arr`: input history
  *
  * OUT:
  * 5. `t_arr`: time history
  * 6. `x_arr`: state history
  */
-template <size_t T_DIM, size_t X_DIM, typename T>
-size_t
-loop(Integrator<X_DIM, T> integrator, Event<X_DIM, T> event, const Real_T &t_init,
-     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM],
-     bool halt_on_event = false)
+template <size_t T_DIM, size_t X_DIM, size_t U_DIM>
+void
+loop(LtiIntegrator<X_DIM, U_DIM> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], const Real_T (&u_arr)[T_DIM][U_DIM], Real_T (&t_arr)[T_DIM],
+     Real_T (&x_arr)[T_DIM][X_DIM])
 {
+	integrator.reset(); //* start from the first step
 	t_arr[0] = t_init;                               //* initialize t
 	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+
 	Real_T t_next;
 	Real_T x_next[X_DIM];
-	Real_T x_plus[X_DIM];
 
 	for (size_t i = 0; i < T_DIM - 1; ++i) {
 		const Real_T t = t_arr[i];
 		const Real_T(&x)[X_DIM] = x_arr[i];
+		integrator.step(t, x, u_arr[i], t_next, x_next); //* update t, x to the next t, x
+		t_arr[i + 1] = t_next;
+		matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+	}
+}
 
-		if (event.check(t, x, x_plus)) {
-			integrator.step(t, x_plus, t_next, x_next);
-			t_arr[i + 1] = t_next;
-			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+/*
+ * Loops the Rosenbrock step `T_DIM` times or until a step fails
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ * false if a step failed, `t` and `x` are then the last computed time and state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T>
+bool
+loop(RosenbrockIntegrator<X_DIM, T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
 
-			if (halt_on_event) {
-				break;
-			}
-		} else {
-			integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
-			t_arr[i + 1] = t_next;
-			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (!integrator.step(t, x, t, x)) { //* update t, x to the next t, x
+			return false;
 		}
 	}
-	return integrator.get_step_count();
+	return true;
 }
 
-} // namespace rk4_solver
+/*
+ * Loops the Rosenbrock step `T_DIM` times and cumulatively saves the results, or until a step
+ * fails
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ * false if a step failed, the history after the last computed step is then not modified
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T>
+bool
+loop(RosenbrockIntegrator<X_DIM, T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+
+	Real_T t_next;
+	Real_T x_next[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const Real_T t = t_arr[i];
+		const Real_T(&x)[X_DIM] = x_arr[i];
+
+		if (!integrator.step(t, x, t_next, x_next)) { //* update t, x to the next t, x
+			return false;
+		}
+		t_arr[i + 1] = t_next;
+		matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+	}
+	return true;
+}
+
+/*
+ * Loops the symplectic step `T_DIM` times
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state, `[q; v]`
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ */
+template <size_t T_DIM, size_t Q_DIM, typename T, typename Method_T, typename Bind_T>
+void
+loop(SymplecticIntegrator<Q_DIM, T, Method_T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[2 * Q_DIM], Real_T &t, Real_T (&x)[2 * Q_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < 2 * Q_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops the symplectic step `T_DIM` times and cumulatively saves the results
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state, `[q; v]`
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t Q_DIM, typename T, typename Method_T, typename Bind_T>
+void
+loop(SymplecticIntegrator<Q_DIM, T, Method_T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[2 * Q_DIM], Real_T (&t_arr)[T_DIM],
+     Real_T (&x_arr)[T_DIM][2 * Q_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+
+	Real_T t_next;
+	Real_T x_next[2 * Q_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const Real_T t = t_arr[i];
+		const Real_T(&x)[2 * Q_DIM] = x_arr[i];
+		integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+		t_arr[i + 1] = t_next;
+		matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+	}
+}
+
+/*
+ * Loops the symplectic step `T_DIM` times or until event_fun returns true. `event_fun` can be
+ * used to modify x when certain conditions are met.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state, `[q; v]`
+ *
+ * OUT:
+ * 5. `t`: final time
+ * 6. `x`: final state
+ */
+template <size_t T_DIM, size_t Q_DIM, typename T, typename Method_T, typename Bind_T,
+          typename U, typename EventBind_T, typename EventInstrument_T>
+size_t
+loop(SymplecticIntegrator<Q_DIM, T, Method_T, Bind_T> &integrator,
+     Event<2 * Q_DIM, U, Real_T, EventBind_T, EventInstrument_T> event, const Real_T &t_init,
+     const Real_T (&x_init)[2 * Q_DIM], Real_T &t, Real_T (&x)[2 * Q_DIM],
+     bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < 2 * Q_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	Real_T x_plus[2 * Q_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (event.check(t, x, x_plus)) {
+			for (size_t j = 0; j < 2 * Q_DIM; ++j) {
+				x[j] = x_plus[j];
+			}
+
+			if (halt_on_event) {
+				break;
+			}
+		}
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops the symplectic step `T_DIM` times or until event_fun returns true and cumulatively saves
+ * all points. `event_fun` can be used to modify x when certain conditions are met.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state, `[q; v]`
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t Q_DIM, typename T, typename Method_T, typename Bind_T,
+          typename U, typename EventBind_T, typename EventInstrument_T>
+size_t
+loop(SymplecticIntegrator<Q_DIM, T, Method_T, Bind_T> &integrator,
+     Event<2 * Q_DIM, U, Real_T, EventBind_T, EventInstrument_T> event, const Real_T &t_init,
+     const Real_T (&x_init)[2 * Q_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][2 * Q_DIM],
+     bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+	Real_T t_next;
+	Real_T x_next[2 * Q_DIM];
+	Real_T x_plus[2 * Q_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const Real_T t = t_arr[i];
+		const Real_T(&x)[2 * Q_DIM] = x_arr[i];
+
+		if (event.check(t, x, x_plus)) {
+			integrator.step(t, x_plus, t_next, x_next);
+			t_arr[i + 1] = t_next;
+			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+
+			if (halt_on_event) {
+				break;
+			}
+		} else {
+			integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+			t_arr[i + 1] = t_next;
+			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops the multistep step `T_DIM` times
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T>
+void
+loop(MultistepIntegrator<X_DIM, T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops the multistep step `T_DIM` times and cumulatively saves the results
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T>
+void
+loop(MultistepIntegrator<X_DIM, T, Bind_T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+
+	Real_T t_next;
+	Real_T x_next[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const Real_T t = t_arr[i];
+		const Real_T(&x)[X_DIM] = x_arr[i];
+		integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+		t_arr[i + 1] = t_next;
+		matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+	}
+}
+
+/*
+ * Loops the multistep step `T_DIM` times or until event_fun returns true. `event_fun` can be
+ * used to modify x when certain conditions are met, the integrator then restarts.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t`: final time
+ * 6. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename U,
+          typename EventBind_T, typename EventInstrument_T>
+size_t
+loop(MultistepIntegrator<X_DIM, T, Bind_T> &integrator,
+     Event<X_DIM, U, Real_T, EventBind_T, EventInstrument_T> event, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T &t, Real_T (&x)[X_DIM], bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	Real_T x_plus[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (event.check(t, x, x_plus)) {
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x[j] = x_plus[j];
+			}
+
+			if (halt_on_event) {
+				break;
+			}
+		}
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops the multistep step `T_DIM` times or until event_fun returns true and cumulatively saves
+ * all points. `event_fun` can be used to modify x when certain conditions are met, the
+ * integrator then restarts.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename U,
+          typename EventBind_T, typename EventInstrument_T>
+size_t
+loop(MultistepIntegrator<X_DIM, T, Bind_T> &integrator,
+     Event<X_DIM, U, Real_T, EventBind_T, EventInstrument_T> event, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM],
+     bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+	Real_T t_next;
+	Real_T x_next[X_DIM];
+	Real_T x_plus[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const Real_T t = t_arr[i];
+		const Real_T(&x)[X_DIM] = x_arr[i];
+
+		if (event.check(t, x, x_plus)) {
+			integrator.step(t, x_plus, t_next, x_next);
+			t_arr[i + 1] = t_next;
+			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+
+			if (halt_on_event) {
+				break;
+			}
+		} else {
+			integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+			t_arr[i + 1] = t_next;
+			matrix_op::replace_row<T_DIM>(i + 1, x_next, x_arr);
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until event_fun returns true.
+ * `event_fun` can be used to modify x when certain conditions are met.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `integrator`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t`: final time
+ * 6. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename U,
+          typename EventBind_T, typename Instrument_T, typename Summation_T,
+          typename EventInstrument_T, typename R>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     Event<X_DIM, U, R, EventBind_T, EventInstrument_T> event, const NonDeduced_T<R> &t_init,
+     const R (&x_init)[X_DIM], R &t, R (&x)[X_DIM], bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	R x_plus[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (event.check(t, x, x_plus)) {
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x[j] = x_plus[j];
+			}
+
+			if (halt_on_event) {
+				break;
+			}
+		}
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until event_fun returns true and cumulatively
+ * saves all points. `event_fun` can be used to modify x when certain conditions are met.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `integrator`: event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename U,
+          typename EventBind_T, typename Instrument_T, typename Summation_T,
+          typename EventInstrument_T, typename R>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     Event<X_DIM, U, R, EventBind_T, EventInstrument_T> event, const NonDeduced_T<R> &t_init,
+     const R (&x_init)[X_DIM], R (&t_arr)[T_DIM], R (&x_arr)[T_DIM][X_DIM],
+     bool halt_on_event = false)
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t j = 0; j < X_DIM; ++j) {
+		x_arr[0][j] = x_init[j]; //* initialize x
+	}
+	R t_next;
+	R x_next[X_DIM];
+	R x_plus[X_DIM];
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		const R t = t_arr[i];
+		const R(&x)[X_DIM] = x_arr[i];
+
+		if (event.check(t, x, x_plus)) {
+			integrator.step(t, x_plus, t_next, x_next);
+			t_arr[i + 1] = t_next;
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_arr[i + 1][j] = x_next[j];
+			}
+
+			if (halt_on_event) {
+				break;
+			}
+		} else {
+			integrator.step(t, x, t_next, x_next); //* update t, x to the next t, x
+			t_arr[i + 1] = t_next;
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_arr[i + 1][j] = x_next[j];
+			}
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times and streams every `decimation`th point, starting
+ * with the initial point, to `sink` in chunks of `Sink_T::chunk_dim` points. The memory used does
+ * not depend on `T_DIM`, see sink.hpp for the sink concept.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `sink`: sink object
+ * 5. `decimation`: save every `decimation`th point, 0 is taken as 1
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, typename Sink_T>
+void
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], Sink_T &sink,
+     const size_t decimation = 1)
+{
+	integrator.reset(); //* start from the first step
+	constexpr size_t C_DIM = Sink_T::chunk_dim;
+	const size_t stride = decimation > 0 ? decimation : 1;
+	Real_T t_chunk[C_DIM];
+	Real_T x_chunk[C_DIM][X_DIM];
+	size_t count = 0;
+
+	R t = t_init; //* initialize t
+	R x[X_DIM];
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM; ++i) {
+		if (i % stride == 0) {
+			t_chunk[count] = t; //* the sinks store `Real_T`
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_chunk[count][j] = x[j];
+			}
+			++count;
+
+			if (count == C_DIM) {
+				sink.write(t_chunk, x_chunk, count);
+				count = 0;
+			}
+		}
+		if (i < T_DIM - 1) {
+			integrator.step(t, x, t, x); //* update t, x to the next t, x
+		}
+	}
+	if (count > 0) {
+		sink.write(t_chunk, x_chunk, count); //* flush the last partial chunk
+	}
+}
+
+/*
+ * Same as the loop with a sink, but the points are written in place into the chunks of the async
+ * sink, which are passed to its sink on the consumer thread while the integration goes on. The
+ * loop returns without waiting for the consumer thread, call `sink.flush()` before using its sink.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `sink`: async sink object
+ * 5. `decimation`: save every `decimation`th point, 0 is taken as 1
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, size_t Q_DIM, typename Sink_T>
+void
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], AsyncSink<Q_DIM, X_DIM, Sink_T> &sink,
+     const size_t decimation = 1)
+{
+	integrator.reset(); //* start from the first step
+	constexpr size_t C_DIM = Sink_T::chunk_dim;
+	const size_t stride = decimation > 0 ? decimation : 1;
+	size_t count = 0;
+
+	if (!sink.is_good()) {
+		return;
+	}
+	R t = t_init; //* initialize t
+	R x[X_DIM];
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i < T_DIM; ++i) {
+		if (i % stride == 0) {
+			Real_T(&x_chunk)[C_DIM][X_DIM] = sink.get_x_chunk();
+			sink.get_t_chunk()[count] = t; //* the sinks store `Real_T`
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_chunk[count][j] = x[j];
+			}
+			++count;
+
+			if (count == C_DIM) {
+				sink.commit(count); //* queue the chunk, and start the next one
+				count = 0;
+			}
+		}
+		if (i < T_DIM - 1) {
+			integrator.step(t, x, t, x); //* update t, x to the next t, x
+		}
+	}
+	sink.commit(count); //* queue the last partial chunk
+}
+
+/*
+ * Takes the next Runge-Kutta 4th Order step on the time grid while handling the zero-crossings of
+ * `event` within the step: each crossing is located using the dense output, the reset function is
+ * applied at the crossing time and the step is restarted from there back onto the time grid.
+ * Returns true if a terminal event occurred, in which case `t_next` and `x_next` are the crossing
+ * time and the state after the reset.
+ * The located time is at or just after the crossing, so the guard at the reset state can still
+ * have the sign it crossed to. The guard after a reset is therefore evaluated with
+ * `ZeroCrossingEvent::reset_guard`, which takes it from the restarted step once it has left zero
+ * if it is at zero, so that a second crossing within the rest of the step is located too.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: zero-crossing event object
+ * 3. `t`: time [s]
+ * 4. `x`: state
+ *
+ * OUT:
+ * 5. `g`: guard at the start of the step, updated to the guard at the end of the step
+ * 6. `t_next`: next time [s]
+ * 7. `x_next`: next state
+ */
+template <size_t X_DIM, typename T, typename Bind_T, typename Instrument_T, typename Summation_T,
+          typename R, typename U>
+bool
+step_zero_crossing(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+                   ZeroCrossingEvent<X_DIM, U, R> &event, const R &t, const R (&x)[X_DIM],
+                   R &g, R &t_next, R (&x_next)[X_DIM])
+{
+	//* at most this many crossings are handled within a single step, e.g. for Zeno behavior
+	constexpr size_t max_crossing_dim = 16;
+
+	R t_start = t;
+	R x_start[X_DIM];
+	R x_cross[X_DIM];
+	R theta_start = 0;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_start[i] = x[i];
+	}
+	integrator.step(t_start, x_start, t_next, x_next);
+	R g_next = event.guard(t_next, x_next);
+
+	for (size_t j = 0; j < max_crossing_dim && event.is_crossing(g, g_next); ++j) {
+		t_start =
+		    event.locate(integrator, t_start, x_start, theta_start, g, g_next, x_cross);
+		const R g_cross = event.guard(t_start, x_cross);
+		event.reset(t_start, x_cross, x_start);
+
+		if (event.get_is_terminal()) {
+			t_next = t_start;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x_start[i];
+			}
+			g = 0;
+			return true;
+		}
+		integrator.partial_step(t_start, x_start, t_next - t_start, x_next);
+		g = event.reset_guard(integrator, t_start, x_start, g_cross, theta_start);
+		g_next = event.guard(t_next, x_next);
+	}
+	g = g_next;
+	return false;
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until a terminal zero-crossing event occurs.
+ * The crossings are located within the steps, see `step_zero_crossing`.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: zero-crossing event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t`: final time [s]
+ * 6. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, typename U>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     ZeroCrossingEvent<X_DIM, U, R> event, const NonDeduced_T<R> &t_init,
+     const R (&x_init)[X_DIM], R &t, R (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	R g = event.guard(t, x);
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (step_zero_crossing(integrator, event, t, x, g, t, x)) {
+			break;
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until a terminal zero-crossing event occurs,
+ * and cumulatively saves all points. The crossings are located within the steps, see
+ * `step_zero_crossing`, and a terminal event is saved as the last point.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `event`: zero-crossing event object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, typename U>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     ZeroCrossingEvent<X_DIM, U, R> event, const NonDeduced_T<R> &t_init,
+     const R (&x_init)[X_DIM], R (&t_arr)[T_DIM], R (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+	R g = event.guard(t_arr[0], x_arr[0]);
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (step_zero_crossing(integrator, event, t_arr[i], x_arr[i], g, t_arr[i + 1],
+		                       x_arr[i + 1])) {
+			break;
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Takes the next Runge-Kutta 4th Order step on the time grid while handling the zero-crossings of
+ * the event set `events` within the step, see `EventSet::handle`. After the resets, the step is
+ * restarted from the reset time back onto the time grid. Returns true if a terminal event
+ * occurred, in which case `t_next` and `x_next` are the crossing time and the state after the
+ * resets. The guards must have been evaluated at `t`, `x` by `events.init(...)` or by the last
+ * call.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `events`: event set object
+ * 3. `t`: time [s]
+ * 4. `x`: state
+ *
+ * OUT:
+ * 5. `t_next`: next time [s]
+ * 6. `x_next`: next state
+ */
+template <size_t X_DIM, typename T, typename Bind_T, typename Instrument_T, typename Summation_T,
+          typename R, typename U, size_t EVENT_DIM, typename GuardBind_T, typename ResetBind_T>
+bool
+step_event_set(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+               EventSet<X_DIM, U, EVENT_DIM, R, GuardBind_T, ResetBind_T> &events, const R &t,
+               const R (&x)[X_DIM], R &t_next, R (&x_next)[X_DIM])
+{
+	//* at most this many resets are handled within a single step, e.g. for Zeno behavior
+	constexpr size_t max_reset_dim = 16;
+
+	R t_start = t;
+	R x_start[X_DIM];
+	R t_reset;
+	R x_reset[X_DIM];
+	bool is_reset;
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_start[i] = x[i];
+	}
+	integrator.step(t_start, x_start, t_next, x_next);
+
+	for (size_t j = 0; j < max_reset_dim; ++j) {
+		if (events.handle(integrator, t_start, x_start, t_next, x_next, t_reset, x_reset,
+		                  is_reset)) {
+			t_next = t_reset;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x_reset[i];
+			}
+			return true;
+		}
+		if (!is_reset) {
+			return false;
+		}
+		t_start = t_reset;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			x_start[i] = x_reset[i];
+		}
+		integrator.partial_step(t_start, x_start, t_next - t_start, x_next);
+	}
+	events.init(t_next, x_next);
+	return false;
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until a terminal event of the event set
+ * occurs. The crossings are located within the steps, see `step_event_set`.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `events`: event set object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t`: final time [s]
+ * 6. `x`: final state
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, typename U, size_t EVENT_DIM, typename GuardBind_T,
+          typename ResetBind_T>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     EventSet<X_DIM, U, EVENT_DIM, R, GuardBind_T, ResetBind_T> &events,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], R &t, R (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	events.init(t, x);
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (step_event_set(integrator, events, t, x, t, x)) {
+			break;
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times or until a terminal event of the event set
+ * occurs, and cumulatively saves all points. The crossings are located within the steps, see
+ * `step_event_set`, and a terminal event is saved as the last point.
+ *
+ * 1. `integrator`: integrator object
+ * 2. `events`: event set object
+ * 3. `t_init`: initial time [s]
+ * 4. `x_init`: initial state
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T, typename Bind_T, typename Instrument_T,
+          typename Summation_T, typename R, typename U, size_t EVENT_DIM, typename GuardBind_T,
+          typename ResetBind_T>
+size_t
+loop(Integrator<X_DIM, T, R, Bind_T, Instrument_T, Summation_T> &integrator,
+     EventSet<X_DIM, U, EVENT_DIM, R, GuardBind_T, ResetBind_T> &events,
+     const NonDeduced_T<R> &t_init, const R (&x_init)[X_DIM], R (&t_arr)[T_DIM],
+     R (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+	events.init(t_arr[0], x_arr[0]);
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		if (step_event_set(integrator, events, t_arr[i], x_arr[i], t_arr[i + 1],
+		                   x_arr[i + 1])) {
+			break;
+		}
+	}
+	return integrator.get_step_count();
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times for an ensemble of `N` initial conditions.
+ *
+ * 1. `integrator`: batch integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial ensemble state
+ *
+ * OUT:
+ * 4. `t`: final time [s]
+ * 5. `x`: final ensemble state
+ */
+template <size_t T_DIM, size_t N, size_t X_DIM, typename T>
+void
+loop(BatchIntegrator<N, X_DIM, T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM][N], Real_T &t, Real_T (&x)[X_DIM][N])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			x[i][j] = x_init[i][j]; //* initialize x
+		}
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+}
+
+/*
+ * Loops Runge-Kutta 4th Order step `T_DIM` times for an ensemble of `N` initial conditions and
+ * cumulatively saves the results
+ *
+ * 1. `integrator`: batch integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial ensemble state
+ *
+ * OUT:
+ * 4. `t_arr`: time history
+ * 5. `x_arr`: ensemble state history
+ */
+template <size_t T_DIM, size_t N, size_t X_DIM, typename T>
+void
+loop(BatchIntegrator<N, X_DIM, T> &integrator, const Real_T &t_init,
+     const Real_T (&x_init)[X_DIM][N], Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM][N])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			x_arr[0][i][j] = x_init[i][j]; //* initialize x
+		}
+	}
+
+	for (size_t i = 0; i < T_DIM - 1; ++i) {
+		integrator.step(t_arr[i], x_arr[i], t_arr[i + 1], x_arr[i + 1]);
+	}
+}
+
+/*
+ * Loops adaptive Dormand-Prince 5(4) steps until `t_final`, or until a step does not advance
+ * the time, e.g. if the ODE function is NaN. Returns the number of steps.
+ *
+ * 1. `integrator`: adaptive integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `t_final`: final time [s]
+ *
+ * OUT:
+ * 5. `t`: final time [s]
+ * 6. `x`: final state
+ */
+template <size_t X_DIM, typename T>
+size_t
+loop(AdaptiveIntegrator<X_DIM, T> &integrator, const Real_T &t_init, const Real_T (&x_init)[X_DIM],
+     const Real_T &t_final, Real_T &t, Real_T (&x)[X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+	size_t step_count = 0;
+
+	while (t < t_final) {
+		const Real_T t_prev = t;
+		integrator.step(t, x, t, x, t_final); //* update t, x to the next t, x
+
+		if (!(t > t_prev)) {
+			break; //* the error was not finite down to a step of size 0
+		}
+		++step_count;
+	}
+	return step_count;
+}
+
+/*
+ * Loops adaptive Dormand-Prince 5(4) steps until `t_final` or until `T_DIM` points are saved, and
+ * cumulatively saves the results. Stops early as the loop above. Returns the number of saved
+ * points.
+ *
+ * 1. `integrator`: adaptive integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `t_final`: final time [s]
+ *
+ * OUT:
+ * 5. `t_arr`: time history
+ * 6. `x_arr`: state history
+ */
+template <size_t T_DIM, size_t X_DIM, typename T>
+size_t
+loop(AdaptiveIntegrator<X_DIM, T> &integrator, const Real_T &t_init, const Real_T (&x_init)[X_DIM],
+     const Real_T &t_final, Real_T (&t_arr)[T_DIM], Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	integrator.reset(); //* start from the first step
+	t_arr[0] = t_init;                               //* initialize t
+	matrix_op::replace_row<T_DIM>(0, x_init, x_arr); //* initialize x
+	size_t i = 0;
+
+	while (i < T_DIM - 1 && t_arr[i] < t_final) {
+		integrator.step(t_arr[i], x_arr[i], t_arr[i + 1], x_arr[i + 1], t_final);
+
+		if (!(t_arr[i + 1] > t_arr[i])) {
+			break; //* the error was not finite down to a step of size 0
+		}
+		++i;
+	}
+	return i + 1;
+}
+
+/*
+ * Loops the runtime-sized Runge-Kutta 4th Order step `t_dim` times.
+ *
+ * 1. `integrator`: dynamic integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `t_dim`: number of time points
+ *
+ * OUT:
+ * 5. `t`: final time [s]
+ * 6. `x`: final state
+ * true if the sizes of `x_init` and `x` match the integrator
+ */
+template <typename T>
+bool
+loop(DynamicIntegrator<T> &integrator, const Real_T &t_init, Span<const Real_T> x_init,
+     const size_t t_dim, Real_T &t, Span<Real_T> x)
+{
+	integrator.reset(); //* start from the first step
+	const size_t x_dim = integrator.get_x_dim();
+
+	if (!integrator.is_good() || x_init.size != x_dim || x.size != x_dim) {
+		return false;
+	}
+	t = t_init; //* initialize t
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		x[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i + 1 < t_dim; ++i) {
+		integrator.step(t, x, t, x); //* update t, x to the next t, x
+	}
+	return true;
+}
+
+/*
+ * Loops the runtime-sized Runge-Kutta 4th Order step `t_dim` times and cumulatively saves the
+ * results. `x_arr` is stored row-major, i.e. the state at `t_arr[i]` starts at `x_arr[i * x_dim]`.
+ *
+ * 1. `integrator`: dynamic integrator object
+ * 2. `t_init`: initial time [s]
+ * 3. `x_init`: initial state
+ * 4. `t_dim`: number of time points
+ *
+ * OUT:
+ * 5. `t_arr`: time history of size `t_dim`
+ * 6. `x_arr`: state history of size `t_dim * x_dim`
+ * true if the sizes of `x_init`, `t_arr` and `x_arr` match the integrator and `t_dim`
+ */
+template <typename T>
+bool
+loop(DynamicIntegrator<T> &integrator, const Real_T &t_init, Span<const Real_T> x_init,
+     const size_t t_dim, Span<Real_T> t_arr, Span<Real_T> x_arr)
+{
+	integrator.reset(); //* start from the first step
+	const size_t x_dim = integrator.get_x_dim();
+
+	if (!integrator.is_good() || t_dim == 0 || x_init.size != x_dim || t_arr.size < t_dim ||
+	    x_arr.size < t_dim * x_dim) {
+		return false;
+	}
+	t_arr[0] = t_init; //* initialize t
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		x_arr[i] = x_init[i]; //* initialize x
+	}
+
+	for (size_t i = 0; i + 1 < t_dim; ++i) {
+		const Span<const Real_T> x(x_arr.data + i * x_dim, x_dim);
+		const Span<Real_T> x_next(x_arr.data + (i + 1) * x_dim, x_dim);
+		integrator.step(t_arr[i], x, t_arr[i + 1], x_next); //* update t, x to the next t, x
+	}
+	return true;
+}
+} // namespace rk4_solver
+
 #endif
@@ -0,0 +1,332 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LTI_INTEGRATOR_HPP_CINARAL_261017_2040
+#define LTI_INTEGRATOR_HPP_CINARAL_261017_2040
+
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cmath>
+
+namespace rk4_solver
+{
+//* discretization of a linear time-invariant system
+enum class Discretization {
+	rk4,  //* the Runge-Kutta 4th Order step, i.e. the same map as `Integrator`
+	exact //* the matrix exponential, exact for inputs that are constant over the step
+};
+
+/*
+ * Integrator of the linear time-invariant system `dt_x = A*x + B*u`. The discrete transition
+ * `x_next = x + Psi*x + Gamma*u` is computed once in the constructor, so that a step is a single
+ * matrix-vector product and an input term, instead of four evaluations of the ODE function. The
+ * input is held constant over each step (zero-order hold).
+ */
+template <size_t X_DIM, size_t U_DIM> class LtiIntegrator
+{
+  public:
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, or if the norm of
+	 * `time_step*A` is not finite for the exact discretization, the steps then hold the state.
+	 *
+	 * 1. `A`: state matrix
+	 * 2. `B`: input matrix
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `discretization`: Runge-Kutta 4th Order polynomial or matrix exponential
+	 * 6. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	LtiIntegrator(const Real_T (&A)[X_DIM][X_DIM], const Real_T (&B)[X_DIM][U_DIM],
+	              const Real_T time_step, const Real_T t_init = 0,
+	              const Discretization discretization = Discretization::rk4,
+	              const Allocator &allocator = Allocator())
+	    : time_step(time_step), t_init(t_init), workspace(allocator)
+	{
+		if (is_good()) {
+			if (discretization == Discretization::exact) {
+				is_discretized = discretize_exact(A, B);
+			} else {
+				discretize_rk4(A, B);
+			}
+		}
+		reset();
+	}
+
+	/*
+	 * Computes the next step.
+	 *
+	 * 1. `t`: time [s], not used since the system is time-invariant
+	 * 2. `x`: state
+	 * 3. `u`: input, held constant over the step
+	 *
+	 * OUT:
+	 * 4. `t_next`: next time [s]
+	 * 5. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T (&u)[U_DIM], Real_T &t_next,
+	     Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		//* dx = Psi*x + Gamma*u, fused into one pass over the rows
+		for (size_t i = 0; i < X_DIM; ++i) {
+			Real_T dx_i = 0;
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				dx_i += buf.psi[i][j] * x[j];
+			}
+			for (size_t j = 0; j < U_DIM; ++j) {
+				dx_i += buf.gamma[i][j] * u[j];
+			}
+			buf.dx[i] = dx_i;
+		}
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			//* compensated (Kahan) summation, ffast-math might break this
+			const Real_T compensated_dx_i = buf.dx[i] - buf.accumulator[i];
+			const Real_T x_next_i = x[i] + compensated_dx_i;
+			buf.accumulator[i] = (x_next_i - x[i]) - compensated_dx_i;
+			x_next[i] = x_next_i;
+		}
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		if (is_good()) {
+			Buffers &buf = workspace.get();
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				buf.accumulator[i] = 0;
+			}
+		}
+	}
+
+	//* true if the workspace could be allocated and the system could be discretized
+	bool
+	is_good() const
+	{
+		return workspace.is_good() && is_discretized;
+	}
+
+	//* `Psi = Phi - I`, where `Phi` is the state transition matrix of a step, if `is_good()`
+	const Real_T (&get_psi() const)[X_DIM][X_DIM]
+	{
+		return workspace.get().psi;
+	}
+
+	//* input matrix of a step, if `is_good()`
+	const Real_T (&get_gamma() const)[X_DIM][U_DIM]
+	{
+		return workspace.get().gamma;
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter;
+	bool is_discretized = true;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T psi[X_DIM][X_DIM];
+		alignas(cache_line_size) Real_T gamma[X_DIM][U_DIM];
+		alignas(cache_line_size) Real_T dx[X_DIM];
+		alignas(cache_line_size) Real_T accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	/*
+	 * With `M = h*A`, the Runge-Kutta 4th Order step of a linear system is
+	 * `Psi = M + M^2/2 + M^3/6 + M^4/24` and `Gamma = h*(I + M/2 + M^2/6 + M^3/24)*B`,
+	 * evaluated with Horner's rule as `Psi = M*S` and `Gamma = h*S*B`, where
+	 * `S = I + M/2*(I + M/3*(I + M/4))`.
+	 */
+	void
+	discretize_rk4(const Real_T (&A)[X_DIM][X_DIM], const Real_T (&B)[X_DIM][U_DIM])
+	{
+		compute_series(A, B, time_step, 4);
+	}
+
+	/*
+	 * `Psi = exp(h*A) - I` and `Gamma = int_0^h exp(s*A) ds * B` by scaling and squaring. The
+	 * series `Psi = M*(I + M/2! + M^2/3! + ...)` and `Gamma = h*(I + M/2! + M^2/3! + ...)*B`
+	 * are evaluated for `M = h*A/2^s` with a norm of at most 1/2, and then doubled `s` times
+	 * with `Psi(2h) = (2*I + Psi(h))*Psi(h)` and `Gamma(2h) = (2*I + Psi(h))*Gamma(h)`. `Psi`
+	 * is kept instead of `exp(h*A)` so that small steps do not lose precision to the identity.
+	 * Returns false if the norm of `h*A` is not finite, since the number of squarings is then
+	 * not defined.
+	 */
+	bool
+	discretize_exact(const Real_T (&A)[X_DIM][X_DIM], const Real_T (&B)[X_DIM][U_DIM])
+	{
+		constexpr size_t term_dim = 16;
+		Buffers &buf = workspace.get();
+		const Real_T norm = get_norm(A) * time_step;
+
+		if (!std::isfinite(norm)) {
+			return false;
+		}
+
+		//* scale the step so that the norm of M is at most 1/2
+		int exponent;
+		std::frexp(norm, &exponent);
+		const size_t square_dim = exponent > -1 ? exponent + 1 : 0;
+		const Real_T sub_step = std::ldexp(time_step, -static_cast<int>(square_dim));
+
+		compute_series(A, B, sub_step, term_dim);
+
+		for (size_t s = 0; s < square_dim; ++s) {
+			Real_T two_psi[X_DIM][X_DIM]; //* 2*I + Psi
+			Real_T psi[X_DIM][X_DIM];
+			Real_T gamma[X_DIM][U_DIM];
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				for (size_t j = 0; j < X_DIM; ++j) {
+					two_psi[i][j] = buf.psi[i][j] + (i == j ? 2 : 0);
+				}
+			}
+			multiply(two_psi, buf.psi, psi);
+			multiply(two_psi, buf.gamma, gamma);
+			copy(psi, buf.psi);
+			copy(gamma, buf.gamma);
+		}
+		return true;
+	}
+
+	/*
+	 * Computes `Psi = M*S` and `Gamma = h*S*B` with `M = h*A` and the truncated series
+	 * `S = I + M/2!*(I + M/3*(I + ... (I + M/term_dim)))`.
+	 */
+	void
+	compute_series(const Real_T (&A)[X_DIM][X_DIM], const Real_T (&B)[X_DIM][U_DIM],
+	               const Real_T h, const size_t term_dim)
+	{
+		Buffers &buf = workspace.get();
+		Real_T M[X_DIM][X_DIM];
+		Real_T S[X_DIM][X_DIM];
+		Real_T temp[X_DIM][X_DIM];
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < X_DIM; ++j) {
+				M[i][j] = h * A[i][j];
+				S[i][j] = i == j ? 1 : 0;
+			}
+		}
+
+		for (size_t k = term_dim; k >= 2; --k) {
+			//* S = I + M/k*S
+			multiply(M, S, temp);
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				for (size_t j = 0; j < X_DIM; ++j) {
+					S[i][j] = temp[i][j] / k + (i == j ? 1 : 0);
+				}
+			}
+		}
+		multiply(M, S, buf.psi);
+		multiply(S, B, buf.gamma);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < U_DIM; ++j) {
+				buf.gamma[i][j] *= h;
+			}
+		}
+	}
+
+	//* C = A*B
+	template <size_t N>
+	static void
+	multiply(const Real_T (&A)[X_DIM][X_DIM], const Real_T (&B)[X_DIM][N],
+	         Real_T (&C)[X_DIM][N])
+	{
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				C[i][j] = 0;
+
+				for (size_t k = 0; k < X_DIM; ++k) {
+					C[i][j] += A[i][k] * B[k][j];
+				}
+			}
+		}
+	}
+
+	template <size_t N>
+	static void
+	copy(const Real_T (&A)[X_DIM][N], Real_T (&B)[X_DIM][N])
+	{
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				B[i][j] = A[i][j];
+			}
+		}
+	}
+
+	//* infinity norm, i.e. the maximum absolute row sum, NaN if an element is NaN
+	static Real_T
+	get_norm(const Real_T (&A)[X_DIM][X_DIM])
+	{
+		Real_T norm = 0;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			Real_T row_sum = 0;
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				row_sum += std::abs(A[i][j]);
+			}
+			norm = row_sum > norm || std::isnan(row_sum) ? row_sum : norm;
+		}
+		return norm;
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LU_HPP_CINARAL_261017_2120
+#define LU_HPP_CINARAL_261017_2120
+
+#include "types.hpp"
+#include <cmath>
+
+/*
+ * Fixed-size LU decomposition with partial pivoting, for the small dense systems of the implicit
+ * integrators. It works in place on `Real_T[N][N]` arrays like matrix_op.
+ */
+
+namespace rk4_solver
+{
+/*
+ * Decomposes `A` into `P*A = L*U` in place, where `L` is unit lower triangular and stored below
+ * the diagonal, and `U` is stored on and above the diagonal. Returns false if `A` is singular.
+ *
+ * 1. `A`: matrix, overwritten with `L` and `U`
+ *
+ * OUT:
+ * 2. `pivot`: row permutation `P`, row `i` of `P*A` is row `pivot[i]` of `A`
+ */
+template <size_t N>
+bool
+lu_decompose(Real_T (&A)[N][N], size_t (&pivot)[N])
+{
+	for (size_t i = 0; i < N; ++i) {
+		pivot[i] = i;
+	}
+
+	for (size_t k = 0; k < N; ++k) {
+		//* partial pivoting, the largest element in the column
+		size_t p = k;
+
+		for (size_t i = k + 1; i < N; ++i) {
+			if (std::abs(A[i][k]) > std::abs(A[p][k])) {
+				p = i;
+			}
+		}
+
+		if (A[p][k] == 0) {
+			return false;
+		}
+
+		if (p != k) {
+			for (size_t j = 0; j < N; ++j) {
+				const Real_T temp = A[k][j];
+				A[k][j] = A[p][j];
+				A[p][j] = temp;
+			}
+			const size_t temp = pivot[k];
+			pivot[k] = pivot[p];
+			pivot[p] = temp;
+		}
+		const Real_T inv_pivot = 1 / A[k][k];
+
+		for (size_t i = k + 1; i < N; ++i) {
+			const Real_T l_ik = A[i][k] * inv_pivot;
+			A[i][k] = l_ik;
+
+			for (size_t j = k + 1; j < N; ++j) {
+				A[i][j] -= l_ik * A[k][j];
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * Solves `A*x = b` using the decomposition of `A` from `lu_decompose(...)`.
+ *
+ * 1. `LU`: decomposition of `A`
+ * 2. `pivot`: row permutation
+ * 3. `b`: right-hand side
+ *
+ * OUT:
+ * 4. `x`: solution, must not be `b`
+ */
+template <size_t N>
+void
+lu_solve(const Real_T (&LU)[N][N], const size_t (&pivot)[N], const Real_T (&b)[N],
+         Real_T (&x)[N])
+{
+	//* forward substitution, L*y = P*b
+	for (size_t i = 0; i < N; ++i) {
+		Real_T y_i = b[pivot[i]];
+
+		for (size_t j = 0; j < i; ++j) {
+			y_i -= LU[i][j] * x[j];
+		}
+		x[i] = y_i;
+	}
+
+	//* back substitution, U*x = y
+	for (size_t i = N; i-- > 0;) {
+		Real_T x_i = x[i];
+
+		for (size_t j = i + 1; j < N; ++j) {
+			x_i -= LU[i][j] * x[j];
+		}
+		x[i] = x_i / LU[i][i];
+	}
+}
+} // namespace rk4_solver
+
+#endif
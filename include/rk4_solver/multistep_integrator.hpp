@@ -0,0 +1,280 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MULTISTEP_INTEGRATOR_HPP_CINARAL_261017_2250
+#define MULTISTEP_INTEGRATOR_HPP_CINARAL_261017_2250
+
+#include "binding.hpp"
+#include "integrator.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <utility>
+
+namespace rk4_solver
+{
+//* evaluations of the ODE function per step of the predictor-corrector
+enum class PredictorCorrector {
+	pec, //* predict, evaluate, correct, the derivative at the prediction is kept, 1 evaluation
+	pece //* predict, evaluate, correct, evaluate, 2 evaluations
+};
+
+/*
+ * Adams-Bashforth-Moulton 4th Order predictor-corrector integrator:
+ *
+ * `x_p = x_n + h/24*(55*f_n - 59*f_(n-1) + 37*f_(n-2) - 9*f_(n-3))`
+ * `x_next = x_n + h/24*(9*ode_fun(t_next, x_p) + 19*f_n - 5*f_(n-1) + f_(n-2))`
+ *
+ * where `f_i` are the past derivatives, which are kept in a ring buffer. The first three steps
+ * are Runge-Kutta 4th Order steps of `Integrator`. The integrator restarts the same way if the
+ * time or the state passed to `step(...)` is not the last step's result, e.g. after an event
+ * applied `x_plus`, or after `reset()`.
+ */
+template <size_t X_DIM, typename T, typename Bind_T = MemberBinding<T, OdeFun_T<X_DIM, T>>>
+class MultistepIntegrator
+{
+  public:
+	static constexpr size_t history_dim = 4;
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `mode`: evaluations per step
+	 * 6. `allocator`: allocator of the workspaces, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	MultistepIntegrator(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T time_step,
+	                    const Real_T t_init = 0,
+	                    const PredictorCorrector mode = PredictorCorrector::pece,
+	                    const Allocator &allocator = Allocator())
+	    : ode_fun(obj, ode_fun), rk4_integrator(this->ode_fun, time_step, t_init, allocator),
+	      time_step(time_step), t_init(t_init), mode(mode), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `ode_fun`: binding of the ODE function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `mode`: evaluations per step
+	 * 5. `allocator`: allocator of the workspaces, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	MultistepIntegrator(Bind_T ode_fun, const Real_T time_step, const Real_T t_init = 0,
+	                    const PredictorCorrector mode = PredictorCorrector::pece,
+	                    const Allocator &allocator = Allocator())
+	    : ode_fun(std::move(ode_fun)),
+	      rk4_integrator(this->ode_fun, time_step, t_init, allocator), time_step(time_step),
+	      t_init(t_init), mode(mode), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+		//* local copy, since the stores to the buffers could alias the member
+		const Real_T h = time_step;
+		const Real_T t_end = t_init + (step_counter + 1) * time_step;
+
+		if (!is_continued(t, x, buf)) {
+			//* restart with f_n = ode_fun(t, x)
+			history_count = 1;
+			head = 0;
+			ode_fun(t, x, buf.f[head]);
+			rk4_integrator.reset();
+		}
+
+		if (history_count < history_dim) {
+			//* bootstrap
+			Real_T t_rk4;
+			rk4_integrator.step(t, x, t_rk4, buf.x_temp);
+			push(t_end, buf.x_temp, buf);
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = buf.x_temp[i];
+				buf.x_last[i] = buf.x_temp[i];
+			}
+		} else {
+			const Real_T(&f_0)[X_DIM] = buf.f[head];
+			const Real_T(&f_1)[X_DIM] = buf.f[(head + 3) % history_dim];
+			const Real_T(&f_2)[X_DIM] = buf.f[(head + 2) % history_dim];
+			const Real_T(&f_3)[X_DIM] = buf.f[(head + 1) % history_dim];
+
+			constexpr Real_T w = 1. / 24.;
+
+			//* predict with Adams-Bashforth
+			for (size_t i = 0; i < X_DIM; ++i) {
+				const Real_T sum_i =
+				    55 * f_0[i] - 59 * f_1[i] + 37 * f_2[i] - 9 * f_3[i];
+				buf.x_temp[i] = x[i] + w * h * sum_i;
+			}
+
+			//* evaluate, f_p = ode_fun(t_next, x_p)
+			ode_fun(t_end, buf.x_temp, buf.f_temp);
+
+			//* correct with Adams-Moulton
+			for (size_t i = 0; i < X_DIM; ++i) {
+				const Real_T sum_i =
+				    9 * buf.f_temp[i] + 19 * f_0[i] - 5 * f_1[i] + f_2[i];
+				const Real_T dx_i = w * h * sum_i;
+				//* compensated (Kahan) summation, ffast-math might break this
+				const Real_T compensated_dx_i = dx_i - buf.accumulator[i];
+				const Real_T x_next_i = x[i] + compensated_dx_i;
+				buf.accumulator[i] = (x_next_i - x[i]) - compensated_dx_i;
+				x_next[i] = x_next_i;
+				buf.x_last[i] = x_next_i;
+			}
+
+			if (mode == PredictorCorrector::pece) {
+				//* evaluate, f_next = ode_fun(t_next, x_next)
+				push(t_end, buf.x_last, buf);
+			} else {
+				//* f_next = f_p, f_3 is overwritten
+				head = (head + 1) % history_dim;
+
+				for (size_t i = 0; i < X_DIM; ++i) {
+					buf.f[head][i] = buf.f_temp[i];
+				}
+			}
+		}
+		t_last = t_end;
+
+		t_next = t_end;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+		history_count = 0;
+		head = 0;
+
+		if (is_good()) {
+			Buffers &buf = workspace.get();
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				buf.accumulator[i] = 0;
+			}
+		}
+	}
+
+	//* true if the workspaces could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good() && rk4_integrator.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	Bind_T ode_fun;
+	Integrator<X_DIM, T, Real_T, Bind_T> rk4_integrator; //* bootstrap, copy of the binding
+	const Real_T time_step;
+	const Real_T t_init;
+	const PredictorCorrector mode;
+	size_t step_counter;
+	size_t history_count; //* number of valid past derivatives
+	size_t head;          //* index of the newest past derivative
+	Real_T t_last;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T f[history_dim][X_DIM];
+		alignas(cache_line_size) Real_T f_temp[X_DIM];
+		alignas(cache_line_size) Real_T x_temp[X_DIM];
+		alignas(cache_line_size) Real_T x_last[X_DIM];
+		alignas(cache_line_size) Real_T accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	//* true if `(t, x)` is the result of the last step and the past derivatives are valid
+	bool
+	is_continued(const Real_T &t, const Real_T (&x)[X_DIM], const Buffers &buf) const
+	{
+		if (history_count == 0 || t != t_last) {
+			return false;
+		}
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			if (x[i] != buf.x_last[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//* evaluates the derivative at `(t, x)` and adds it to the past derivatives
+	void
+	push(const Real_T t, const Real_T (&x)[X_DIM], Buffers &buf)
+	{
+		head = (head + 1) % history_dim;
+		ode_fun(t, x, buf.f[head]);
+
+		if (history_count < history_dim) {
+			++history_count;
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,369 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PARALLEL_INTEGRATOR_HPP_CINARAL_261017_2215
+#define PARALLEL_INTEGRATOR_HPP_CINARAL_261017_2215
+
+#include "binding.hpp"
+#include "simd.hpp"
+#include "summation.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace rk4_solver
+{
+/*
+ * Runge-Kutta 4th Order integrator whose steps are split over the threads of a `ThreadPool`, for
+ * systems with a large number of states. The state is split into one contiguous partition per
+ * thread, and the ODE function of type `RangeOdeFun_T` computes the derivatives
+ * `dt_x[begin]...dt_x[end - 1]` of a partition, reading any element of `x`. It is called
+ * concurrently for disjoint partitions. Each thread computes the stage inputs and the update of
+ * its own partition, and the stages are separated by a `SpinBarrier`, i.e. a step wakes the pool
+ * once and waits at 3 barriers.
+ *
+ * The partitions start at cache lines, and each thread is the first to write its partition of the
+ * workspace, so an operating system with a first-touch policy places its pages on the memory node
+ * of the thread. The placement holds as long as the threads of the pool are not migrated to other
+ * nodes, e.g. if they are pinned. Systems with fewer than 2 partitions of `min_partition_dim`
+ * states are integrated on the calling thread only.
+ */
+template <size_t X_DIM, typename T, typename Bind_T = MemberBinding<T, RangeOdeFun_T<X_DIM, T>>,
+          typename Summation_T = summation::Kahan>
+class ParallelIntegrator
+{
+  public:
+	//* states per partition, below which the synchronization costs more than the threads save
+	static constexpr size_t min_partition_dim = 4096;
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `pool`: thread pool, which must outlive the integrator
+	 * 2. `obj`: object of the ODE function
+	 * 3. `ode_fun`: ODE function of a range of states
+	 * 4. `time_step`: time step [s]
+	 * 5. `t_init`: initial time [s]
+	 * 6. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	ParallelIntegrator(ThreadPool &pool, T &obj, RangeOdeFun_T<X_DIM, T> ode_fun,
+	                   const Real_T time_step, const Real_T t_init = 0,
+	                   const Allocator &allocator = Allocator())
+	    : ParallelIntegrator(pool, Bind_T(obj, ode_fun), time_step, t_init, allocator)
+	{
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `pool`: thread pool, which must outlive the integrator
+	 * 2. `ode_fun`: binding of the ODE function of a range of states
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	ParallelIntegrator(ThreadPool &pool, Bind_T ode_fun, const Real_T time_step,
+	                   const Real_T t_init = 0, const Allocator &allocator = Allocator())
+	    : pool(pool), ode_fun(std::move(ode_fun)), time_step(time_step), t_init(t_init),
+	      partition_dim(compute_partition_dim(pool.get_thread_count())),
+	      barrier(partition_dim), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next Runge-Kutta 4th Order step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		if (partition_dim == 1) {
+			step_partition(0, t, x, x_next);
+		} else {
+			auto job = [&](const size_t thread_idx) {
+				if (thread_idx < partition_dim) {
+					step_partition(thread_idx, t, x, x_next);
+				}
+			};
+			pool.run(job);
+		}
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+	}
+
+	//* resets the step counter and the compensations, on the thread of each partition
+	void
+	reset()
+	{
+		step_counter = 0;
+
+		if (!is_good()) {
+			return;
+		}
+		if (partition_dim == 1) {
+			reset_partition(0);
+		} else {
+			auto job = [&](const size_t thread_idx) {
+				if (thread_idx < partition_dim) {
+					reset_partition(thread_idx);
+				}
+			};
+			pool.run(job);
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+	//* number of threads a step is split over
+	size_t
+	get_partition_dim() const
+	{
+		return partition_dim;
+	}
+
+	/*
+	 * 1. `partition_idx`: index of the partition
+	 *
+	 * OUT:
+	 * index of the first state of the partition, or `X_DIM` for `partition_idx = partition_dim`
+	 */
+	size_t
+	get_partition_begin(const size_t partition_idx) const
+	{
+		constexpr size_t line_dim = cache_line_size / sizeof(Real_T);
+
+		if (partition_idx >= partition_dim) {
+			return X_DIM;
+		}
+		return X_DIM * partition_idx / partition_dim / line_dim * line_dim;
+	}
+
+  private:
+	ThreadPool &pool;
+	Bind_T ode_fun;
+	const Real_T time_step;
+	const Real_T t_init;
+	const size_t partition_dim;
+	size_t step_counter;
+	SpinBarrier barrier;
+
+	static size_t
+	compute_partition_dim(const size_t thread_count)
+	{
+		const size_t max_partition_dim = X_DIM / min_partition_dim;
+
+		if (max_partition_dim < 2) {
+			return 1;
+		}
+		return thread_count < max_partition_dim ? thread_count : max_partition_dim;
+	}
+
+	void
+	wait()
+	{
+		if (partition_dim > 1) {
+			barrier.arrive_and_wait();
+		}
+	}
+
+	/*
+	 * Computes the step of a partition. The stage inputs alternate between two buffers, so that
+	 * a thread can write the next stage input while the others still read the last one.
+	 */
+	void
+	step_partition(const size_t partition_idx, const Real_T t, const Real_T (&x)[X_DIM],
+	               Real_T (&x_next)[X_DIM])
+	{
+		Buffers &buf = workspace.get();
+		const size_t begin = get_partition_begin(partition_idx);
+		const size_t end = get_partition_begin(partition_idx + 1);
+		const Real_T h = time_step;
+
+		//* ode_fun(ti, xi)
+		ode_fun(t, x, begin, end, buf.k_0);
+		stage_input(begin, end, x, h / 2, buf.k_0, buf.x_temp_0);
+		wait();
+
+		//* ode_fun(ti + h/2, xi + h/2*k_0)
+		ode_fun(t + h / 2, buf.x_temp_0, begin, end, buf.k_1);
+		stage_input(begin, end, x, h / 2, buf.k_1, buf.x_temp_1);
+		wait();
+
+		//* ode_fun(ti + h/2, xi + h/2*k_1)
+		ode_fun(t + h / 2, buf.x_temp_1, begin, end, buf.k_2);
+		stage_input(begin, end, x, h, buf.k_2, buf.x_temp_0);
+		wait();
+
+		//* ode_fun(ti + h, xi + k_2), the other threads no longer read x
+		ode_fun(t + h, buf.x_temp_0, begin, end, buf.k_3);
+		update(begin, end, x, h, buf, x_next);
+	}
+
+	//* first touch of the workspace of a partition
+	void
+	reset_partition(const size_t partition_idx)
+	{
+		Buffers &buf = workspace.get();
+		const size_t begin = get_partition_begin(partition_idx);
+		const size_t end = get_partition_begin(partition_idx + 1);
+
+		for (size_t i = begin; i < end; ++i) {
+			buf.k_0[i] = 0;
+			buf.k_1[i] = 0;
+			buf.k_2[i] = 0;
+			buf.k_3[i] = 0;
+			buf.x_temp_0[i] = 0;
+			buf.x_temp_1[i] = 0;
+			Summation_T::reset(buf.accumulator[i]);
+		}
+	}
+
+	static constexpr bool is_vectorized = X_DIM >= simd::min_dim && simd::is_vectorized<Real_T>;
+
+	//* x_stage = x + a * k
+	static void
+	stage_input(const size_t begin, const size_t end, const Real_T (&x)[X_DIM], const Real_T a,
+	            const Real_T (&k)[X_DIM], Real_T (&x_stage)[X_DIM])
+	{
+		if constexpr (is_vectorized) {
+			if (simd::get_isa() != simd::Isa::scalar) {
+				simd::stage_input(end - begin, x + begin, a, k + begin,
+				                  x_stage + begin);
+				return;
+			}
+		}
+
+		for (size_t i = begin; i < end; ++i) {
+			x_stage[i] = a * k[i] + x[i];
+		}
+	}
+
+	struct Buffers;
+
+	//* x_next = x + h * (k_0 + 2 * k_1 + 2 * k_2 + k_3) / 6, added by the summation policy
+	static void
+	update(const size_t begin, const size_t end, const Real_T (&x)[X_DIM], const Real_T h,
+	       Buffers &buf, Real_T (&x_next)[X_DIM])
+	{
+		if constexpr (is_vectorized && std::is_same<Summation_T, summation::Kahan>::value) {
+			if (simd::get_isa() != simd::Isa::scalar) {
+				static_assert(sizeof(buf.accumulator) == sizeof(Real_T[X_DIM]),
+				              "the compensations must be contiguous");
+				Real_T *c = reinterpret_cast<Real_T *>(buf.accumulator);
+				simd::kahan_update(end - begin, x + begin, h, buf.k_0 + begin,
+				                   buf.k_1 + begin, buf.k_2 + begin,
+				                   buf.k_3 + begin, c + begin, x_next + begin);
+				return;
+			}
+		}
+		constexpr Real_T w0 = 1. / 6.;
+		constexpr Real_T w1 = 1. / 3.;
+
+		for (size_t i = begin; i < end; ++i) {
+			const Real_T dx_i = h * (w0 * buf.k_0[i] + w1 * buf.k_1[i] +
+			                         w1 * buf.k_2[i] + w0 * buf.k_3[i]);
+			x_next[i] = Summation_T::add(x[i], dx_i, buf.accumulator[i]);
+		}
+	}
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T k_0[X_DIM];
+		alignas(cache_line_size) Real_T k_1[X_DIM];
+		alignas(cache_line_size) Real_T k_2[X_DIM];
+		alignas(cache_line_size) Real_T k_3[X_DIM];
+		alignas(cache_line_size) Real_T x_temp_0[X_DIM];
+		alignas(cache_line_size) Real_T x_temp_1[X_DIM];
+		alignas(cache_line_size) typename Summation_T::template Accumulator<Real_T>
+		    accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+};
+
+/*
+ * Creates a parallel integrator that calls the member function `FUN` which is known at compile
+ * time, e.g. `make_parallel_integrator<&Dynamics::ode_fun>(pool, dynamics, time_step)`.
+ */
+template <auto FUN, typename Summation_T = summation::Kahan,
+          typename T = typename RangeOdeFunTraits<decltype(FUN)>::Class_T,
+          size_t X_DIM = RangeOdeFunTraits<decltype(FUN)>::x_dim>
+ParallelIntegrator<X_DIM, T, StaticMemberBinding<FUN>, Summation_T>
+make_parallel_integrator(ThreadPool &pool, T &obj, const Real_T time_step,
+                         const Real_T t_init = 0, const Allocator &allocator = Allocator())
+{
+	return {pool, StaticMemberBinding<FUN>(obj), time_step, t_init, allocator};
+}
+
+/*
+ * Creates a parallel integrator that calls a lambda, a functor or a free function with the
+ * signature `void(const Real_T t, const Real_T (&x)[X_DIM], const size_t begin, const size_t end,
+ * Real_T (&dt_x)[X_DIM])`, which must be safe to call concurrently.
+ */
+template <size_t X_DIM, typename Summation_T = summation::Kahan, typename F>
+ParallelIntegrator<X_DIM, CallableBinding<F>, CallableBinding<F>, Summation_T>
+make_parallel_integrator(ThreadPool &pool, F fun, const Real_T time_step, const Real_T t_init = 0,
+                         const Allocator &allocator = Allocator())
+{
+	return {pool, CallableBinding<F>(std::move(fun)), time_step, t_init, allocator};
+}
+} // namespace rk4_solver
+
+#endif
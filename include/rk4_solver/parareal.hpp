@@ -0,0 +1,219 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PARAREAL_HPP_CINARAL_261017_2330
+#define PARAREAL_HPP_CINARAL_261017_2330
+
+#include "integrator.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cmath>
+#include <limits>
+
+namespace rk4_solver
+{
+/*
+ * Parallel-in-time (Parareal) solver for a single long trajectory. The time span is split into
+ * `SLICE_DIM` slices. A coarse Runge-Kutta 4th Order integrator with a `coarse_ratio` times
+ * larger time step propagates the slice boundaries serially, and fine integrators with
+ * `time_step` integrate the slices in parallel on a thread pool. The boundaries are corrected by
+ * `x_(i+1) = G(x_i) + F(x_i) - G_old(x_i)` until they stop changing, which reaches the fine
+ * solution after at most `SLICE_DIM` iterations and typically after a few.
+ *
+ * `ode_fun` is called on `obj` from all threads concurrently, so it must not modify `obj`.
+ */
+template <size_t SLICE_DIM, size_t X_DIM, typename T> class Parareal
+{
+  public:
+	/*
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `time_step`: time step of the fine integrators [s]
+	 * 4. `coarse_ratio`: fine steps per coarse step
+	 * 5. `t_init`: initial time [s]
+	 * 6. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	Parareal(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T time_step,
+	         const size_t coarse_ratio, const Real_T t_init = 0,
+	         const Allocator &allocator = Allocator())
+	    : obj(obj), ode_fun(ode_fun), time_step(time_step),
+	      coarse_ratio(coarse_ratio > 0 ? coarse_ratio : 1), t_init(t_init),
+	      workspace(allocator)
+	{
+	}
+
+	/*
+	 * Solves over `T_DIM - 1` fine steps, which must be a multiple of `SLICE_DIM`.
+	 *
+	 * 1. `pool`: thread pool of the fine integrators
+	 * 2. `x_init`: initial state
+	 * 3. `tol`: tolerance of the largest change of a boundary, relative to the state
+	 * 4. `max_iter_dim`: maximum number of iterations
+	 *
+	 * OUT:
+	 * 5. `t_arr`: time of the slice boundaries [s]
+	 * 6. `x_arr`: state at the slice boundaries, `x_arr[SLICE_DIM]` is the final state
+	 * number of iterations, 0 if the workspace could not be allocated
+	 */
+	template <size_t T_DIM>
+	size_t
+	solve(ThreadPool &pool, const Real_T (&x_init)[X_DIM], Real_T (&t_arr)[SLICE_DIM + 1],
+	      Real_T (&x_arr)[SLICE_DIM + 1][X_DIM],
+	      const Real_T tol = std::sqrt(std::numeric_limits<Real_T>::epsilon()),
+	      const size_t max_iter_dim = SLICE_DIM)
+	{
+		static_assert((T_DIM - 1) % SLICE_DIM == 0,
+		              "the number of steps must be a multiple of the number of slices");
+		constexpr size_t slice_step_dim = (T_DIM - 1) / SLICE_DIM;
+
+		if (!is_good()) {
+			return 0;
+		}
+		Buffers &buf = workspace.get();
+		const size_t coarse_step_dim =
+		    slice_step_dim > coarse_ratio ? slice_step_dim / coarse_ratio : 1;
+		const Real_T coarse_time_step = slice_step_dim * time_step / coarse_step_dim;
+		Integrator<X_DIM, T> coarse_integrator(obj, ode_fun, coarse_time_step, t_init);
+
+		for (size_t i = 0; i <= SLICE_DIM; ++i) {
+			t_arr[i] = t_init + i * slice_step_dim * time_step;
+		}
+
+		//* iteration 0, serial coarse propagation
+		for (size_t j = 0; j < X_DIM; ++j) {
+			x_arr[0][j] = x_init[j];
+		}
+
+		for (size_t i = 0; i < SLICE_DIM; ++i) {
+			propagate(coarse_integrator, i * coarse_step_dim, coarse_step_dim, x_arr[i],
+			          buf.coarse[i]);
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				x_arr[i + 1][j] = buf.coarse[i][j];
+			}
+		}
+
+		TaskQueue queue(pool.get_thread_count());
+		size_t iter = 0;
+
+		//* after the iteration `k`, the first `k` slices are exact
+		while (iter < max_iter_dim && iter < SLICE_DIM) {
+			const size_t first_slice = iter;
+			++iter;
+
+			//* fine propagation of the slices in parallel
+			queue.reset(SLICE_DIM - first_slice);
+
+			auto work = [&](const size_t thread_idx) {
+				Integrator<X_DIM, T> integrator(obj, ode_fun, time_step, t_init);
+				size_t i;
+
+				while (queue.pop(thread_idx, i)) {
+					const size_t k = first_slice + i;
+					propagate(integrator, k * slice_step_dim, slice_step_dim,
+					          x_arr[k], buf.fine[k]);
+				}
+			};
+			pool.run(work);
+
+			//* serial coarse correction, x_(i+1) = G(x_i) + F(x_i) - G_old(x_i)
+			Real_T max_change = 0;
+
+			for (size_t i = first_slice; i < SLICE_DIM; ++i) {
+				propagate(coarse_integrator, i * coarse_step_dim, coarse_step_dim,
+				          x_arr[i], buf.x_temp);
+
+				for (size_t j = 0; j < X_DIM; ++j) {
+					const Real_T x_ij =
+					    buf.x_temp[j] + buf.fine[i][j] - buf.coarse[i][j];
+					const Real_T change = std::abs(x_ij - x_arr[i + 1][j]) /
+					                      std::fmax(std::abs(x_ij), Real_T(1));
+					max_change = std::fmax(max_change, change);
+					x_arr[i + 1][j] = x_ij;
+					buf.coarse[i][j] = buf.x_temp[j];
+				}
+			}
+
+			if (max_change <= tol) {
+				break;
+			}
+		}
+		return iter;
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+  private:
+	T &obj;
+	const OdeFun_T<X_DIM, T> ode_fun;
+	const Real_T time_step;
+	const size_t coarse_ratio;
+	const Real_T t_init;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T coarse[SLICE_DIM][X_DIM]; //* G_old(x_i)
+		alignas(cache_line_size) Real_T fine[SLICE_DIM][X_DIM];   //* F(x_i)
+		alignas(cache_line_size) Real_T x_temp[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	/*
+	 * Integrates `step_dim` steps from the step index `first_step` on the time grid of the
+	 * integrator, i.e. from `t_init + first_step*h`.
+	 */
+	void
+	propagate(Integrator<X_DIM, T> &integrator, const size_t first_step, const size_t step_dim,
+	          const Real_T (&x)[X_DIM], Real_T (&x_next)[X_DIM]) const
+	{
+		const Real_T h = integrator.get_step_size();
+		Real_T t_next;
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			x_next[j] = x[j];
+		}
+		integrator.reset();
+
+		for (size_t i = first_step; i < first_step + step_dim; ++i) {
+			//* the same time grid as `loop(...)`, t = t_init + i*h
+			integrator.step(t_init + i * h, x_next, t_next, x_next);
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
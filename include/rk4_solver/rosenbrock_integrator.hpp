@@ -0,0 +1,331 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ROSENBROCK_INTEGRATOR_HPP_CINARAL_261017_2125
+#define ROSENBROCK_INTEGRATOR_HPP_CINARAL_261017_2125
+
+#include "binding.hpp"
+#include "lu.hpp"
+#include "matrix_op.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace rk4_solver
+{
+/*
+ * Linearly implicit Rosenbrock integrator for stiff systems, using the 2nd order L-stable method
+ * ROS2 of Verwer et al.:
+ *
+ * `(I - gamma*h*J)*k_0 = ode_fun(t, x) + gamma*h*dt_f`
+ * `(I - gamma*h*J)*k_1 = ode_fun(t + h, x + h*k_0) - 2*k_0 - gamma*h*dt_f`
+ * `x_next = x + h*(3/2*k_0 + 1/2*k_1)`, `gamma = 1 + 1/sqrt(2)`
+ *
+ * `J` is the Jacobian of the ODE function, given by the user or approximated by finite
+ * differences, and `dt_f` is its time derivative, approximated by a finite difference. The method
+ * keeps its order for any `J`, so `J`, `dt_f` and the LU decomposition of `I - gamma*h*J` are
+ * reused for `jacobian_interval` steps. A step then costs two ODE function evaluations and two
+ * triangular solves.
+ */
+template <size_t X_DIM, typename T, typename Bind_T = MemberBinding<T, OdeFun_T<X_DIM, T>>>
+class RosenbrockIntegrator
+{
+  public:
+	static constexpr size_t order = 2;
+
+	/*
+	 * The Jacobian is approximated by finite differences.
+	 *
+	 * `is_good()` is false if a custom `allocator` fails or after a move, `step(...)` then
+	 * returns false.
+	 *
+	 * 1. `obj`: object of the ODE function
+	 * 2. `ode_fun`: ODE function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `jacobian_interval`: number of steps the Jacobian is reused for
+	 * 6. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	RosenbrockIntegrator(T &obj, OdeFun_T<X_DIM, T> ode_fun, const Real_T time_step,
+	                     const Real_T t_init = 0, const size_t jacobian_interval = 1,
+	                     const Allocator &allocator = Allocator())
+	    : ode_fun(obj, ode_fun), time_step(time_step), t_init(t_init),
+	      jacobian_interval(jacobian_interval), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, `step(...)` then
+	 * returns false.
+	 *
+	 * 1. `obj`: object of the ODE and Jacobian functions
+	 * 2. `ode_fun`: ODE function
+	 * 3. `jacobian_fun`: Jacobian of the ODE function
+	 * 4. `time_step`: time step [s]
+	 * 5. `t_init`: initial time [s]
+	 * 6. `jacobian_interval`: number of steps the Jacobian is reused for
+	 * 7. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	RosenbrockIntegrator(T &obj, OdeFun_T<X_DIM, T> ode_fun,
+	                     JacobianFun_T<X_DIM, T> jacobian_fun, const Real_T time_step,
+	                     const Real_T t_init = 0, const size_t jacobian_interval = 1,
+	                     const Allocator &allocator = Allocator())
+	    : ode_fun(obj, ode_fun), obj(&obj), jacobian_fun(jacobian_fun), time_step(time_step),
+	      t_init(t_init), jacobian_interval(jacobian_interval), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * The Jacobian is approximated by finite differences.
+	 *
+	 * `is_good()` is false if a custom `allocator` fails or after a move, `step(...)` then
+	 * returns false.
+	 *
+	 * 1. `ode_fun`: binding of the ODE function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `jacobian_interval`: number of steps the Jacobian is reused for
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	RosenbrockIntegrator(Bind_T ode_fun, const Real_T time_step, const Real_T t_init = 0,
+	                     const size_t jacobian_interval = 1,
+	                     const Allocator &allocator = Allocator())
+	    : ode_fun(std::move(ode_fun)), time_step(time_step), t_init(t_init),
+	      jacobian_interval(jacobian_interval), workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 * false if `I - gamma*h*J` is singular or `is_good()` is false, `t_next` and `x_next` are
+	 * then not modified
+	 */
+	bool
+	step(const Real_T &t, const Real_T (&x)[X_DIM], Real_T &t_next, Real_T (&x_next)[X_DIM])
+	{
+		if (!is_good()) {
+			return false;
+		}
+		Buffers &buf = workspace.get();
+		//* local copy, since the stores to the buffers could alias the member
+		const Real_T h = time_step;
+
+		//* f = ode_fun(t, x)
+		ode_fun(t, x, buf.f);
+
+		if (steps_since_jacobian >= jacobian_interval) {
+			if (!update_decomposition(t, x, h, buf)) {
+				return false;
+			}
+			steps_since_jacobian = 0;
+		}
+		++steps_since_jacobian;
+
+		//* W*k_0 = f + gamma*h*dt_f
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.f[i] += buf.gamma_dt_f[i];
+		}
+		lu_solve(buf.lu, buf.pivot, buf.f, buf.k_0);
+
+		//* W*k_1 = ode_fun(t + h, x + h*k_0) - 2*k_0 - gamma*h*dt_f
+		matrix_op::weighted_sum(h, buf.k_0, 1., x, buf.x_temp);
+		ode_fun(t + h, buf.x_temp, buf.f);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.f[i] -= 2 * buf.k_0[i] + buf.gamma_dt_f[i];
+		}
+		lu_solve(buf.lu, buf.pivot, buf.f, buf.k_1);
+
+		constexpr Real_T w0 = 3. / 2.;
+		constexpr Real_T w1 = 1. / 2.;
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			const Real_T dx_i = h * (w0 * buf.k_0[i] + w1 * buf.k_1[i]);
+			//* compensated (Kahan) summation, ffast-math might break this
+			const Real_T compensated_dx_i = dx_i - buf.accumulator[i];
+			const Real_T x_next_i = x[i] + compensated_dx_i;
+			buf.accumulator[i] = (x_next_i - x[i]) - compensated_dx_i;
+			x_next[i] = x_next_i;
+		}
+
+		t_next = t_init + (step_counter + 1) * time_step;
+		++step_counter;
+		return true;
+	}
+
+	//* recomputes the Jacobian at the next step, e.g. after a discontinuity of the ODE function
+	void
+	update_jacobian()
+	{
+		steps_since_jacobian = jacobian_interval;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+		update_jacobian();
+
+		if (is_good()) {
+			Buffers &buf = workspace.get();
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				buf.accumulator[i] = 0;
+			}
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	Bind_T ode_fun;
+	T *obj = nullptr;
+	JacobianFun_T<X_DIM, T> jacobian_fun = nullptr;
+	const Real_T time_step;
+	const Real_T t_init;
+	const size_t jacobian_interval;
+	size_t step_counter;
+	size_t steps_since_jacobian;
+
+	static constexpr Real_T gamma = 1.7071067811865475244; //* 1 + 1/sqrt(2)
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T lu[X_DIM][X_DIM];
+		alignas(cache_line_size) size_t pivot[X_DIM];
+		alignas(cache_line_size) Real_T gamma_dt_f[X_DIM];
+		alignas(cache_line_size) Real_T f[X_DIM];
+		alignas(cache_line_size) Real_T k_0[X_DIM];
+		alignas(cache_line_size) Real_T k_1[X_DIM];
+		alignas(cache_line_size) Real_T x_temp[X_DIM];
+		alignas(cache_line_size) Real_T accumulator[X_DIM];
+	};
+	Workspace<Buffers> workspace;
+
+	/*
+	 * Computes the Jacobian at `(t, x)` into `lu` and the time derivative `gamma*h*dt_f`,
+	 * forms `W = I - gamma*h*J` and decomposes it. `f` must hold `ode_fun(t, x)`. Returns
+	 * false if `W` is singular.
+	 */
+	bool
+	update_decomposition(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T h,
+	                     Buffers &buf)
+	{
+		if (jacobian_fun != nullptr) {
+			(obj->*jacobian_fun)(t, x, buf.lu);
+		} else {
+			compute_jacobian(t, x, buf);
+		}
+		compute_time_derivative(t, x, h, buf);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			for (size_t j = 0; j < X_DIM; ++j) {
+				buf.lu[i][j] *= -gamma * h;
+			}
+			buf.lu[i][i] += 1;
+		}
+		return lu_decompose(buf.lu, buf.pivot);
+	}
+
+	/*
+	 * Forward difference approximation of `gamma*h*dt_f`, `k_1` is used as scratch.
+	 */
+	void
+	compute_time_derivative(const Real_T &t, const Real_T (&x)[X_DIM], const Real_T h,
+	                        Buffers &buf)
+	{
+		const Real_T sqrt_eps = std::sqrt(std::numeric_limits<Real_T>::epsilon());
+		const Real_T t_plus = t + sqrt_eps * std::fmax(std::abs(t), Real_T(1));
+		const Real_T delta = t_plus - t;
+
+		ode_fun(t_plus, x, buf.k_1);
+
+		for (size_t i = 0; i < X_DIM; ++i) {
+			buf.gamma_dt_f[i] = gamma * h * (buf.k_1[i] - buf.f[i]) / delta;
+		}
+	}
+
+	/*
+	 * Forward difference approximation of the Jacobian, one ODE function evaluation per column.
+	 * `x_temp` and `k_1` are used as scratch.
+	 */
+	void
+	compute_jacobian(const Real_T &t, const Real_T (&x)[X_DIM], Buffers &buf)
+	{
+		const Real_T sqrt_eps = std::sqrt(std::numeric_limits<Real_T>::epsilon());
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			buf.x_temp[j] = x[j];
+		}
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			const Real_T x_j = x[j];
+			//* rounded, so that the perturbation is the exact difference of the states
+			const Real_T x_j_plus =
+			    x_j + sqrt_eps * std::fmax(std::abs(x_j), Real_T(1));
+			const Real_T delta = x_j_plus - x_j;
+
+			buf.x_temp[j] = x_j_plus;
+			ode_fun(t, buf.x_temp, buf.k_1);
+			buf.x_temp[j] = x_j;
+
+			for (size_t i = 0; i < X_DIM; ++i) {
+				buf.lu[i][j] = (buf.k_1[i] - buf.f[i]) / delta;
+			}
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
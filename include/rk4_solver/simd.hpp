@@ -0,0 +1,344 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SIMD_HPP_CINARAL_261017_1600
+#define SIMD_HPP_CINARAL_261017_1600
+
+#include "types.hpp"
+#include <cstring>
+#include <type_traits>
+
+/*
+ * Vectorized kernels of the stage arithmetic of `Integrator`, with SSE2, AVX2 and AVX-512 versions
+ * that are selected at run time by the features of the CPU, so that a binary built for the
+ * baseline x86-64 uses the widest registers of the CPU it runs on. The kernels are written with
+ * the vector extensions of GCC and Clang, and do the same operations in the same order as the
+ * scalar loops. The compiler may contract the multiply-adds of the AVX-512 kernels into fused
+ * ones, which changes the results in the last bits unless `-ffp-contract=off`. Other compilers and
+ * architectures, and `DO_NOT_USE_SIMD` fall back to the scalar loops.
+ */
+
+#if !defined(DO_NOT_USE_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define RK4_SOLVER_USE_SIMD
+#endif
+
+namespace rk4_solver
+{
+namespace simd
+{
+//* instruction sets of the kernels, in increasing order of width
+enum class Isa { scalar, sse2, avx2, avx512 };
+
+//* smallest state dimension for which `Integrator` calls the kernels instead of its inlined loops
+constexpr size_t min_dim = 256;
+
+//* widest instruction set that the CPU and the OS support
+inline Isa
+detect_isa()
+{
+#ifdef RK4_SOLVER_USE_SIMD
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f")) {
+		return Isa::avx512;
+	} else if (__builtin_cpu_supports("avx2")) {
+		return Isa::avx2;
+	} else if (__builtin_cpu_supports("sse2")) {
+		return Isa::sse2;
+	}
+#endif
+	return Isa::scalar;
+}
+
+namespace detail
+{
+inline Isa &
+get_selected_isa()
+{
+	static Isa isa = detect_isa(); //* detected once, on the first use
+	return isa;
+}
+} // namespace detail
+
+//* instruction set of the kernels, `Isa::scalar` keeps the inlined loops of the integrators
+inline Isa
+get_isa()
+{
+	return detail::get_selected_isa();
+}
+
+/*
+ * Selects the instruction set of the kernels, e.g. to compare them. Returns false and changes
+ * nothing if the CPU does not support it. Not thread-safe, call it before integrating.
+ */
+inline bool
+set_isa(const Isa isa)
+{
+	if (isa > detect_isa()) {
+		return false;
+	}
+	detail::get_selected_isa() = isa;
+	return true;
+}
+
+inline const char *
+get_isa_name(const Isa isa)
+{
+	switch (isa) {
+	case Isa::sse2:
+		return "sse2";
+	case Isa::avx2:
+		return "avx2";
+	case Isa::avx512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}
+
+//* true if `R` has vectorized kernels
+template <typename R>
+constexpr bool is_vectorized =
+    std::is_same<R, float>::value || std::is_same<R, double>::value;
+
+namespace detail
+{
+//* x_stage = x + a * k, the scalar loop is also the tail of the vectorized ones
+template <typename R>
+inline void
+stage_input_scalar(const size_t begin, const size_t n, const R *x, const R a, const R *k,
+                   R *x_stage)
+{
+	for (size_t i = begin; i < n; ++i) {
+		x_stage[i] = a * k[i] + x[i];
+	}
+}
+
+/*
+ * x_next = x + h * (k_0 + 2 * k_1 + 2 * k_2 + k_3) / 6 with Kahan's compensation `c`, the same
+ * arithmetic as `summation::Kahan`
+ */
+template <typename R>
+inline void
+kahan_update_scalar(const size_t begin, const size_t n, const R *x, const R h, const R *k_0,
+                    const R *k_1, const R *k_2, const R *k_3, R *c, R *x_next)
+{
+	constexpr R w0 = 1. / 6.;
+	constexpr R w1 = 1. / 3.;
+
+	for (size_t i = begin; i < n; ++i) {
+		const R dx_i = h * (w0 * k_0[i] + w1 * k_1[i] + w1 * k_2[i] + w0 * k_3[i]);
+		const R compensated_dx_i = dx_i - c[i];
+		const R x_i = x[i];
+		x_next[i] = x_i + compensated_dx_i;
+		c[i] = (x_next[i] - x_i) - compensated_dx_i;
+	}
+}
+
+#ifdef RK4_SOLVER_USE_SIMD
+//* vector of `BYTE_DIM / sizeof(R)` elements
+template <typename R, size_t BYTE_DIM> struct Vector {
+	typedef R Type __attribute__((vector_size(BYTE_DIM)));
+};
+
+template <typename V>
+__attribute__((always_inline)) inline void
+load(V &v, const void *ptr)
+{
+	std::memcpy(&v, ptr, sizeof(V)); //* unaligned load
+}
+
+template <typename V>
+__attribute__((always_inline)) inline void
+store(void *ptr, const V &v)
+{
+	std::memcpy(ptr, &v, sizeof(V)); //* unaligned store
+}
+
+//* the bodies are inlined into the wrappers of each instruction set below
+template <typename V, typename R>
+__attribute__((always_inline)) inline void
+stage_input_vector(const size_t n, const R *x, const R a, const R *k, R *x_stage)
+{
+	constexpr size_t lane_dim = sizeof(V) / sizeof(R);
+	const size_t vector_n = n - n % lane_dim;
+	size_t i = 0;
+
+	for (; i < vector_n; i += lane_dim) {
+		V x_i, k_i;
+		load(x_i, x + i);
+		load(k_i, k + i);
+		store(x_stage + i, a * k_i + x_i);
+	}
+	stage_input_scalar(i, n, x, a, k, x_stage);
+}
+
+template <typename V, typename R>
+__attribute__((always_inline)) inline void
+kahan_update_vector(const size_t n, const R *x, const R h, const R *k_0, const R *k_1,
+                    const R *k_2, const R *k_3, R *c, R *x_next)
+{
+	constexpr size_t lane_dim = sizeof(V) / sizeof(R);
+	constexpr R w0 = 1. / 6.;
+	constexpr R w1 = 1. / 3.;
+	const size_t vector_n = n - n % lane_dim;
+	size_t i = 0;
+
+	for (; i < vector_n; i += lane_dim) {
+		V x_i, k_0_i, k_1_i, k_2_i, k_3_i, c_i;
+		load(x_i, x + i);
+		load(k_0_i, k_0 + i);
+		load(k_1_i, k_1 + i);
+		load(k_2_i, k_2 + i);
+		load(k_3_i, k_3 + i);
+		load(c_i, c + i);
+
+		const V dx_i = h * (w0 * k_0_i + w1 * k_1_i + w1 * k_2_i + w0 * k_3_i);
+		const V compensated_dx_i = dx_i - c_i;
+		const V x_next_i = x_i + compensated_dx_i;
+		store(c + i, (x_next_i - x_i) - compensated_dx_i);
+		store(x_next + i, x_next_i);
+	}
+	kahan_update_scalar(i, n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+}
+
+template <typename R>
+__attribute__((target("sse2"))) void
+stage_input_sse2(const size_t n, const R *x, const R a, const R *k, R *x_stage)
+{
+	stage_input_vector<typename Vector<R, 16>::Type>(n, x, a, k, x_stage);
+}
+
+template <typename R>
+__attribute__((target("avx2"))) void
+stage_input_avx2(const size_t n, const R *x, const R a, const R *k, R *x_stage)
+{
+	stage_input_vector<typename Vector<R, 32>::Type>(n, x, a, k, x_stage);
+}
+
+template <typename R>
+__attribute__((target("avx512f"))) void
+stage_input_avx512(const size_t n, const R *x, const R a, const R *k, R *x_stage)
+{
+	stage_input_vector<typename Vector<R, 64>::Type>(n, x, a, k, x_stage);
+}
+
+template <typename R>
+__attribute__((target("sse2"))) void
+kahan_update_sse2(const size_t n, const R *x, const R h, const R *k_0, const R *k_1,
+                  const R *k_2, const R *k_3, R *c, R *x_next)
+{
+	kahan_update_vector<typename Vector<R, 16>::Type>(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+}
+
+template <typename R>
+__attribute__((target("avx2"))) void
+kahan_update_avx2(const size_t n, const R *x, const R h, const R *k_0, const R *k_1,
+                  const R *k_2, const R *k_3, R *c, R *x_next)
+{
+	kahan_update_vector<typename Vector<R, 32>::Type>(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+}
+
+template <typename R>
+__attribute__((target("avx512f"))) void
+kahan_update_avx512(const size_t n, const R *x, const R h, const R *k_0, const R *k_1,
+                    const R *k_2, const R *k_3, R *c, R *x_next)
+{
+	kahan_update_vector<typename Vector<R, 64>::Type>(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+}
+#endif
+} // namespace detail
+
+/*
+ * Computes the input of a stage with the selected instruction set.
+ *
+ * 1. `n`: number of elements
+ * 2. `x`: state
+ * 3. `a`: weight of the slope
+ * 4. `k`: slope
+ *
+ * OUT:
+ * 5. `x_stage`: `x + a * k`
+ */
+template <typename R>
+void
+stage_input(const size_t n, const R *x, const R a, const R *k, R *x_stage)
+{
+#ifdef RK4_SOLVER_USE_SIMD
+	if constexpr (is_vectorized<R>) {
+		switch (get_isa()) {
+		case Isa::avx512:
+			return detail::stage_input_avx512(n, x, a, k, x_stage);
+		case Isa::avx2:
+			return detail::stage_input_avx2(n, x, a, k, x_stage);
+		case Isa::sse2:
+			return detail::stage_input_sse2(n, x, a, k, x_stage);
+		default:
+			break;
+		}
+	}
+#endif
+	detail::stage_input_scalar(0, n, x, a, k, x_stage);
+}
+
+/*
+ * Computes the Runge-Kutta 4th Order update with Kahan's compensated summation with the selected
+ * instruction set. `x_next` may be `x`.
+ *
+ * 1. `n`: number of elements
+ * 2. `x`: state
+ * 3. `h`: step size [s]
+ * 4. `k_0`, ..., 7. `k_3`: slopes of the stages
+ * 8. `c`: compensations, updated
+ *
+ * OUT:
+ * 9. `x_next`: next state
+ */
+template <typename R>
+void
+kahan_update(const size_t n, const R *x, const R h, const R *k_0, const R *k_1, const R *k_2,
+             const R *k_3, R *c, R *x_next)
+{
+#ifdef RK4_SOLVER_USE_SIMD
+	if constexpr (is_vectorized<R>) {
+		switch (get_isa()) {
+		case Isa::avx512:
+			return detail::kahan_update_avx512(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+		case Isa::avx2:
+			return detail::kahan_update_avx2(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+		case Isa::sse2:
+			return detail::kahan_update_sse2(n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+		default:
+			break;
+		}
+	}
+#endif
+	detail::kahan_update_scalar(0, n, x, h, k_0, k_1, k_2, k_3, c, x_next);
+}
+} // namespace simd
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SINK_HPP_CINARAL_261017_1415
+#define SINK_HPP_CINARAL_261017_1415
+
+#include "trajectory.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <cstdio>
+
+/*
+ * Sinks for streaming integration results in fixed-size chunks. A sink exposes its chunk size as
+ * `chunk_dim` and has the member function:
+ *
+ * void write(const Real_T (&t)[chunk_dim], const Real_T (&x)[chunk_dim][X_DIM], size_t count);
+ *
+ * where only the first `count` rows of the chunk are valid.
+ */
+
+namespace rk4_solver
+{
+template <size_t C_DIM, size_t X_DIM, typename T>
+using SinkFun_T = void (T::*)(const Real_T (&t)[C_DIM], const Real_T (&x)[C_DIM][X_DIM],
+                              const size_t count);
+
+/*
+ * Passes the chunks to a callback.
+ */
+template <size_t C_DIM, size_t X_DIM, typename T> class CallbackSink
+{
+  public:
+	static constexpr size_t chunk_dim = C_DIM;
+
+	CallbackSink(T &obj, SinkFun_T<C_DIM, X_DIM, T> sink_fun) : obj(obj), sink_fun(sink_fun)
+	{
+	}
+
+	void
+	write(const Real_T (&t)[C_DIM], const Real_T (&x)[C_DIM][X_DIM], const size_t count)
+	{
+		(obj.*sink_fun)(t, x, count);
+	}
+
+  private:
+	T &obj;
+	const SinkFun_T<C_DIM, X_DIM, T> sink_fun;
+};
+
+/*
+ * Keeps the last `R_DIM` samples in a ring buffer.
+ */
+template <size_t R_DIM, size_t C_DIM, size_t X_DIM> class RingBufferSink
+{
+  public:
+	static constexpr size_t chunk_dim = C_DIM;
+
+	explicit RingBufferSink(const Allocator &allocator = Allocator()) : workspace(allocator)
+	{
+		reset();
+	}
+
+	void
+	write(const Real_T (&t)[C_DIM], const Real_T (&x)[C_DIM][X_DIM], const size_t count)
+	{
+		if (!is_good()) {
+			return;
+		}
+		Buffers &buf = workspace.get();
+
+		for (size_t i = 0; i < count; ++i) {
+			const size_t idx = (head + i) % R_DIM;
+			buf.t[idx] = t[i];
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				buf.x[idx][j] = x[i][j];
+			}
+		}
+		head = (head + count) % R_DIM;
+		sample_count += count;
+	}
+
+	void
+	reset()
+	{
+		head = 0;
+		sample_count = 0;
+	}
+
+	//* number of samples in the buffer
+	size_t
+	get_count() const
+	{
+		return sample_count < R_DIM ? sample_count : R_DIM;
+	}
+
+	//* true if the buffer could be allocated, the sink does not count the samples otherwise
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	//* number of samples written since the last reset
+	size_t
+	get_total_count() const
+	{
+		return sample_count;
+	}
+
+	/*
+	 * Gets the `i`th oldest sample in the buffer.
+	 *
+	 * 1. `i`: sample index, from 0 to `get_count() - 1`
+	 *
+	 * OUT:
+	 * 2. `t`: time [s]
+	 * 3. `x`: state
+	 */
+	void
+	get(const size_t i, Real_T &t, Real_T (&x)[X_DIM]) const
+	{
+		const Buffers &buf = workspace.get();
+		const size_t idx = (head + R_DIM - get_count() + i) % R_DIM;
+		t = buf.t[idx];
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			x[j] = buf.x[idx][j];
+		}
+	}
+
+  private:
+	size_t head;
+	size_t sample_count;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T t[R_DIM];
+		alignas(cache_line_size) Real_T x[R_DIM][X_DIM];
+	};
+	Workspace<Buffers> workspace;
+};
+
+/*
+ * Writes the samples to a binary trajectory file (see trajectory.hpp), which can be read back
+ * with `TrajectoryReader`. The number of samples in the header is updated when the file is closed.
+ */
+template <size_t C_DIM, size_t X_DIM> class FileSink
+{
+  public:
+	static constexpr size_t chunk_dim = C_DIM;
+
+	/*
+	 * 1. fname: file name
+	 * 2. t_init: initial time recorded in the header
+	 * 3. time_step: time step between the samples (including decimation), 0 if not uniform
+	 */
+	explicit FileSink(const char *fname, const Real_T t_init = 0, const Real_T time_step = 0)
+	    : file(std::fopen(fname, "wb")), has_error(file == nullptr)
+	{
+		make_trajectory_header(X_DIM, 0, t_init, time_step, header);
+		write_header();
+	}
+
+	~FileSink()
+	{
+		close();
+	}
+
+	FileSink(const FileSink &) = delete;
+	FileSink &operator=(const FileSink &) = delete;
+
+	void
+	write(const Real_T (&t)[C_DIM], const Real_T (&x)[C_DIM][X_DIM], const size_t count)
+	{
+		if (file == nullptr) {
+			return;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			row[0] = t[i];
+
+			for (size_t j = 0; j < X_DIM; ++j) {
+				row[j + 1] = x[i][j];
+			}
+			if (std::fwrite(row, sizeof(Real_T), X_DIM + 1, file) != X_DIM + 1) {
+				has_error = true;
+			}
+		}
+		header.t_dim += count;
+	}
+
+	void
+	close()
+	{
+		if (file != nullptr) {
+			if (std::fseek(file, 0, SEEK_SET) != 0) {
+				has_error = true;
+			}
+			write_header();
+
+			if (std::fclose(file) != 0) {
+				has_error = true;
+			}
+			file = nullptr;
+		}
+	}
+
+	//* true if the file could be opened and all samples were written
+	bool
+	is_good() const
+	{
+		return !has_error;
+	}
+
+  private:
+	std::FILE *file;
+	bool has_error;
+	TrajectoryHeader header;
+	Real_T row[X_DIM + 1];
+
+	void
+	write_header()
+	{
+		if (file == nullptr) {
+			return;
+		}
+		if (std::fwrite(&header, sizeof(TrajectoryHeader), 1, file) != 1) {
+			has_error = true;
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SUMMATION_HPP_CINARAL_261017_1530
+#define SUMMATION_HPP_CINARAL_261017_1530
+
+#include "types.hpp"
+#include <cmath>
+
+/*
+ * Summation policies of the state update `x_next = x + dx` of `Integrator`. Over many steps, the
+ * increments are much smaller than the state and their low order bits are lost, which these
+ * policies recover to a different degree. A policy is a type with, for a scalar type `R`:
+ * 1. `Accumulator<R>`: trivially copyable state of a single element, carried from step to step
+ * 2. `static void reset(Accumulator<R> &acc)`: clears the state
+ * 3. `static R add(const R x, const R dx, Accumulator<R> &acc)`: returns `x + dx`
+ *
+ * The compensations rely on the exact rounding of each operation, which `-ffast-math` breaks.
+ */
+
+namespace rk4_solver
+{
+namespace summation
+{
+//* plain `x + dx`, the fastest and least accurate
+struct None {
+	template <typename R> struct Accumulator {
+	};
+
+	template <typename R>
+	static void
+	reset(Accumulator<R> &)
+	{
+	}
+
+	template <typename R>
+	static R
+	add(const R x, const R dx, Accumulator<R> &)
+	{
+		return x + dx;
+	}
+};
+
+//* Kahan's compensated summation, which is exact while the increments are smaller than the state
+struct Kahan {
+	template <typename R> struct Accumulator {
+		R c; //* negative of the part of the last increment that was lost
+	};
+
+	template <typename R>
+	static void
+	reset(Accumulator<R> &acc)
+	{
+		acc.c = 0;
+	}
+
+	template <typename R>
+	static R
+	add(const R x, const R dx, Accumulator<R> &acc)
+	{
+		const R compensated_dx = dx - acc.c;
+		const R x_next = x + compensated_dx;
+		acc.c = (x_next - x) - compensated_dx;
+		return x_next;
+	}
+};
+
+/*
+ * Neumaier's variant of Kahan's summation, which computes the rounding error of `x + dx` from the
+ * larger of the two and adds it to the result instead of the next increment, so that it is also
+ * exact when an increment is larger than the state, e.g. after the state crosses zero.
+ */
+struct Neumaier {
+	template <typename R> struct Accumulator {
+		R c; //* the part of the sum that is not in the state
+	};
+
+	template <typename R>
+	static void
+	reset(Accumulator<R> &acc)
+	{
+		acc.c = 0;
+	}
+
+	template <typename R>
+	static R
+	add(const R x, const R dx, Accumulator<R> &acc)
+	{
+		const bool is_x_larger = std::abs(x) >= std::abs(dx);
+		const R larger = is_x_larger ? x : dx;
+		const R smaller = is_x_larger ? dx : x;
+		const R s = x + dx;
+		const R c = acc.c + ((larger - s) + smaller);
+		const R x_next = s + c;
+		acc.c = c - (x_next - s);
+		return x_next;
+	}
+};
+
+/*
+ * Carries the state as the unevaluated sum `hi + lo` of two `R`, i.e. double-double in double
+ * precision and float-float, which is about as accurate as double, in single precision. The
+ * increments are added with the error-free TwoSum, so nothing is lost up to twice the precision
+ * of `R`. The low part is dropped if the state was modified between the steps.
+ */
+struct DoubleDouble {
+	template <typename R> struct Accumulator {
+		R hi; //* the last result, to detect a modified state
+		R lo;
+	};
+
+	template <typename R>
+	static void
+	reset(Accumulator<R> &acc)
+	{
+		acc.hi = 0;
+		acc.lo = 0;
+	}
+
+	template <typename R>
+	static R
+	add(const R x, const R dx, Accumulator<R> &acc)
+	{
+		const R lo = x == acc.hi ? acc.lo : 0;
+
+		//* TwoSum: s + e = x + dx exactly
+		const R s = x + dx;
+		const R dx_virtual = s - x;
+		const R e = (x - (s - dx_virtual)) + (dx - dx_virtual) + lo;
+
+		//* FastTwoSum: renormalize so that lo is below the last bit of hi
+		acc.hi = s + e;
+		acc.lo = e - (acc.hi - s);
+		return acc.hi;
+	}
+};
+
+/*
+ * Mixed precision: the state is stored as `R` but accumulated in the wider type `W`, e.g. a float
+ * state with a double accumulator, `Widened<double>`. The accumulated value is restarted from the
+ * state if the state was modified between the steps.
+ */
+template <typename W> struct Widened {
+	template <typename R> struct Accumulator {
+		W x;
+		R x_last; //* the last result, to detect a modified state
+	};
+
+	template <typename R>
+	static void
+	reset(Accumulator<R> &acc)
+	{
+		acc.x = 0;
+		acc.x_last = 0;
+	}
+
+	template <typename R>
+	static R
+	add(const R x, const R dx, Accumulator<R> &acc)
+	{
+		if (x != acc.x_last) {
+			acc.x = x;
+		}
+		acc.x += static_cast<W>(dx);
+		acc.x_last = static_cast<R>(acc.x);
+		return acc.x_last;
+	}
+};
+} // namespace summation
+} // namespace rk4_solver
+
+#endif
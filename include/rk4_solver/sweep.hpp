@@ -0,0 +1,128 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SWEEP_HPP_CINARAL_261017_1040
+#define SWEEP_HPP_CINARAL_261017_1040
+
+#include "event.hpp"
+#include "integrator.hpp"
+#include "loop.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+
+namespace rk4_solver
+{
+/*
+ * Runs `loop<T_DIM>` for `TASK_DIM` instances of the same model on all threads of `pool`, e.g. for
+ * parameter sweeps or Monte Carlo runs. For each task `i`, the instance is created as
+ * `factory(param_gen(i))` and the final time and state are saved to the slot `i` of `t` and `x`.
+ * `T` must be default constructible and assignable, each thread keeps one instance and one
+ * integrator for all of its tasks, so nothing is allocated per task. `param_gen` and `factory`
+ * are shared by the threads and called concurrently, so they must be thread-safe, e.g. const
+ * callables that only read shared data. The task order is not defined, so `param_gen(i)` should
+ * only depend on `i`, e.g. seed a random generator with `i` instead of drawing from a shared one.
+ *
+ * 1. `pool`: thread pool
+ * 2. `param_gen`: thread-safe generator, `param_gen(i)` returns the parameters of the task `i`
+ * 3. `factory`: thread-safe model factory, `factory(param)` returns a `T` object for `param`
+ * 4. `ode_fun`: ODE function of `T`
+ * 5. `time_step`: time step [s]
+ * 6. `t_init`: initial time [s]
+ * 7. `x_init`: initial state
+ *
+ * OUT:
+ * 8. `t`: final time of each task [s]
+ * 9. `x`: final state of each task
+ */
+template <size_t T_DIM, size_t TASK_DIM, size_t X_DIM, typename T, typename ParamGen_T,
+          typename Factory_T>
+void
+sweep(ThreadPool &pool, const ParamGen_T &param_gen, const Factory_T &factory,
+      OdeFun_T<X_DIM, T> ode_fun,
+      const Real_T time_step, const Real_T &t_init, const Real_T (&x_init)[X_DIM],
+      Real_T (&t)[TASK_DIM], Real_T (&x)[TASK_DIM][X_DIM])
+{
+	TaskQueue queue(pool.get_thread_count());
+	queue.reset(TASK_DIM);
+
+	auto work = [&](const size_t thread_idx) {
+		T obj;
+		Integrator<X_DIM, T> integrator(obj, ode_fun, time_step, t_init);
+		size_t i;
+
+		while (queue.pop(thread_idx, i)) {
+			obj = factory(param_gen(i));
+			loop<T_DIM>(integrator, t_init, x_init, t[i], x[i]);
+		}
+	};
+	pool.run(work);
+}
+
+/*
+ * Runs `loop<T_DIM>` with events for `TASK_DIM` instances of the same model on all threads of
+ * `pool`, see above. `event_fun` can be used to modify x when certain conditions are met.
+ *
+ * 1. `pool`: thread pool
+ * 2. `param_gen`: thread-safe generator, `param_gen(i)` returns the parameters of the task `i`
+ * 3. `factory`: thread-safe model factory, `factory(param)` returns a `T` object for `param`
+ * 4. `ode_fun`: ODE function of `T`
+ * 5. `event_fun`: event function of `T`
+ * 6. `time_step`: time step [s]
+ * 7. `t_init`: initial time [s]
+ * 8. `x_init`: initial state
+ *
+ * OUT:
+ * 9. `t`: final time of each task [s]
+ * 10. `x`: final state of each task
+ */
+template <size_t T_DIM, size_t TASK_DIM, size_t X_DIM, typename T, typename ParamGen_T,
+          typename Factory_T>
+void
+sweep(ThreadPool &pool, const ParamGen_T &param_gen, const Factory_T &factory,
+      OdeFun_T<X_DIM, T> ode_fun,
+      EventFun_T<X_DIM, T> event_fun, const Real_T time_step, const Real_T &t_init,
+      const Real_T (&x_init)[X_DIM], Real_T (&t)[TASK_DIM], Real_T (&x)[TASK_DIM][X_DIM],
+      bool halt_on_event = false)
+{
+	TaskQueue queue(pool.get_thread_count());
+	queue.reset(TASK_DIM);
+
+	auto work = [&](const size_t thread_idx) {
+		T obj;
+		Integrator<X_DIM, T> integrator(obj, ode_fun, time_step, t_init);
+		Event<X_DIM, T> event(obj, event_fun);
+		size_t i;
+
+		while (queue.pop(thread_idx, i)) {
+			obj = factory(param_gen(i));
+			loop<T_DIM>(integrator, event, t_init, x_init, t[i], x[i], halt_on_event);
+		}
+	};
+	pool.run(work);
+}
+} // namespace rk4_solver
+
+#endif
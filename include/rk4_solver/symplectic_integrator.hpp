@@ -0,0 +1,267 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SYMPLECTIC_INTEGRATOR_HPP_CINARAL_261017_2210
+#define SYMPLECTIC_INTEGRATOR_HPP_CINARAL_261017_2210
+
+#include "binding.hpp"
+#include "types.hpp"
+#include "workspace.hpp"
+#include <utility>
+
+/*
+ * Compositions of the velocity Verlet step. A step of size `h` is `stage_dim` velocity Verlet
+ * steps of sizes `w[0]*h, ..., w[stage_dim - 1]*h`.
+ */
+
+namespace rk4_solver
+{
+namespace symplectic
+{
+//* velocity Verlet, 2nd order
+struct Verlet {
+	static constexpr size_t stage_dim = 1;
+	static constexpr size_t order = 2;
+	static constexpr Real_T w[stage_dim] = {1.};
+};
+
+//* Yoshida's symmetric composition of velocity Verlet, 4th order
+struct Yoshida4 {
+	static constexpr size_t stage_dim = 3;
+	static constexpr size_t order = 4;
+	//* w_1 = 1/(2 - 2^(1/3)), w_0 = -2^(1/3)/(2 - 2^(1/3))
+	static constexpr Real_T w[stage_dim] = {1.3512071919596578, -1.7024143839193155,
+	                                        1.3512071919596578};
+};
+} // namespace symplectic
+
+/*
+ * Integrator of the second order system `dt_dt_q = a(t, q, dt_q)` with the velocity Verlet method
+ * or its composition `Method_T` (see `symplectic`). The state is `x = [q; v]`, i.e. `x[i]` is the
+ * position `q_i` and `x[Q_DIM + i]` is the velocity `v_i`, so that it can be used with `loop(...)`
+ * and `Event` like the other integrators.
+ *
+ * The acceleration at the end of a step is reused at the start of the next step if the state was
+ * not modified in between, e.g. by an event, so that a step costs `stage_dim` evaluations of the
+ * acceleration function. If the acceleration depends on the velocity, the velocity at the end of
+ * a stage is predicted with the acceleration at its start. The methods are symplectic and have
+ * their order for accelerations that do not depend on the velocity, otherwise they are 2nd order.
+ */
+template <size_t Q_DIM, typename T, typename Method_T = symplectic::Verlet,
+          typename Bind_T = MemberBinding<T, AccelerationFun_T<Q_DIM, T>>>
+class SymplecticIntegrator
+{
+  public:
+	static constexpr size_t x_dim = 2 * Q_DIM;
+	static constexpr size_t stage_dim = Method_T::stage_dim;
+	static constexpr size_t order = Method_T::order;
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `obj`: object of the acceleration function
+	 * 2. `acceleration_fun`: acceleration function
+	 * 3. `time_step`: time step [s]
+	 * 4. `t_init`: initial time [s]
+	 * 5. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	SymplecticIntegrator(T &obj, AccelerationFun_T<Q_DIM, T> acceleration_fun,
+	                     const Real_T time_step, const Real_T t_init = 0,
+	                     const Allocator &allocator = Allocator())
+	    : acceleration_fun(obj, acceleration_fun), time_step(time_step), t_init(t_init),
+	      workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * `is_good()` is false if a custom `allocator` fails or after a move, the steps then
+	 * hold the state.
+	 *
+	 * 1. `acceleration_fun`: binding of the acceleration function
+	 * 2. `time_step`: time step [s]
+	 * 3. `t_init`: initial time [s]
+	 * 4. `allocator`: allocator of the workspace, not used if `DO_NOT_USE_HEAP` is defined
+	 */
+	SymplecticIntegrator(Bind_T acceleration_fun, const Real_T time_step,
+	                     const Real_T t_init = 0, const Allocator &allocator = Allocator())
+	    : acceleration_fun(std::move(acceleration_fun)), time_step(time_step), t_init(t_init),
+	      workspace(allocator)
+	{
+		reset();
+	}
+
+	/*
+	 * Computes the next step.
+	 *
+	 * 1. `t`: time [s]
+	 * 2. `x`: state, `[q; v]`
+	 *
+	 * OUT:
+	 * 3. `t_next`: next time [s]
+	 * 4. `x_next`: next_state
+	 */
+	void
+	step(const Real_T &t, const Real_T (&x)[x_dim], Real_T &t_next, Real_T (&x_next)[x_dim])
+	{
+		if (!is_good()) { //* hold the state
+			t_next = t;
+
+			for (size_t i = 0; i < x_dim; ++i) {
+				x_next[i] = x[i];
+			}
+			return;
+		}
+		Buffers &buf = workspace.get();
+		//* local copy, since the stores to the buffers could alias the member
+		const Real_T h = time_step;
+		const Real_T t_end = t_init + (step_counter + 1) * time_step;
+
+		if (!is_cached(t, x, buf)) {
+			for (size_t i = 0; i < Q_DIM; ++i) {
+				buf.q_temp[i] = x[i];
+				buf.v_temp[i] = x[Q_DIM + i];
+			}
+			acceleration_fun(t, buf.q_temp, buf.v_temp, buf.a);
+		}
+
+		//* dx = [dq; dv] relative to x
+		for (size_t i = 0; i < x_dim; ++i) {
+			buf.dx[i] = 0;
+		}
+		Real_T c = 0;
+
+		for (size_t s = 0; s < stage_dim; ++s) {
+			const Real_T h_s = Method_T::w[s] * h;
+			c += Method_T::w[s];
+			const Real_T t_s = s == stage_dim - 1 ? t_end : t + c * h;
+
+			for (size_t i = 0; i < Q_DIM; ++i) {
+				//* kick: v += h_s/2*a
+				const Real_T dv_i = buf.dx[Q_DIM + i] + h_s / 2 * buf.a[i];
+				//* drift: q += h_s*v
+				const Real_T dq_i = buf.dx[i] + h_s * (x[Q_DIM + i] + dv_i);
+				buf.dx[i] = dq_i;
+				buf.dx[Q_DIM + i] = dv_i;
+				buf.q_temp[i] = x[i] + dq_i;
+				//* predicted velocity for velocity-dependent accelerations
+				buf.v_temp[i] = x[Q_DIM + i] + dv_i + h_s / 2 * buf.a[i];
+			}
+			acceleration_fun(t_s, buf.q_temp, buf.v_temp, buf.a);
+
+			for (size_t i = 0; i < Q_DIM; ++i) {
+				//* kick: v += h_s/2*a
+				buf.dx[Q_DIM + i] += h_s / 2 * buf.a[i];
+			}
+		}
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			//* compensated (Kahan) summation, ffast-math might break this
+			const Real_T compensated_dx_i = buf.dx[i] - buf.accumulator[i];
+			const Real_T x_next_i = x[i] + compensated_dx_i;
+			buf.accumulator[i] = (x_next_i - x[i]) - compensated_dx_i;
+			x_next[i] = x_next_i;
+			buf.x_cached[i] = x_next_i;
+		}
+		t_cached = t_end;
+		has_cache = true;
+
+		t_next = t_end;
+		++step_counter;
+	}
+
+	void
+	reset()
+	{
+		step_counter = 0;
+		has_cache = false;
+
+		if (is_good()) {
+			Buffers &buf = workspace.get();
+
+			for (size_t i = 0; i < x_dim; ++i) {
+				buf.accumulator[i] = 0;
+			}
+		}
+	}
+
+	//* true if the workspace could be allocated
+	bool
+	is_good() const
+	{
+		return workspace.is_good();
+	}
+
+	Real_T
+	get_step_size() const
+	{
+		return time_step;
+	}
+
+	size_t
+	get_step_count() const
+	{
+		return step_counter;
+	}
+
+  private:
+	Bind_T acceleration_fun;
+	const Real_T time_step;
+	const Real_T t_init;
+	size_t step_counter;
+	bool has_cache;
+	Real_T t_cached;
+
+	struct Buffers {
+		alignas(cache_line_size) Real_T q_temp[Q_DIM];
+		alignas(cache_line_size) Real_T v_temp[Q_DIM];
+		alignas(cache_line_size) Real_T a[Q_DIM];
+		alignas(cache_line_size) Real_T dx[x_dim];
+		alignas(cache_line_size) Real_T x_cached[x_dim];
+		alignas(cache_line_size) Real_T accumulator[x_dim];
+	};
+	Workspace<Buffers> workspace;
+
+	//* true if `a` holds the acceleration at `(t, x)`, i.e. `x` is the unmodified last state
+	bool
+	is_cached(const Real_T &t, const Real_T (&x)[x_dim], const Buffers &buf) const
+	{
+		if (!has_cache || t != t_cached) {
+			return false;
+		}
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			if (x[i] != buf.x_cached[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+} // namespace rk4_solver
+
+#endif
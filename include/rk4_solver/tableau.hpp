@@ -0,0 +1,122 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TABLEAU_HPP_CINARAL_261017_1930
+#define TABLEAU_HPP_CINARAL_261017_1930
+
+#include "types.hpp"
+
+/*
+ * Butcher tableaus of explicit Runge-Kutta methods for `ExplicitIntegrator`. A tableau is a type
+ * with the static constexpr members:
+ * 1. `stage_dim`: number of stages
+ * 2. `order`: order of accuracy
+ * 3. `a[stage_dim][stage_dim]`: stage coefficients, strictly lower triangular
+ * 4. `b[stage_dim]`: weights
+ * 5. `c[stage_dim]`: nodes, i.e. the stage times as fractions of the step
+ */
+
+namespace rk4_solver
+{
+namespace tableau
+{
+//* forward Euler method
+struct Euler {
+	static constexpr size_t stage_dim = 1;
+	static constexpr size_t order = 1;
+	static constexpr Real_T a[stage_dim][stage_dim] = {{0}};
+	static constexpr Real_T b[stage_dim] = {1};
+	static constexpr Real_T c[stage_dim] = {0};
+};
+
+//* Heun's method (explicit trapezoidal rule)
+struct Heun {
+	static constexpr size_t stage_dim = 2;
+	static constexpr size_t order = 2;
+	static constexpr Real_T a[stage_dim][stage_dim] = {
+	    {0, 0},
+	    {1, 0},
+	};
+	static constexpr Real_T b[stage_dim] = {1. / 2., 1. / 2.};
+	static constexpr Real_T c[stage_dim] = {0, 1};
+};
+
+//* Ralston's 2nd order method, which minimizes the truncation error among 2 stage methods
+struct Ralston {
+	static constexpr size_t stage_dim = 2;
+	static constexpr size_t order = 2;
+	static constexpr Real_T a[stage_dim][stage_dim] = {
+	    {0, 0},
+	    {2. / 3., 0},
+	};
+	static constexpr Real_T b[stage_dim] = {1. / 4., 3. / 4.};
+	static constexpr Real_T c[stage_dim] = {0, 2. / 3.};
+};
+
+//* Kutta's 3rd order method
+struct Rk3 {
+	static constexpr size_t stage_dim = 3;
+	static constexpr size_t order = 3;
+	static constexpr Real_T a[stage_dim][stage_dim] = {
+	    {0, 0, 0},
+	    {1. / 2., 0, 0},
+	    {-1, 2, 0},
+	};
+	static constexpr Real_T b[stage_dim] = {1. / 6., 2. / 3., 1. / 6.};
+	static constexpr Real_T c[stage_dim] = {0, 1. / 2., 1};
+};
+
+//* classic Runge-Kutta 4th Order method, the same method as `Integrator`
+struct Rk4 {
+	static constexpr size_t stage_dim = 4;
+	static constexpr size_t order = 4;
+	static constexpr Real_T a[stage_dim][stage_dim] = {
+	    {0, 0, 0, 0},
+	    {1. / 2., 0, 0, 0},
+	    {0, 1. / 2., 0, 0},
+	    {0, 0, 1, 0},
+	};
+	static constexpr Real_T b[stage_dim] = {1. / 6., 1. / 3., 1. / 3., 1. / 6.};
+	static constexpr Real_T c[stage_dim] = {0, 1. / 2., 1. / 2., 1};
+};
+
+//* Kutta's 3/8 rule, a 4th order method with smaller error constants than `Rk4`
+struct Rk38 {
+	static constexpr size_t stage_dim = 4;
+	static constexpr size_t order = 4;
+	static constexpr Real_T a[stage_dim][stage_dim] = {
+	    {0, 0, 0, 0},
+	    {1. / 3., 0, 0, 0},
+	    {-1. / 3., 1, 0, 0},
+	    {1, -1, 1, 0},
+	};
+	static constexpr Real_T b[stage_dim] = {1. / 8., 3. / 8., 3. / 8., 1. / 8.};
+	static constexpr Real_T c[stage_dim] = {0, 1. / 3., 2. / 3., 1};
+};
+} // namespace tableau
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,278 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_HPP_CINARAL_261017_1002
+#define THREAD_POOL_HPP_CINARAL_261017_1002
+
+#include "types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rk4_solver
+{
+/*
+ * Persistent pool of worker threads. `run(fun)` calls `fun(thread_idx)` once on every thread of
+ * the pool, including the calling thread which is always `thread_idx = 0`, and returns when all of
+ * them are done. The workers spin briefly before they go to sleep, so back-to-back `run` calls are
+ * cheap. Nothing is allocated after construction.
+ */
+class ThreadPool
+{
+  public:
+	explicit ThreadPool(const size_t thread_count = get_default_thread_count())
+	    : thread_count(thread_count > 0 ? thread_count : 1)
+	{
+		threads.reserve(this->thread_count - 1);
+
+		for (size_t i = 1; i < this->thread_count; ++i) {
+			threads.emplace_back(&ThreadPool::work, this, i);
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			is_stopping = true;
+			epoch.fetch_add(1, std::memory_order_release);
+		}
+		condition.notify_all();
+
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	/*
+	 * Calls `fun(thread_idx)` on every thread and blocks until all calls return.
+	 *
+	 * 1. `fun`: callable of signature `void(size_t thread_idx)`
+	 */
+	template <typename Fun_T>
+	void
+	run(Fun_T &fun)
+	{
+		job_fun = &fun;
+		job_invoke = [](void *fun_ptr, const size_t thread_idx) {
+			(*static_cast<Fun_T *>(fun_ptr))(thread_idx);
+		};
+		pending.store(thread_count - 1, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			epoch.fetch_add(1, std::memory_order_release);
+		}
+		condition.notify_all();
+
+		fun(0);
+
+		for (size_t i = 0; pending.load(std::memory_order_acquire) != 0; ++i) {
+			if (i > spin_dim) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	size_t
+	get_thread_count() const
+	{
+		return thread_count;
+	}
+
+	static size_t
+	get_default_thread_count()
+	{
+		const size_t hardware_thread_count = std::thread::hardware_concurrency();
+		return hardware_thread_count > 0 ? hardware_thread_count : 1;
+	}
+
+  private:
+	static constexpr size_t spin_dim = 1 << 10; //* busy-wait iterations before yielding
+	static constexpr size_t yield_dim = 1 << 14; //* yielding iterations before sleeping
+
+	const size_t thread_count;
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::atomic<size_t> epoch{0};
+	std::atomic<size_t> pending{0};
+	bool is_stopping = false;
+	void *job_fun = nullptr;
+	void (*job_invoke)(void *, const size_t) = nullptr;
+
+	void
+	work(const size_t thread_idx)
+	{
+		size_t seen_epoch = 0;
+
+		while (true) {
+			size_t i = 0;
+
+			for (; i < spin_dim + yield_dim; ++i) {
+				if (epoch.load(std::memory_order_acquire) != seen_epoch) {
+					break;
+				}
+				if (i > spin_dim) {
+					std::this_thread::yield();
+				}
+			}
+
+			if (i == spin_dim + yield_dim) {
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [&] {
+					return epoch.load(std::memory_order_acquire) != seen_epoch;
+				});
+			}
+			seen_epoch = epoch.load(std::memory_order_acquire);
+
+			if (is_stopping) {
+				return;
+			}
+			job_invoke(job_fun, thread_idx);
+			pending.fetch_sub(1, std::memory_order_release);
+		}
+	}
+};
+
+/*
+ * Reusable barrier of `thread_count` threads, e.g. between the stages of a step that is split
+ * over the threads of a `ThreadPool`. The threads spin briefly and then yield while they wait, so
+ * a barrier costs little more than the cache line transfers of its counter.
+ */
+class SpinBarrier
+{
+  public:
+	explicit SpinBarrier(const size_t thread_count) : thread_count(thread_count)
+	{
+	}
+
+	SpinBarrier(const SpinBarrier &) = delete;
+	SpinBarrier &operator=(const SpinBarrier &) = delete;
+
+	//* blocks until all `thread_count` threads have arrived
+	void
+	arrive_and_wait()
+	{
+		const size_t arrival_phase = phase.load(std::memory_order_acquire);
+
+		if (count.fetch_add(1, std::memory_order_acq_rel) + 1 == thread_count) {
+			count.store(0, std::memory_order_relaxed);
+			phase.store(arrival_phase + 1, std::memory_order_release);
+			return;
+		}
+
+		for (size_t i = 0; phase.load(std::memory_order_acquire) == arrival_phase; ++i) {
+			if (i > spin_dim) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+  private:
+	static constexpr size_t spin_dim = 1 << 10; //* busy-wait iterations before yielding
+
+	const size_t thread_count;
+	alignas(64) std::atomic<size_t> count{0};
+	alignas(64) std::atomic<size_t> phase{0};
+};
+
+/*
+ * Work-stealing dispenser of task indices for a `ThreadPool`. `reset(task_count)` splits the
+ * tasks into one contiguous range per thread. `pop(thread_idx, task_idx)` takes the next task
+ * from the thread's own range, and steals from the other ranges once its own range is exhausted.
+ * Nothing is allocated after construction.
+ */
+class TaskQueue
+{
+  public:
+	explicit TaskQueue(const size_t thread_count)
+	    : thread_count(thread_count), ranges(new Range[thread_count])
+	{
+		reset(0);
+	}
+
+	~TaskQueue()
+	{
+		delete[] ranges;
+	}
+
+	TaskQueue(const TaskQueue &) = delete;
+	TaskQueue &operator=(const TaskQueue &) = delete;
+
+	void
+	reset(const size_t task_count)
+	{
+		for (size_t i = 0; i < thread_count; ++i) {
+			const size_t begin = task_count * i / thread_count;
+			ranges[i].next.store(begin, std::memory_order_relaxed);
+			ranges[i].end = task_count * (i + 1) / thread_count;
+		}
+	}
+
+	/*
+	 * Takes the next task, returns false if there are no tasks left.
+	 *
+	 * 1. `thread_idx`: index of the calling thread
+	 *
+	 * OUT:
+	 * 2. `task_idx`: index of the task
+	 */
+	bool
+	pop(const size_t thread_idx, size_t &task_idx)
+	{
+		for (size_t i = 0; i < thread_count; ++i) {
+			Range &range = ranges[(thread_idx + i) % thread_count];
+
+			if (range.next.load(std::memory_order_relaxed) < range.end) {
+				const size_t idx =
+				    range.next.fetch_add(1, std::memory_order_relaxed);
+
+				if (idx < range.end) {
+					task_idx = idx;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+  private:
+	//* one cache line per range to avoid false sharing
+	struct alignas(64) Range {
+		std::atomic<size_t> next;
+		size_t end;
+	};
+	const size_t thread_count;
+	Range *ranges;
+};
+} // namespace rk4_solver
+
+#endif
@@ -0,0 +1,299 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TRAJECTORY_HPP_CINARAL_261017_1530
+#define TRAJECTORY_HPP_CINARAL_261017_1530
+
+#include "types.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+	#include <cstdlib>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/*
+ * Binary trajectory format:
+ *
+ * A 64 byte `TrajectoryHeader` followed by `t_dim` rows of `[t, x]` in native `Real_T` format.
+ * The header records the dimensions, the size of `Real_T`, the byte order and the time grid.
+ * A `time_step` of 0 means that the time grid is not uniform, and only the `t` column is valid.
+ */
+
+namespace rk4_solver
+{
+constexpr char trajectory_magic[8] = {'R', 'K', '4', 'T', 'R', 'A', 'J', '\0'};
+constexpr uint32_t trajectory_version = 1;
+constexpr uint32_t trajectory_endian_tag = 0x01020304; //* reads 0x04030201 if swapped
+
+struct TrajectoryHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t endian_tag;
+	uint32_t real_size;
+	uint32_t x_dim;
+	uint64_t t_dim;
+	double t_init;
+	double time_step;
+	char reserved[16];
+};
+static_assert(sizeof(TrajectoryHeader) == 64, "TrajectoryHeader must be 64 bytes.");
+
+/*
+ * Fills a trajectory header for the current `Real_T`.
+ *
+ * OUT:
+ * 1. header: trajectory header
+ */
+inline void
+make_trajectory_header(const size_t x_dim, const size_t t_dim, const Real_T t_init,
+                       const Real_T time_step, TrajectoryHeader &header)
+{
+	std::memset(&header, 0, sizeof(TrajectoryHeader));
+	std::memcpy(header.magic, trajectory_magic, sizeof(trajectory_magic));
+	header.version = trajectory_version;
+	header.endian_tag = trajectory_endian_tag;
+	header.real_size = sizeof(Real_T);
+	header.x_dim = x_dim;
+	header.t_dim = t_dim;
+	header.t_init = t_init;
+	header.time_step = time_step;
+}
+
+/*
+ * Writes a whole trajectory to a binary trajectory file.
+ *
+ * 1. fname: file name
+ * 2. t_init: initial time
+ * 3. time_step: time step, 0 if the time grid is not uniform
+ * 4. t_arr: time array
+ * 5. x_arr: state array
+ *
+ * OUT:
+ * true if the file was written successfully
+ */
+template <size_t T_DIM, size_t X_DIM>
+bool
+write_trajectory(const char *fname, const Real_T t_init, const Real_T time_step,
+                 const Real_T (&t_arr)[T_DIM], const Real_T (&x_arr)[T_DIM][X_DIM])
+{
+	std::FILE *file = std::fopen(fname, "wb");
+
+	if (file == nullptr) {
+		return false;
+	}
+	TrajectoryHeader header;
+	make_trajectory_header(X_DIM, T_DIM, t_init, time_step, header);
+	bool is_good = std::fwrite(&header, sizeof(TrajectoryHeader), 1, file) == 1;
+
+	for (size_t i = 0; i < T_DIM && is_good; ++i) {
+		is_good = std::fwrite(&t_arr[i], sizeof(Real_T), 1, file) == 1 &&
+		          std::fwrite(x_arr[i], sizeof(Real_T), X_DIM, file) == X_DIM;
+	}
+	return (std::fclose(file) == 0) && is_good;
+}
+
+/*
+ * Maps a binary trajectory file into memory and exposes its rows without copying. On Windows,
+ * the file is read into a buffer instead.
+ */
+template <size_t X_DIM> class TrajectoryReader
+{
+  public:
+	TrajectoryReader()
+	{
+	}
+
+	explicit TrajectoryReader(const char *fname)
+	{
+		open(fname);
+	}
+
+	~TrajectoryReader()
+	{
+		close();
+	}
+
+	TrajectoryReader(const TrajectoryReader &) = delete;
+	TrajectoryReader &operator=(const TrajectoryReader &) = delete;
+
+	/*
+	 * Opens a binary trajectory file.
+	 *
+	 * 1. fname: file name
+	 *
+	 * OUT:
+	 * true if the file is a valid trajectory of `X_DIM` states with the current `Real_T`
+	 */
+	bool
+	open(const char *fname)
+	{
+		close();
+#ifdef _WIN32
+		std::FILE *file = std::fopen(fname, "rb");
+
+		if (file == nullptr) {
+			return false;
+		}
+		if (std::fseek(file, 0, SEEK_END) == 0) {
+			const long file_size = std::ftell(file);
+
+			if (file_size > 0 && std::fseek(file, 0, SEEK_SET) == 0) {
+				data = std::malloc(file_size);
+
+				if (data != nullptr) {
+					data_size = std::fread(data, 1, file_size, file);
+				}
+			}
+		}
+		std::fclose(file);
+#else
+		const int fd = ::open(fname, O_RDONLY);
+
+		if (fd < 0) {
+			return false;
+		}
+		struct stat file_stat;
+
+		if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+			void *addr =
+			    mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (addr != MAP_FAILED) {
+				data = addr;
+				data_size = file_stat.st_size;
+			}
+		}
+		::close(fd);
+#endif
+		if (!is_valid()) {
+			close();
+			return false;
+		}
+		const TrajectoryHeader &header = get_header();
+		t_dim = header.t_dim;
+		t_init = header.t_init;
+		time_step = header.time_step;
+		rows = (const Real_T *)((const char *)data + sizeof(TrajectoryHeader));
+		return true;
+	}
+
+	void
+	close()
+	{
+		if (data != nullptr) {
+#ifdef _WIN32
+			std::free(data);
+#else
+			munmap(data, data_size);
+#endif
+		}
+		data = nullptr;
+		data_size = 0;
+		rows = nullptr;
+		t_dim = 0;
+		t_init = 0;
+		time_step = 0;
+	}
+
+	//* true if a valid trajectory is open
+	bool
+	is_good() const
+	{
+		return rows != nullptr;
+	}
+
+	size_t
+	get_t_dim() const
+	{
+		return t_dim;
+	}
+
+	//* initial time recorded in the header, 0 if no trajectory is open
+	Real_T
+	get_t_init() const
+	{
+		return t_init;
+	}
+
+	//* time step recorded in the header, 0 if it is not uniform or no trajectory is open
+	Real_T
+	get_time_step() const
+	{
+		return time_step;
+	}
+
+	//* time of the `i`th row, `i` must be less than `get_t_dim()`
+	const Real_T &
+	get_t(const size_t i) const
+	{
+		return rows[i * (X_DIM + 1)];
+	}
+
+	//* state of the `i`th row, `i` must be less than `get_t_dim()`
+	const Real_T (&get_x(const size_t i) const)[X_DIM]
+	{
+		return *(const Real_T(*)[X_DIM])(rows + i * (X_DIM + 1) + 1);
+	}
+
+  private:
+	void *data = nullptr;
+	size_t data_size = 0;
+	const Real_T *rows = nullptr;
+	size_t t_dim = 0;
+	Real_T t_init = 0;
+	Real_T time_step = 0;
+
+	const TrajectoryHeader &
+	get_header() const
+	{
+		return *(const TrajectoryHeader *)data;
+	}
+
+	bool
+	is_valid() const
+	{
+		if (data == nullptr || data_size < sizeof(TrajectoryHeader)) {
+			return false;
+		}
+		const TrajectoryHeader &header = get_header();
+
+		return std::memcmp(header.magic, trajectory_magic, sizeof(trajectory_magic)) == 0 &&
+		       header.version == trajectory_version &&
+		       header.endian_tag == trajectory_endian_tag &&
+		       header.real_size == sizeof(Real_T) && header.x_dim == X_DIM &&
+		       header.t_dim <= (data_size - sizeof(TrajectoryHeader)) /
+		                           ((X_DIM + 1) * sizeof(Real_T));
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -38,11 +38,93 @@ using Real_T = float;
 using Real_T = double;
 #endif
 
-template <size_t X_DIM, typename T>
-using OdeFun_T = void (T::*)(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM]);
+/*
+ * `Real_T` is the default scalar type, which `Integrator`, the events and their loops take as the
+ * template parameter `R`, so that float and double precision can be used in the same program.
+ */
+template <size_t X_DIM, typename T, typename R = Real_T>
+using OdeFun_T = void (T::*)(const R t, const R (&x)[X_DIM], R (&dt_x)[X_DIM]);
+
+//* `R` in a function parameter that must not be deduced from the argument, e.g. a literal `0`
+template <typename R> struct NonDeduced {
+	using type = R;
+};
+template <typename R> using NonDeduced_T = typename NonDeduced<R>::type;
+
+/*
+ * Stage-aware ODE function of `FusedIntegrator`, which forms the stage input on the fly, i.e.
+ * `dt_x = f(t, x + a * k)`
+ */
+template <size_t X_DIM, typename T, typename R = Real_T>
+using StageFun_T = void (T::*)(const R t, const R (&x)[X_DIM], const R (&k)[X_DIM], const R a,
+                               R (&dt_x)[X_DIM]);
+
+//* ODE function of `ParallelIntegrator`, which only computes `dt_x[begin]...dt_x[end - 1]`
+template <size_t X_DIM, typename T, typename R = Real_T>
+using RangeOdeFun_T = void (T::*)(const R t, const R (&x)[X_DIM], const size_t begin,
+                                  const size_t end, R (&dt_x)[X_DIM]);
 
+//* Jacobian of the ODE function, `jac[i][j]` is the derivative of `dt_x[i]` by `x[j]`
 template <size_t X_DIM, typename T>
-using EventFun_T = bool (T::*)(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&x_plus)[X_DIM]);
+using JacobianFun_T = void (T::*)(const Real_T t, const Real_T (&x)[X_DIM],
+                                  Real_T (&jac)[X_DIM][X_DIM]);
+
+//* acceleration of a second order system `dt_dt_q = a(t, q, dt_q)`
+template <size_t Q_DIM, typename T>
+using AccelerationFun_T = void (T::*)(const Real_T t, const Real_T (&q)[Q_DIM],
+                                      const Real_T (&v)[Q_DIM], Real_T (&a)[Q_DIM]);
+
+template <size_t X_DIM, typename T, typename R = Real_T>
+using EventFun_T = bool (T::*)(const R t, const R (&x)[X_DIM], R (&x_plus)[X_DIM]);
+
+template <size_t X_DIM, typename T, typename R = Real_T>
+using GuardFun_T = R (T::*)(const R t, const R (&x)[X_DIM]);
+
+template <size_t X_DIM, typename T, typename R = Real_T>
+using ResetFun_T = void (T::*)(const R t, const R (&x)[X_DIM], R (&x_plus)[X_DIM]);
+
+/*
+ * Non-owning view of `size` contiguous elements, for sizes that are only known at run time.
+ */
+template <typename R> struct Span {
+	R *data = nullptr;
+	size_t size = 0;
+
+	Span()
+	{
+	}
+
+	Span(R *data, const size_t size) : data(data), size(size)
+	{
+	}
+
+	template <size_t N> Span(R (&arr)[N]) : data(arr), size(N)
+	{
+	}
+
+	//* row-major view of a 2D array
+	template <size_t M, size_t N> Span(R (&arr)[M][N]) : data(&arr[0][0]), size(M * N)
+	{
+	}
+
+	//* e.g. `Span<const Real_T>` from `Span<Real_T>`
+	template <typename S> Span(const Span<S> &other) : data(other.data), size(other.size)
+	{
+	}
+
+	R &
+	operator[](const size_t i) const
+	{
+		return data[i];
+	}
+};
+
+template <typename T>
+using DynamicOdeFun_T = void (T::*)(const Real_T t, Span<const Real_T> x, Span<Real_T> dt_x);
+
+template <size_t N, size_t X_DIM, typename T>
+using BatchOdeFun_T = void (T::*)(const Real_T t, const Real_T (&x)[X_DIM][N],
+                                  Real_T (&dt_x)[X_DIM][N]);
 
 } // namespace rk4_solver
 
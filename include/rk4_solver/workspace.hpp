@@ -0,0 +1,277 @@
+/*
+ * rk4_solver
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Cinar, A. L.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef WORKSPACE_HPP_CINARAL_261017_1705
+#define WORKSPACE_HPP_CINARAL_261017_1705
+
+#include "types.hpp"
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace rk4_solver
+{
+constexpr size_t cache_line_size = 64; //* [bytes]
+
+/*
+ * Allocation hook for workspaces. `allocate` returns `byte_dim` bytes aligned to `alignment`, or
+ * nullptr if it fails, and `deallocate` receives the same arguments. `context` is passed to both,
+ * e.g. to allocate from an `Arena`. By default, the aligned `operator new` is used, which throws
+ * `std::bad_alloc` on failure like any other allocation, so that only a custom allocator can leave
+ * a workspace without buffers.
+ */
+struct Allocator {
+	void *(*allocate)(size_t byte_dim, size_t alignment, void *context) = allocate_default;
+	void (*deallocate)(void *ptr, size_t byte_dim, size_t alignment,
+	                   void *context) = deallocate_default;
+	void *context = nullptr;
+
+	static void *
+	allocate_default(const size_t byte_dim, const size_t alignment, void *)
+	{
+		return ::operator new(byte_dim, std::align_val_t(alignment));
+	}
+
+	static void
+	deallocate_default(void *ptr, const size_t, const size_t alignment, void *)
+	{
+		::operator delete(ptr, std::align_val_t(alignment));
+	}
+};
+
+/*
+ * Bump allocator over a buffer supplied by the caller, e.g. to place the workspaces of many
+ * integrators next to each other. Memory is only released all at once by `reset()`, and the
+ * buffer must outlive everything allocated from it.
+ */
+class Arena
+{
+  public:
+	Arena(void *buffer, const size_t byte_dim) : buffer(buffer), byte_dim(byte_dim)
+	{
+	}
+
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	/*
+	 * OUT:
+	 * `byte_dim` bytes aligned to `alignment`, or nullptr if the arena is full
+	 */
+	void *
+	allocate(const size_t byte_dim, const size_t alignment)
+	{
+		const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(buffer);
+		const std::uintptr_t addr =
+		    (begin + used_byte_dim + alignment - 1) / alignment * alignment;
+
+		if (addr + byte_dim > begin + this->byte_dim) {
+			return nullptr;
+		}
+		used_byte_dim = addr + byte_dim - begin;
+		return reinterpret_cast<void *>(addr);
+	}
+
+	void
+	reset()
+	{
+		used_byte_dim = 0;
+	}
+
+	size_t
+	get_used_byte_dim() const
+	{
+		return used_byte_dim;
+	}
+
+	//* allocator that allocates from this arena
+	Allocator
+	get_allocator()
+	{
+		Allocator allocator;
+		allocator.allocate = [](size_t byte_dim, size_t alignment, void *context) {
+			return static_cast<Arena *>(context)->allocate(byte_dim, alignment);
+		};
+		allocator.deallocate = [](void *, size_t, size_t, void *) {};
+		allocator.context = this;
+		return allocator;
+	}
+
+  private:
+	void *const buffer;
+	const size_t byte_dim;
+	size_t used_byte_dim = 0;
+};
+
+/*
+ * Owns the working buffers of an integrator, given as a struct of arrays `Buffers_T`, in a single
+ * block. The block is allocated once, aligned to a cache line, and freed by the destructor. A copy
+ * allocates its own block and copies the buffers, a move takes over the block and leaves the
+ * source without buffers. If `DO_NOT_USE_HEAP` is defined, the buffers are stored inline and the
+ * allocator is not used.
+ */
+template <typename Buffers_T> class Workspace
+{
+	static_assert(std::is_trivially_copyable<Buffers_T>::value,
+	              "The buffers must be trivially copyable.");
+
+  public:
+	static constexpr size_t alignment =
+	    alignof(Buffers_T) > cache_line_size ? alignof(Buffers_T) : cache_line_size;
+
+	explicit Workspace(const Allocator &allocator = Allocator()) : allocator(allocator)
+	{
+		allocate();
+	}
+
+	Workspace(const Workspace &other) : allocator(other.allocator)
+	{
+		allocate();
+		copy_from(other);
+	}
+
+	Workspace(Workspace &&other) : allocator(other.allocator)
+	{
+#ifdef DO_NOT_USE_HEAP
+		copy_from(other);
+#else
+		buffers = other.buffers;
+		other.buffers = nullptr;
+#endif
+	}
+
+	Workspace &
+	operator=(const Workspace &other)
+	{
+		if (this != &other) {
+#ifndef DO_NOT_USE_HEAP
+			if (!other.is_good()) {
+				deallocate();
+			} else if (!is_good()) {
+				allocate(); //* e.g. moved from, or the allocation failed before
+			}
+#endif
+			copy_from(other);
+		}
+		return *this;
+	}
+
+	Workspace &
+	operator=(Workspace &&other)
+	{
+#ifdef DO_NOT_USE_HEAP
+		copy_from(other);
+#else
+		Buffers_T *const temp = buffers;
+		const Allocator temp_allocator = allocator;
+		buffers = other.buffers;
+		allocator = other.allocator;
+		other.buffers = temp;
+		other.allocator = temp_allocator;
+#endif
+		return *this;
+	}
+
+	~Workspace()
+	{
+		deallocate();
+	}
+
+	//* true if the buffers could be allocated
+	bool
+	is_good() const
+	{
+#ifdef DO_NOT_USE_HEAP
+		return true;
+#else
+		return buffers != nullptr;
+#endif
+	}
+
+	Buffers_T &
+	get()
+	{
+#ifdef DO_NOT_USE_HEAP
+		return buffers;
+#else
+		return *buffers;
+#endif
+	}
+
+	const Buffers_T &
+	get() const
+	{
+#ifdef DO_NOT_USE_HEAP
+		return buffers;
+#else
+		return *buffers;
+#endif
+	}
+
+  private:
+	Allocator allocator;
+#ifdef DO_NOT_USE_HEAP
+	Buffers_T buffers;
+#else
+	Buffers_T *buffers = nullptr;
+#endif
+
+	void
+	allocate()
+	{
+#ifndef DO_NOT_USE_HEAP
+		void *ptr = allocator.allocate(sizeof(Buffers_T), alignment, allocator.context);
+
+		if (ptr != nullptr) {
+			buffers = new (ptr) Buffers_T; //* placement new does not allocate
+		}
+#endif
+	}
+
+	void
+	deallocate()
+	{
+#ifndef DO_NOT_USE_HEAP
+		if (buffers != nullptr) {
+			allocator.deallocate(buffers, sizeof(Buffers_T), alignment,
+			                     allocator.context);
+			buffers = nullptr;
+		}
+#endif
+	}
+
+	void
+	copy_from(const Workspace &other)
+	{
+		if (is_good() && other.is_good()) {
+			std::memcpy(&get(), &other.get(), sizeof(Buffers_T));
+		}
+	}
+};
+} // namespace rk4_solver
+
+#endif
@@ -2,21 +2,54 @@
 
 #* project relative path
 PROJECT_PATH=..
+BUILD_PATH=$PROJECT_PATH/build/suite
+
+#* usage: benchmark.sh [RESULT.csv [BASELINE.csv]]
+#* builds the benchmark suite for each precision and workspace storage, saves the results in one
+#* CSV file and optionally compares them against a baseline saved the same way
+RESULT_PATH=$(realpath -m "${1:-benchmark.csv}")
+if [[ -n "$2" ]]; then
+	BASELINE_PATH=$(realpath -m "$2")
+fi
 
 #*  change the cwd to the script dir temporarily, and hide pushd popd output
-pushd () { 
-	command pushd "$@" > /dev/null 
+pushd () {
+	command pushd "$@" > /dev/null
 }
-popd () { 
-	command popd "$@" > /dev/null 
+popd () {
+	command popd "$@" > /dev/null
 }
 pushd "$(dirname ${BASH_SOURCE:0})"
 trap popd EXIT #*
 
-pushd $PROJECT_PATH/build/bin
-./step-benchmark.exe
-echo ""
-./loop-benchmark.exe
-echo ""
+rm -f $RESULT_PATH
+REGRESSION=0
+
+for PRECISION in OFF ON; do
+for HEAP in OFF ON; do
+	CONFIG_PATH=$BUILD_PATH/single_$PRECISION-no_heap_$HEAP
+	cmake -S $PROJECT_PATH/ -B $CONFIG_PATH -DDEBUG_BUILD=OFF -DBUILD_TESTS=OFF \
+		-DBUILD_EXAMPLES=OFF -DUSE_SINGLE_PRECISION=$PRECISION -DDO_NOT_USE_HEAP=$HEAP > /dev/null
+	cmake --build $CONFIG_PATH --target suite-benchmark > /dev/null || exit 1
+
+	if [[ -n "$BASELINE_PATH" ]]; then
+		$CONFIG_PATH/bin/suite-benchmark --format csv --output $CONFIG_PATH/suite.csv \
+			--compare $BASELINE_PATH || REGRESSION=1
+	else
+		$CONFIG_PATH/bin/suite-benchmark --format csv --output $CONFIG_PATH/suite.csv
+	fi
+	tr , "\t" < $CONFIG_PATH/suite.csv
+	echo ""
+
+	#* keep the header of the first configuration only
+	if [[ -f $RESULT_PATH ]]; then
+		tail -n +2 $CONFIG_PATH/suite.csv >> $RESULT_PATH
+	else
+		cat $CONFIG_PATH/suite.csv > $RESULT_PATH
+	fi
+done
+done
 
+echo "Results saved to $RESULT_PATH"
 echo "$0 done."
+exit $REGRESSION
@@ -0,0 +1,127 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "adaptive-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = 1e3 + 1; //* maximum number of saved points
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {0., 1.};
+constexpr Real_T sine_freq = 5.;
+constexpr Real_T a_const = -1.;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T tol = 1e-5;
+constexpr Real_T error_thres = 1e-4;
+#else
+constexpr Real_T tol = 1e-10;
+constexpr Real_T error_thres = 1e-9;
+#endif
+constexpr size_t fixed_step_eval_dim = 4 * 1e3; //* sine-test and first_order-test
+
+struct Dynamics {
+	/*
+	 * dt_x = f(t, x) = [2*pi*f*cos(t*2*pi*f); a*x2]
+	 * x = [sin(t*2*pi*f); exp(a*t)]
+	 */
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = 2 * M_PI * sine_freq * cos(t * 2 * M_PI * sine_freq);
+		dt_x[1] = a_const * x[1];
+	}
+
+	//* the derivative is NaN, so the error of every step is NaN
+	void
+	nan_ode_fun(const Real_T, const Real_T (&)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = std::numeric_limits<Real_T>::quiet_NaN();
+		dt_x[1] = 0;
+	}
+};
+Dynamics dynamics;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t = 0;
+	Real_T x[x_dim];
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+
+	rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+	                                                           tol, tol);
+	rk4_solver::loop(integrator, t_init, x_init, t_final, t, x);
+	const size_t eval_count = integrator.get_eval_count();
+
+	const size_t saved_dim =
+	    rk4_solver::loop(integrator, t_init, x_init, t_final, t_arr[0], x_arr);
+
+	//* a NaN error is rejected down to the minimum step, where the step is taken anyway
+	constexpr Real_T min_step = 1e-3;
+	rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> nan_integrator(
+	    dynamics, &Dynamics::nan_ode_fun, tol, tol,
+	    std::numeric_limits<Real_T>::infinity(), min_step);
+	Real_T t_nan;
+	Real_T x_nan[x_dim];
+	const bool is_nan_within_tol = nan_integrator.step(t_init, x_init, t_nan, x_nan, t_final);
+	const bool is_min_step_good = !is_nan_within_tol && t_nan == t_init + min_step;
+
+	//* without a minimum step, the loop stops at a step of size 0
+	rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> zero_integrator(
+	    dynamics, &Dynamics::nan_ode_fun, tol, tol);
+	const size_t nan_step_count =
+	    rk4_solver::loop(zero_integrator, t_init, x_init, t_final, t_nan, x_nan);
+	const bool is_nan_good = is_min_step_good && nan_step_count == 0 && t_nan == t_init;
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	Real_T max_error = 0.;
+
+	for (size_t i = 0; i < saved_dim; ++i) {
+		const Real_T x_ref[x_dim] = {
+		    static_cast<Real_T>(std::sin(t_arr[0][i] * 2 * M_PI * sine_freq)),
+		    static_cast<Real_T>(std::exp(a_const * t_arr[0][i]))};
+
+		for (size_t j = 0; j < x_dim; ++j) {
+			const Real_T error = std::abs(x_arr[i][j] - x_ref[j]);
+
+			if (error > max_error) {
+				max_error = error;
+			}
+		}
+	}
+
+	//* cumulative loop sanity check
+	Real_T max_loop_error = std::abs(t_arr[0][saved_dim - 1] - t);
+	const Real_T(&x_final)[x_dim] = x_arr[saved_dim - 1];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		const Real_T error = std::abs(x_final[i] - x[i]);
+
+		if (error > max_loop_error) {
+			max_loop_error = error;
+		}
+	}
+
+	if (max_error < error_thres && max_loop_error <= std::numeric_limits<Real_T>::epsilon() &&
+	    t == t_final && eval_count < fixed_step_eval_dim && is_nan_good) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		printf("t = %.17g\n", t);
+		printf("eval_count = %zu\n", eval_count);
+		printf("min step: %d, NaN steps: %zu\n", is_min_step_good, nan_step_count);
+		return 1;
+	}
+}
@@ -0,0 +1,286 @@
+#include "test_config.hpp"
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+/*
+ * Counts the calls to the global `operator new` and `operator delete` to verify that the
+ * integrators allocate their workspace once, free it, and do not allocate while integrating.
+ */
+
+size_t new_count = 0;
+size_t delete_count = 0;
+
+void *
+operator new(std::size_t byte_dim)
+{
+	++new_count;
+	void *ptr = std::malloc(byte_dim > 0 ? byte_dim : 1);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void *
+operator new(std::size_t byte_dim, std::align_val_t alignment)
+{
+	++new_count;
+	const size_t align = static_cast<size_t>(alignment);
+	void *ptr = std::aligned_alloc(align, (byte_dim + align - 1) / align * align);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+	if (ptr != nullptr) {
+		++delete_count;
+		std::free(ptr);
+	}
+}
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+void
+operator delete(void *ptr, std::align_val_t) noexcept
+{
+	if (ptr != nullptr) {
+		++delete_count;
+		std::free(ptr);
+	}
+}
+
+void
+operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(ptr, alignment);
+}
+
+//* setup
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr size_t n_dim = 4;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr size_t chunk_dim = 16;
+constexpr size_t ring_dim = 64;
+#ifdef DO_NOT_USE_HEAP
+constexpr size_t workspace_new_count = 0; //* the workspace is stored inline
+#else
+constexpr size_t workspace_new_count = 1;
+#endif
+
+struct Dynamics {
+	/*
+	 * Oscillator:
+	 * dt_x = [x2; -x1]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -x[0];
+	}
+
+	void
+	batch_ode_fun(const Real_T, const Real_T (&x)[x_dim][n_dim], Real_T (&dt_x)[x_dim][n_dim])
+	{
+		for (size_t j = 0; j < n_dim; ++j) {
+			dt_x[0][j] = x[1][j];
+			dt_x[1][j] = -x[0][j];
+		}
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&)[x_dim], Real_T (&)[x_dim])
+	{
+		return false;
+	}
+
+	Real_T
+	guard_fun(const Real_T, const Real_T (&x)[x_dim])
+	{
+		return x[0];
+	}
+
+	void
+	reset_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		x_plus[0] = x[0];
+		x_plus[1] = x[1];
+	}
+};
+Dynamics dynamics;
+
+Real_T t;
+Real_T x[x_dim];
+Real_T t_arr[t_dim];
+Real_T x_arr[t_dim][x_dim];
+Real_T x_batch_init[x_dim][n_dim];
+Real_T x_batch[x_dim][n_dim];
+Real_T x_batch_arr[t_dim][x_dim][n_dim];
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	const size_t live_count = new_count - delete_count;
+	bool is_step_free = false;
+	bool is_copy_owned = false;
+	bool is_copy_assigned = false;
+	bool is_arena_used = false;
+	bool is_exhausted_bad = false;
+	{
+		size_t count = new_count;
+		rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+		                                                   time_step);
+		rk4_solver::BatchIntegrator<n_dim, x_dim, Dynamics> batch_integrator(
+		    dynamics, &Dynamics::batch_ode_fun, time_step);
+		rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> adaptive_integrator(
+		    dynamics, &Dynamics::ode_fun);
+		rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ring_sink;
+		rk4_solver::Event<x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+		rk4_solver::ZeroCrossingEvent<x_dim, Dynamics> zero_crossing_event(
+		    dynamics, &Dynamics::guard_fun, &Dynamics::reset_fun);
+		const bool is_construct_counted = new_count - count == 4 * workspace_new_count;
+
+		//* nothing is allocated by stepping and looping
+		count = new_count;
+		integrator.step(t_init, x_init, t, x);
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+		rk4_solver::loop(integrator, t_init, x_init, t_arr, x_arr);
+		rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+		rk4_solver::loop(integrator, event, t_init, x_init, t_arr, x_arr);
+		rk4_solver::loop<t_dim>(integrator, zero_crossing_event, t_init, x_init, t, x);
+		rk4_solver::loop(integrator, zero_crossing_event, t_init, x_init, t_arr, x_arr);
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, ring_sink, 3);
+		rk4_solver::loop<t_dim>(batch_integrator, t_init, x_batch_init, t, x_batch);
+		rk4_solver::loop(batch_integrator, t_init, x_batch_init, t_arr, x_batch_arr);
+		rk4_solver::loop(adaptive_integrator, t_init, x_init, t_final, t, x);
+		rk4_solver::loop(adaptive_integrator, t_init, x_init, t_final, t_arr, x_arr);
+		is_step_free = is_construct_counted && new_count == count;
+
+		//* copies own their workspace, moves take it over
+		count = new_count;
+		const size_t freed_count = delete_count;
+		{
+			rk4_solver::Integrator<x_dim, Dynamics> copy(integrator);
+			rk4_solver::Integrator<x_dim, Dynamics> moved(std::move(copy));
+			moved.reset();
+			rk4_solver::loop<t_dim>(moved, t_init, x_init, t, x);
+			//* the moved-from integrator holds the state
+			copy.step(t_init, x_init, t, x);
+			const bool is_held = t == t_init && x[0] == x_init[0] && x[1] == x_init[1];
+			is_copy_owned = copy.is_good() != (workspace_new_count > 0) &&
+			                is_held == (workspace_new_count > 0);
+		}
+		is_copy_owned = is_copy_owned && new_count - count == workspace_new_count &&
+		                delete_count - freed_count == workspace_new_count;
+
+		//* a copy-assigned workspace matches the source, also if it was moved from
+		{
+			struct Buffers {
+				Real_T x[x_dim];
+			};
+			rk4_solver::Workspace<Buffers> source;
+			rk4_solver::Workspace<Buffers> target;
+			source.get().x[0] = 1;
+			source.get().x[1] = 2;
+			rk4_solver::Workspace<Buffers> taken(std::move(target));
+			target = source;
+			is_copy_assigned = target.is_good() && target.get().x[0] == 1 &&
+			                   target.get().x[1] == 2;
+			//* and it is not good if the source is not
+			rk4_solver::Workspace<Buffers> other_taken(std::move(source));
+			taken = source;
+			is_copy_assigned = is_copy_assigned && taken.is_good() == source.is_good();
+		}
+
+		//* the workspace is allocated from an arena
+		alignas(rk4_solver::cache_line_size) unsigned char buffer[4096];
+		rk4_solver::Arena arena(buffer, sizeof(buffer));
+		count = new_count;
+		{
+			rk4_solver::Integrator<x_dim, Dynamics> arena_integrator(
+			    dynamics, &Dynamics::ode_fun, time_step, t_init, arena.get_allocator());
+			rk4_solver::loop<t_dim>(arena_integrator, t_init, x_init, t, x);
+			constexpr size_t byte_dim = 6 * rk4_solver::cache_line_size; //* 6 buffers
+			is_arena_used = arena_integrator.is_good() && new_count == count &&
+			                arena.get_used_byte_dim() == workspace_new_count * byte_dim;
+		}
+
+		//* an exhausted arena leaves the integrators not good instead of crashing
+		alignas(rk4_solver::cache_line_size) unsigned char small_buffer[16];
+		rk4_solver::Arena small_arena(small_buffer, sizeof(small_buffer));
+		{
+			using Rk4_T = rk4_solver::tableau::Rk4;
+			constexpr Real_T inf = std::numeric_limits<Real_T>::infinity();
+			const rk4_solver::Allocator small_allocator = small_arena.get_allocator();
+			rk4_solver::Integrator<x_dim, Dynamics> small_integrator(
+			    dynamics, &Dynamics::ode_fun, time_step, t_init, small_allocator);
+			rk4_solver::BatchIntegrator<n_dim, x_dim, Dynamics> small_batch_integrator(
+			    dynamics, &Dynamics::batch_ode_fun, time_step, t_init, small_allocator);
+			rk4_solver::AdaptiveIntegrator<x_dim, Dynamics> small_adaptive_integrator(
+			    dynamics, &Dynamics::ode_fun, 1e-6, 1e-6, inf, 0, 0, small_allocator);
+			rk4_solver::ExplicitIntegrator<x_dim, Dynamics, Rk4_T> small_rk4_integrator(
+			    dynamics, &Dynamics::ode_fun, time_step, t_init, small_allocator);
+			small_integrator.reset();
+			small_batch_integrator.reset();
+			small_adaptive_integrator.reset();
+			small_rk4_integrator.reset();
+			//* the workspace is stored inline if `DO_NOT_USE_HEAP` is defined
+			const bool is_bad = workspace_new_count > 0;
+			is_exhausted_bad = small_integrator.is_good() != is_bad &&
+			                   small_batch_integrator.is_good() != is_bad &&
+			                   small_adaptive_integrator.is_good() != is_bad &&
+			                   small_rk4_integrator.is_good() != is_bad;
+			//* and their steps hold the state
+			small_integrator.step(t_init, x_init, t, x);
+			bool is_held = t == t_init && x[0] == x_init[0] && x[1] == x_init[1];
+			small_rk4_integrator.step(t_init, x_init, t, x);
+			is_held = is_held && t == t_init && x[0] == x_init[0] && x[1] == x_init[1];
+			small_batch_integrator.step(t_init, x_batch_init, t, x_batch);
+			is_held = is_held && t == t_init && x_batch[0][0] == x_batch_init[0][0];
+			const bool is_adaptive_stepped =
+			    small_adaptive_integrator.step(t_init, x_init, t, x);
+			is_exhausted_bad = is_exhausted_bad && is_held == is_bad &&
+			                   is_adaptive_stepped != is_bad;
+		}
+	}
+	//* everything was freed
+	const bool is_leak_free = new_count - delete_count == live_count;
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (is_step_free && is_copy_owned && is_copy_assigned && is_arena_used &&
+	    is_exhausted_bad && is_leak_free) {
+		return 0;
+	} else {
+		printf("is_step_free = %d\n", is_step_free);
+		printf("is_copy_owned = %d\n", is_copy_owned);
+		printf("is_copy_assigned = %d\n", is_copy_assigned);
+		printf("is_arena_used = %d\n", is_arena_used);
+		printf("is_exhausted_bad = %d\n", is_exhausted_bad);
+		printf("is_leak_free = %d\n", is_leak_free);
+		printf("new_count = %zu, delete_count = %zu\n", new_count, delete_count);
+		return 1;
+	}
+}
@@ -0,0 +1,171 @@
+#include "test_config.hpp"
+
+//* setup
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr size_t chunk_dim = 16;
+constexpr size_t queue_dim = 2;
+constexpr size_t ring_dim = 100;
+constexpr size_t decimation = 3;
+constexpr size_t slow_delay_us = 20;
+
+struct Dynamics {
+	/*
+	 * Harmonic oscillator:
+	 * dt_x = [x2; -x1]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -x[0];
+	}
+};
+Dynamics dynamics;
+
+//* collects the chunks in arrays on the consumer thread, once the gate is open
+struct Collector {
+	void
+	sink_fun(const Real_T (&t)[chunk_dim], const Real_T (&x)[chunk_dim][x_dim],
+	         const size_t count)
+	{
+		while (!is_open.load()) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+
+		for (size_t i = 0; i < count && sample_count < t_dim; ++i, ++sample_count) {
+			t_arr[sample_count] = t[i];
+			matrix_op::replace_row(sample_count, x[i], x_arr);
+		}
+	}
+
+	void
+	reset(const size_t delay_us, const bool is_open)
+	{
+		this->delay_us = delay_us;
+		this->is_open.store(is_open);
+		sample_count = 0;
+	}
+
+	size_t delay_us = 0;
+	std::atomic<bool> is_open{true};
+	size_t sample_count = 0;
+	Real_T t_arr[t_dim];
+	Real_T x_arr[t_dim][x_dim];
+};
+Collector collector;
+
+using CallbackSink_T = rk4_solver::CallbackSink<chunk_dim, x_dim, Collector>;
+using AsyncSink_T = rk4_solver::AsyncSink<queue_dim, x_dim, CallbackSink_T>;
+using rk4_solver::Backpressure;
+
+Real_T t_ref[t_dim];
+Real_T x_ref[t_dim][x_dim];
+
+//* true if the collected samples are equal to the reference samples at the same times, in order
+bool
+is_subsequence(const Collector &collector)
+{
+	size_t j = 0;
+
+	for (size_t i = 0; i < collector.sample_count; ++i, ++j) {
+		while (j < t_dim && t_ref[j] != collector.t_arr[i]) {
+			++j;
+		}
+		if (j == t_dim || collector.x_arr[i][0] != x_ref[j][0] ||
+		    collector.x_arr[i][1] != x_ref[j][1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data, the reference is the cumulative loop
+
+	//* 2. test
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_ref, x_ref);
+	CallbackSink_T callback_sink(collector, &Collector::sink_fun);
+
+	//* block: a slow consumer stalls the integration, but no sample is lost
+	collector.reset(slow_delay_us, true);
+	bool is_block_good;
+	{
+		AsyncSink_T async_sink(callback_sink);
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, async_sink);
+		async_sink.flush();
+		is_block_good = async_sink.is_good() && async_sink.get_total_count() == t_dim &&
+		                async_sink.get_dropped_count() == 0 &&
+		                collector.sample_count == t_dim && is_subsequence(collector);
+	}
+
+	//* block, decimated into a ring buffer sink, the same as the synchronous loop
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ring_sink;
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ref_ring_sink;
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, ref_ring_sink, decimation);
+	{
+		rk4_solver::AsyncSink<queue_dim, x_dim, decltype(ring_sink)> async_sink(ring_sink);
+		rk4_solver::loop<t_dim>(integrator, t_init, x_init, async_sink, decimation);
+	} //* the destructor writes the queued chunks
+	bool is_ring_good = ring_sink.get_total_count() == ref_ring_sink.get_total_count() &&
+	                    ring_sink.get_count() == ring_dim;
+
+	for (size_t i = 0; i < ring_sink.get_count(); ++i) {
+		Real_T t;
+		Real_T x[x_dim];
+		Real_T t_ref_ring;
+		Real_T x_ref_ring[x_dim];
+		ring_sink.get(i, t, x);
+		ref_ring_sink.get(i, t_ref_ring, x_ref_ring);
+		is_ring_good = is_ring_good && t == t_ref_ring && x[0] == x_ref_ring[0] &&
+		               x[1] == x_ref_ring[1];
+	}
+
+	//* drop: the consumer is stuck, so only the first chunks are written
+	constexpr size_t max_stuck_dim = (queue_dim + 1) * chunk_dim;
+	collector.reset(0, false);
+	AsyncSink_T drop_sink(callback_sink, Backpressure::drop);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, drop_sink);
+	collector.is_open.store(true);
+	drop_sink.flush();
+	const bool is_drop_good =
+	    collector.sample_count + drop_sink.get_dropped_count() == t_dim &&
+	    collector.sample_count >= queue_dim * chunk_dim &&
+	    collector.sample_count <= max_stuck_dim && is_subsequence(collector) &&
+	    collector.t_arr[collector.sample_count - 1] == t_ref[collector.sample_count - 1];
+
+	//* overwrite the oldest: the consumer is stuck, so the last chunks are written
+	collector.reset(0, false);
+	AsyncSink_T overwrite_sink(callback_sink, Backpressure::overwrite_oldest);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, overwrite_sink);
+	collector.is_open.store(true);
+	overwrite_sink.flush();
+	const bool is_overwrite_good =
+	    collector.sample_count + overwrite_sink.get_dropped_count() == t_dim &&
+	    collector.sample_count <= max_stuck_dim && is_subsequence(collector) &&
+	    collector.t_arr[collector.sample_count - 1] == t_ref[t_dim - 1];
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (is_block_good && is_ring_good && is_drop_good && is_overwrite_good) {
+		return 0;
+	} else {
+		printf("block: %d, ring: %d, drop: %d, overwrite: %d\n", is_block_good,
+		       is_ring_good, is_drop_good, is_overwrite_good);
+		printf("dropped: %zu, %zu of %zu samples\n", drop_sink.get_dropped_count(),
+		       overwrite_sink.get_dropped_count(), t_dim);
+		return 1;
+	}
+}
@@ -8,7 +8,6 @@
 //* setup
 const std::string test_name = "ball-test";
 const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
-const std::string ref_dat_prefix = test_config::ref_dat_dir + "/" + test_name + "-";
 
 constexpr size_t sample_freq = 1e4;
 constexpr Real_T time_step = 1. / sample_freq;
@@ -58,8 +57,8 @@ int
 main()
 {
 	//* 1. read the reference data
-	Real_T x_arr_ref[t_dim][x_dim];
-	matrix_rw::read(ref_dat_prefix + test_config::x_arr_ref_fname, x_arr_ref);
+	rk4_solver::TrajectoryReader<x_dim> x_arr_ref;
+	test_config::map_reference<t_dim>(test_name, t_init, time_step, x_arr_ref);
 
 	//* 2. test
 	Real_T t = 0;
@@ -72,7 +71,6 @@ main()
 
 	rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
 
-	integrator.reset();
 	rk4_solver::loop(integrator, event, t_init, x_init, t_arr[0], x_arr);
 
 	//* 3. write the test data
@@ -80,16 +78,8 @@ main()
 	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
 
 	//* 4. verify the results
-	Real_T x_0_arr[1][t_dim];
-	Real_T x_0_arr_ref[1][t_dim];
-
-	for (size_t i = 0; i < t_dim; ++i) {
-		const Real_T(&x)[x_dim] = x_arr[i];
-		const Real_T(&x_ref)[x_dim] = x_arr_ref[i];
-		x_0_arr[0][i] = x[verify_idx];
-		x_0_arr_ref[0][i] = x_ref[verify_idx];
-	}
-	Real_T max_error = test_config::compute_max_error(x_0_arr, x_0_arr_ref);
+	Real_T max_error =
+	    test_config::compute_max_error(x_arr, x_arr_ref, verify_idx, verify_idx + 1);
 
 	//* loop vs cum_loop sanity check
 	Real_T max_loop_error = 0.;
@@ -0,0 +1,132 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "batch-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr size_t n_dim = 8; //* ensemble size
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 1e-5;
+#else
+constexpr Real_T error_thres = 1e-12;
+#endif
+
+/*
+ * Damped oscillator:
+ * dt_x = [x2; -a*x1 - b*x2]
+ */
+Real_T
+get_a(const size_t j)
+{
+	return 1. + j;
+}
+constexpr Real_T b_const = .1;
+
+struct Dynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -a * x[0] - b_const * x[1];
+	}
+	Real_T a = 1.;
+};
+
+struct BatchDynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim][n_dim], Real_T (&dt_x)[x_dim][n_dim])
+	{
+		for (size_t j = 0; j < n_dim; ++j) {
+			dt_x[0][j] = x[1][j];
+			dt_x[1][j] = -get_a(j) * x[0][j] - b_const * x[1][j];
+		}
+	}
+};
+Dynamics dynamics;
+BatchDynamics batch_dynamics;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T x_init[x_dim][n_dim];
+
+	for (size_t j = 0; j < n_dim; ++j) {
+		x_init[0][j] = 1. + .5 * j;
+		x_init[1][j] = -.25 * j;
+	}
+	Real_T t = 0;
+	Real_T x[x_dim][n_dim];
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim][n_dim];
+
+	rk4_solver::BatchIntegrator<n_dim, x_dim, BatchDynamics> integrator(
+	    batch_dynamics, &BatchDynamics::ode_fun, time_step);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+
+	//* 3. write the test data
+	Real_T x_0_arr[t_dim][n_dim];
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		for (size_t j = 0; j < n_dim; ++j) {
+			x_0_arr[i][j] = x_arr[i][0][j];
+		}
+	}
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_0_arr);
+
+	//* 4. verify the results against the single integrator
+	Real_T max_error = 0.;
+
+	for (size_t j = 0; j < n_dim; ++j) {
+		dynamics.a = get_a(j);
+		rk4_solver::Integrator<x_dim, Dynamics> ref_integrator(dynamics, &Dynamics::ode_fun,
+		                                                       time_step);
+		Real_T t_ref;
+		Real_T x_ref[x_dim];
+		const Real_T x_init_j[x_dim] = {x_init[0][j], x_init[1][j]};
+		rk4_solver::loop<t_dim>(ref_integrator, t_init, x_init_j, t_ref, x_ref);
+
+		for (size_t i = 0; i < x_dim; ++i) {
+			const Real_T error = std::abs(x[i][j] - x_ref[i]);
+
+			if (error > max_error) {
+				max_error = error;
+			}
+		}
+	}
+
+	//* loop vs cum_loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[x_dim][n_dim] = x_arr[t_dim - 1];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		for (size_t j = 0; j < n_dim; ++j) {
+			const Real_T error = std::abs(x_final[i][j] - x[i][j]);
+
+			if (error > max_loop_error) {
+				max_loop_error = error;
+			}
+		}
+	}
+
+	if (max_error < error_thres && max_loop_error <= std::numeric_limits<Real_T>::epsilon()) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		return 1;
+	}
+}
@@ -0,0 +1,133 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "binding-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T omega = 2 * M_PI;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 1e-4;
+#else
+constexpr Real_T error_thres = 1e-9;
+#endif
+
+struct Dynamics {
+	/*
+	 * dt_x = f(t, x) = [x_1; -w^2*x_0]
+	 * x = [cos(w*t); -w*sin(w*t)]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -omega * omega * x[0];
+	}
+};
+Dynamics dynamics;
+
+//* free function
+void
+free_ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+{
+	dynamics.ode_fun(t, x, dt_x);
+}
+
+//* absolute difference between two state histories, 0 if they are identical
+Real_T
+compute_difference(const Real_T (&x_arr)[t_dim][x_dim], const Real_T (&x_arr_ref)[t_dim][x_dim])
+{
+	Real_T difference = 0.;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		for (size_t j = 0; j < x_dim; ++j) {
+			difference = std::fmax(difference, std::abs(x_arr[i][j] - x_arr_ref[i][j]));
+		}
+	}
+	return difference;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+	Real_T x_arr_static[t_dim][x_dim];
+	Real_T x_arr_lambda[t_dim][x_dim];
+	Real_T x_arr_free[t_dim][x_dim];
+	Real_T x_arr_event[t_dim][x_dim];
+
+	//* member function pointer
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+
+	//* member function bound at compile time
+	auto static_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun>(dynamics, time_step);
+	rk4_solver::loop(static_integrator, t_init, x_init, t_arr[0], x_arr_static);
+
+	//* lambda with a captured object
+	auto lambda_integrator = rk4_solver::make_integrator<x_dim>(
+	    [&](const Real_T t, const Real_T(&x)[x_dim], Real_T(&dt_x)[x_dim]) {
+		    dynamics.ode_fun(t, x, dt_x);
+	    },
+	    time_step);
+	rk4_solver::loop(lambda_integrator, t_init, x_init, t_arr[0], x_arr_lambda);
+
+	//* free function
+	auto free_integrator = rk4_solver::make_integrator<x_dim>(&free_ode_fun, time_step);
+	rk4_solver::loop(free_integrator, t_init, x_init, t_arr[0], x_arr_free);
+
+	//* lambda event that counts the checks without changing the state
+	size_t event_count = 0;
+	auto event = rk4_solver::make_event<x_dim>(
+	    [&](const Real_T, const Real_T(&x)[x_dim], Real_T(&x_plus)[x_dim]) {
+		    x_plus[0] = x[0];
+		    x_plus[1] = x[1];
+		    ++event_count;
+		    return 1;
+	    });
+	const size_t step_count =
+	    rk4_solver::loop(integrator, event, t_init, x_init, t_arr[0], x_arr_event);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr_lambda);
+
+	//* 4. verify the results
+	Real_T x_arr_ref[t_dim][x_dim];
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		const Real_T t = t_arr[0][i];
+		Real_T x_ref[x_dim] = {std::cos(omega * t), -omega * std::sin(omega * t)};
+		matrix_op::replace_row(i, x_ref, x_arr_ref);
+	}
+	const Real_T max_error = test_config::compute_max_error(x_arr, x_arr_ref);
+
+	//* all bindings must give identical results
+	Real_T max_difference = compute_difference(x_arr_static, x_arr);
+	max_difference = std::fmax(max_difference, compute_difference(x_arr_lambda, x_arr));
+	max_difference = std::fmax(max_difference, compute_difference(x_arr_free, x_arr));
+	max_difference = std::fmax(max_difference, compute_difference(x_arr_event, x_arr));
+
+	if (max_error < error_thres && max_difference == 0 && event_count == t_dim - 1 &&
+	    step_count == t_dim - 1) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_difference = %.3g\n", max_difference);
+		printf("event_count = %zu\n", event_count);
+		return 1;
+	}
+}
@@ -0,0 +1,170 @@
+#include "test_config.hpp"
+#include <vector>
+
+//* setup
+const std::string test_name = "dynamic-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e5;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1e-2;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 3;
+constexpr Real_T x_init[x_dim] = {1e1, 1e0, 0};
+constexpr size_t node_dim = 100; //* interior nodes of the heat equation
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 1e-4;
+#else
+constexpr Real_T error_thres = 1e-12;
+#endif
+
+struct Dynamics {
+	/*
+	 * dt_x = A * x
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+
+	void
+	dynamic_ode_fun(const Real_T, rk4_solver::Span<const Real_T> x,
+	                rk4_solver::Span<Real_T> dt_x)
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = x[2];
+		dt_x[2] = -a0 * dt_x[0] - a1 * x[1] - a2 * x[2];
+	}
+	const Real_T a0 = 1e1;
+	const Real_T a1 = 1e0;
+	const Real_T a2 = 1e-1;
+};
+Dynamics dynamics;
+
+struct Heat {
+	/*
+	 * Heat equation on [0, 1] with zero boundary values, discretized with central differences:
+	 * dt_u_i = (u_{i-1} - 2 u_i + u_{i+1}) / dx^2
+	 */
+	void
+	ode_fun(const Real_T, rk4_solver::Span<const Real_T> u, rk4_solver::Span<Real_T> dt_u)
+	{
+		const size_t n = u.size;
+		const Real_T inv_dx_sq = (n + 1) * (n + 1);
+
+		for (size_t i = 0; i < n; ++i) {
+			const Real_T u_prev = i > 0 ? u[i - 1] : 0;
+			const Real_T u_next = i + 1 < n ? u[i + 1] : 0;
+			dt_u[i] = (u_prev - 2 * u[i] + u_next) * inv_dx_sq;
+		}
+	}
+};
+Heat heat;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+	Real_T t_arr_dyn[1][t_dim];
+	Real_T x_arr_dyn[t_dim][x_dim];
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+
+	//* the arena is supplied by the caller
+	alignas(64) Real_T arena[rk4_solver::DynamicIntegrator<Dynamics>::get_arena_dim(x_dim)];
+	rk4_solver::DynamicIntegrator<Dynamics> dynamic_integrator(
+	    dynamics, &Dynamics::dynamic_ode_fun, x_dim, arena, time_step);
+	const bool is_loop_good =
+	    rk4_solver::loop(dynamic_integrator, t_init, x_init, t_dim, t_arr_dyn[0], x_arr_dyn);
+
+	//* size mismatches are rejected
+	Real_T t;
+	Real_T x_short[x_dim - 1];
+	const bool is_mismatch_rejected =
+	    !rk4_solver::loop(dynamic_integrator, t_init, x_init, t_dim, t, x_short) &&
+	    !rk4_solver::DynamicIntegrator<Dynamics>(dynamics, &Dynamics::dynamic_ode_fun, x_dim,
+	                                             rk4_solver::Span<Real_T>(arena, 1), time_step)
+	         .is_good();
+
+	std::vector<Real_T> u(node_dim);
+	std::vector<Real_T> u_init(node_dim);
+	constexpr Real_T dx = 1. / (node_dim + 1);
+
+	for (size_t i = 0; i < node_dim; ++i) {
+		u_init[i] = std::sin(M_PI * (i + 1) * dx);
+	}
+#ifdef DO_NOT_USE_HEAP
+	//* over-allocate to align the arena
+	constexpr size_t align_dim = 64 / sizeof(Real_T);
+	const size_t arena_dim = rk4_solver::DynamicIntegrator<Heat>::get_arena_dim(node_dim);
+	std::vector<Real_T> heat_arena(arena_dim + align_dim);
+	const size_t offset =
+	    (64 - reinterpret_cast<std::uintptr_t>(heat_arena.data()) % 64) % 64 / sizeof(Real_T);
+	rk4_solver::DynamicIntegrator<Heat> heat_integrator(
+	    heat, &Heat::ode_fun, node_dim, {heat_arena.data() + offset, arena_dim}, time_step);
+#else
+	rk4_solver::DynamicIntegrator<Heat> heat_integrator(heat, &Heat::ode_fun, node_dim,
+	                                                    time_step);
+#endif
+	rk4_solver::loop(heat_integrator, t_init, {u_init.data(), node_dim}, t_dim, t,
+	                 {u.data(), node_dim});
+
+#ifdef DO_NOT_USE_HEAP
+	const bool is_allocator_used = true; //* the arena is always supplied by the caller
+#else
+	//* the arena is allocated from an `Arena`, which only fits one
+	using DynamicIntegrator_T = rk4_solver::DynamicIntegrator<Dynamics>;
+	alignas(rk4_solver::cache_line_size) unsigned char
+	    buffer[DynamicIntegrator_T::get_arena_dim(x_dim) * sizeof(Real_T)];
+	rk4_solver::Arena buffer_arena(buffer, sizeof(buffer));
+	DynamicIntegrator_T arena_integrator(dynamics, &Dynamics::dynamic_ode_fun, x_dim, time_step,
+	                                     t_init, buffer_arena.get_allocator());
+	DynamicIntegrator_T full_integrator(dynamics, &Dynamics::dynamic_ode_fun, x_dim, time_step,
+	                                    t_init, buffer_arena.get_allocator());
+	Real_T x_arena[x_dim];
+	const bool is_allocator_used =
+	    arena_integrator.is_good() && !full_integrator.is_good() &&
+	    rk4_solver::loop(arena_integrator, t_init, x_init, t_dim, t, x_arena) &&
+	    x_arena[0] == x_arr_dyn[t_dim - 1][0];
+#endif
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr_dyn);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr_dyn);
+
+	//* 4. verify the results
+	Real_T max_error = test_config::compute_max_error(x_arr_dyn, x_arr);
+	max_error = std::fmax(max_error, test_config::compute_max_error(t_arr_dyn, t_arr));
+
+	//* the semi-discrete solution is sin(pi x) * exp(lambda t)
+	const Real_T s = std::sin(M_PI * dx / 2);
+	const Real_T lambda = -4 * s * s / (dx * dx);
+	Real_T max_heat_error = 0.;
+
+	for (size_t i = 0; i < node_dim; ++i) {
+		const Real_T u_ref = u_init[i] * std::exp(lambda * t);
+		max_heat_error = std::fmax(max_heat_error, std::abs(u[i] - u_ref));
+	}
+
+	if (is_loop_good && is_mismatch_rejected && is_allocator_used && max_error <= error_thres &&
+	    max_heat_error < error_thres) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_heat_error = %.3g\n", max_heat_error);
+		printf("is_loop_good = %d, is_mismatch_rejected = %d, is_allocator_used = %d\n",
+		       is_loop_good, is_mismatch_rejected, is_allocator_used);
+		return 1;
+	}
+}
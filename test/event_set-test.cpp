@@ -0,0 +1,318 @@
+#include "test_config.hpp"
+
+/*
+ * Same as zero_crossing-test, but the impact is one event of a set with events that must not
+ * occur, and the order of simultaneous events is verified.
+ */
+
+//* setup
+constexpr size_t sample_freq = 1e2;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+constexpr Real_T ceiling_height = 2.;
+constexpr size_t log_dim = 8;
+constexpr Real_T coarse_time_step = .6; //* the bounces before 3 s get shorter than a step
+constexpr size_t coarse_t_dim = 6;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 2e-3;
+#else
+constexpr Real_T error_thres = 1e-9;
+#endif
+
+//* exact height of the ball, found by stepping from impact to impact analytically
+Real_T
+get_exact_height(const Real_T t)
+{
+	Real_T x_0 = x_init[0];
+	Real_T x_1 = x_init[1];
+	Real_T t_impact = t_init;
+
+	while (true) {
+		const Real_T t_fall =
+		    (x_1 + std::sqrt(x_1 * x_1 + 2 * gravity_const * x_0)) / gravity_const;
+
+		if (t_impact + t_fall >= t) {
+			const Real_T dt = t - t_impact;
+			return x_0 + x_1 * dt - gravity_const * dt * dt / 2;
+		}
+		x_1 = -e_restitution * (x_1 - gravity_const * t_fall);
+		x_0 = 0;
+		t_impact += t_fall;
+	}
+}
+
+struct Dynamics {
+	/*
+	 * Ball equations:
+	 * dt_x =  [x2; -g]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	Real_T
+	floor_guard_fun(const Real_T, const Real_T (&x)[x_dim])
+	{
+		return x[0];
+	}
+
+	Real_T
+	ceiling_guard_fun(const Real_T, const Real_T (&x)[x_dim])
+	{
+		return ceiling_height - x[0];
+	}
+
+	void
+	impact_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		x_plus[0] = 0;
+		x_plus[1] = -e_restitution * x[1];
+	}
+
+	//* reverses the velocity, and logs its id and the velocity before the reset
+	void
+	reverse_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		write_log(0, x);
+		x_plus[0] = 0;
+		x_plus[1] = -x[1];
+	}
+
+	//* damps the velocity, and logs its id and the velocity before the reset
+	void
+	damp_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		write_log(1, x);
+		x_plus[0] = x[0];
+		x_plus[1] = e_restitution * x[1];
+	}
+
+	//* keeps the height, which is at or just below zero after the crossing was located
+	void
+	bounce_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		x_plus[0] = x[0];
+		x_plus[1] = -e_restitution * x[1];
+	}
+
+	//* stops, and logs its id and the velocity before the reset
+	void
+	stop_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		write_log(2, x);
+		x_plus[0] = 0;
+		x_plus[1] = 0;
+	}
+
+	void
+	write_log(const size_t id, const Real_T (&x)[x_dim])
+	{
+		if (log_count < log_dim) {
+			id_log[log_count] = id;
+			velocity_log[log_count] = x[1];
+		}
+		++log_count;
+	}
+
+	size_t log_count = 0;
+	size_t id_log[log_dim] = {};
+	Real_T velocity_log[log_dim] = {};
+};
+Dynamics dynamics;
+
+//* guard of a floor at `height`, bound by value in an event set without an object
+struct FloorGuard {
+	Real_T
+	operator()(const Real_T, const Real_T (&x)[x_dim]) const
+	{
+		return x[0] - height;
+	}
+
+	Real_T height;
+};
+
+//* impact on a floor at `height`, bound by value in an event set without an object
+struct FloorImpact {
+	void
+	operator()(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim]) const
+	{
+		x_plus[0] = height;
+		x_plus[1] = -e_restitution * x[1];
+	}
+
+	Real_T height;
+};
+
+using rk4_solver::CallableBinding;
+using rk4_solver::Crossing;
+using EventSet_T = rk4_solver::EventSet<x_dim, Dynamics, 4>;
+using BoundEventSet_T =
+    rk4_solver::EventSet<x_dim, FloorGuard, 2, Real_T, CallableBinding<FloorGuard>,
+                         CallableBinding<FloorImpact>>;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data, the exact solution is known
+
+	//* 2. test
+	auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun>(dynamics, time_step);
+	Real_T t_arr[t_dim];
+	Real_T x_arr[t_dim][x_dim];
+
+	//* the impact, and events that must not occur: the floor rising, the ceiling
+	EventSet_T events(dynamics);
+	events.add(&Dynamics::floor_guard_fun, &Dynamics::stop_fun, Crossing::rising, 1, true);
+	events.add(&Dynamics::floor_guard_fun, &Dynamics::impact_fun, Crossing::falling);
+	events.add(&Dynamics::ceiling_guard_fun, &Dynamics::stop_fun, Crossing::both, 2, true);
+	const size_t step_count = rk4_solver::loop<t_dim>(integrator, events, t_init, x_init, t_arr,
+	                                                  x_arr);
+	Real_T max_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		const Real_T error = std::abs(x_arr[i][0] - get_exact_height(t_arr[i]));
+		max_error = std::fmax(max_error, error);
+	}
+	const bool is_impact_good = step_count == t_dim - 1 && events.get_event_dim() == 3 &&
+	                            events.get_hit_count(0) == 0 && events.get_hit_count(1) > 1 &&
+	                            events.get_hit_count(2) == 0 && dynamics.log_count == 0 &&
+	                            events.get_terminal_idx() == 4;
+
+	//* in both directions, the bounce off the floor is not taken as a rising crossing
+	rk4_solver::EventSet<x_dim, Dynamics, 1> both_events(dynamics);
+	both_events.add(&Dynamics::floor_guard_fun, &Dynamics::bounce_fun);
+	rk4_solver::loop<t_dim>(integrator, both_events, t_init, x_init, t_arr, x_arr);
+	Real_T both_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		const Real_T error = std::abs(x_arr[i][0] - get_exact_height(t_arr[i]));
+		both_error = std::fmax(both_error, error);
+	}
+	const bool is_both_good = both_error < error_thres &&
+	                          both_events.get_hit_count(0) == events.get_hit_count(1);
+
+	//* bound functors, with a floor below the ground that must not be reached
+	BoundEventSet_T bound_events;
+	bound_events.add(CallableBinding<FloorGuard>({-1}), CallableBinding<FloorImpact>({-1}));
+	bound_events.add(CallableBinding<FloorGuard>({0}), CallableBinding<FloorImpact>({0}),
+	                 Crossing::falling);
+	rk4_solver::loop<t_dim>(integrator, bound_events, t_init, x_init, t_arr, x_arr);
+	Real_T bound_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		const Real_T error = std::abs(x_arr[i][0] - get_exact_height(t_arr[i]));
+		bound_error = std::fmax(bound_error, error);
+	}
+	const bool is_bound_good = bound_error < error_thres &&
+	                           bound_events.get_hit_count(0) == 0 &&
+	                           bound_events.get_hit_count(1) == events.get_hit_count(1);
+
+	//* the guard checks after every step, including the restarted ones, and the resets are
+	//* counted by the instrumentation of the integrator
+	auto instrumented_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun, rk4_solver::Instrumentation<>>(
+	        dynamics, time_step);
+	const size_t both_hit_count = both_events.get_hit_count(0);
+	rk4_solver::loop<t_dim>(instrumented_integrator, both_events, t_init, x_init, t_arr,
+	                        x_arr);
+	const rk4_solver::InstrumentationSnapshot snapshot =
+	    instrumented_integrator.get_instrumentation().snapshot();
+	const bool is_instrumentation_good =
+	    both_events.get_hit_count(0) == 2 * both_hit_count &&
+	    snapshot.event_hit_count == both_hit_count &&
+	    snapshot.event_check_count == t_dim - 1 + both_hit_count;
+
+	//* the ball bounces and falls back onto the floor within one step, several times
+	rk4_solver::Integrator<x_dim, Dynamics> coarse_integrator(dynamics, &Dynamics::ode_fun,
+	                                                          coarse_time_step);
+	EventSet_T coarse_events(dynamics);
+	coarse_events.add(&Dynamics::floor_guard_fun, &Dynamics::impact_fun, Crossing::falling);
+	coarse_events.add(&Dynamics::ceiling_guard_fun, &Dynamics::stop_fun, Crossing::both, 1,
+	                  true);
+	rk4_solver::EventSet<x_dim, Dynamics, 1> coarse_both_events(dynamics);
+	coarse_both_events.add(&Dynamics::floor_guard_fun, &Dynamics::bounce_fun);
+	Real_T t;
+	Real_T x[x_dim];
+	rk4_solver::loop<coarse_t_dim>(coarse_integrator, coarse_events, t_init, x_init, t, x);
+	Real_T coarse_error = std::abs(x[0] - get_exact_height(t));
+	rk4_solver::loop<coarse_t_dim>(coarse_integrator, coarse_both_events, t_init, x_init, t,
+	                               x);
+	coarse_error = std::fmax(coarse_error, std::abs(x[0] - get_exact_height(t)));
+	const bool is_coarse_good = coarse_error < error_thres &&
+	                            coarse_events.get_hit_count(0) ==
+	                                coarse_both_events.get_hit_count(0) &&
+	                            coarse_events.get_terminal_idx() == 4;
+
+	//* a full set rejects more events
+	const bool is_full_good =
+	    events.add(&Dynamics::floor_guard_fun, &Dynamics::damp_fun) &&
+	    !events.add(&Dynamics::floor_guard_fun, &Dynamics::damp_fun);
+
+	//* simultaneous events are reset by descending priority, then in the order they were added
+	EventSet_T ordered_events(dynamics);
+	ordered_events.add(&Dynamics::floor_guard_fun, &Dynamics::damp_fun, Crossing::falling, 0);
+	ordered_events.add(&Dynamics::floor_guard_fun, &Dynamics::reverse_fun, Crossing::falling,
+	                   1);
+	ordered_events.add(&Dynamics::floor_guard_fun, &Dynamics::damp_fun, Crossing::falling, 0);
+	dynamics.log_count = 0;
+	rk4_solver::loop<t_dim>(integrator, ordered_events, t_init, x_init, t, x);
+	//* the reverse first, then both damps, each of the state after the last reset
+	const bool is_order_good = dynamics.log_count >= 3 && dynamics.id_log[0] == 0 &&
+	                           dynamics.id_log[1] == 1 && dynamics.id_log[2] == 1 &&
+	                           dynamics.velocity_log[0] < 0 && dynamics.velocity_log[1] > 0 &&
+	                           dynamics.velocity_log[2] ==
+	                               e_restitution * dynamics.velocity_log[1] &&
+	                           ordered_events.get_hit_count(0) ==
+	                               ordered_events.get_hit_count(2) &&
+	                           ordered_events.get_terminal_idx() == 4;
+
+	//* a terminal event of the highest priority stops before the others are reset
+	EventSet_T terminal_events(dynamics);
+	terminal_events.add(&Dynamics::floor_guard_fun, &Dynamics::reverse_fun, Crossing::falling,
+	                    1);
+	terminal_events.add(&Dynamics::floor_guard_fun, &Dynamics::stop_fun, Crossing::falling, 2,
+	                    true);
+	dynamics.log_count = 0;
+	rk4_solver::loop<t_dim>(integrator, terminal_events, t_init, x_init, t, x);
+	const Real_T t_impact = std::sqrt(2 * x_init[0] / gravity_const);
+	const bool is_terminal_good = dynamics.log_count == 1 && dynamics.id_log[0] == 2 &&
+	                              terminal_events.get_hit_count(0) == 0 &&
+	                              terminal_events.get_hit_count(1) == 1 &&
+	                              terminal_events.get_terminal_idx() == 1 && x[0] == 0 &&
+	                              x[1] == 0 && std::abs(t - t_impact) < error_thres;
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (max_error < error_thres && is_impact_good && is_full_good && is_order_good &&
+	    is_terminal_good && is_both_good && is_bound_good && is_instrumentation_good &&
+	    is_coarse_good) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("impact: %d, full: %d, order: %d, terminal: %d, both: %d\n", is_impact_good,
+		       is_full_good, is_order_good, is_terminal_good, is_both_good);
+		printf("bound: %d, instrumentation: %d, coarse: %d\n", is_bound_good,
+		       is_instrumentation_good, is_coarse_good);
+		printf("coarse_error = %.3g, hits: %zu %zu\n", coarse_error,
+		       coarse_events.get_hit_count(0), coarse_both_events.get_hit_count(0));
+		printf("both_error = %.3g, bound_error = %.3g\n", both_error, bound_error);
+		printf("checks: %zu, hits: %zu\n", static_cast<size_t>(snapshot.event_check_count),
+		       static_cast<size_t>(snapshot.event_hit_count));
+		printf("hits: %zu %zu %zu, log: %zu\n", events.get_hit_count(0),
+		       events.get_hit_count(1), events.get_hit_count(2), dynamics.log_count);
+		return 1;
+	}
+}
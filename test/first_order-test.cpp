@@ -47,7 +47,6 @@ main()
 	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
 	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
 
-	integrator.reset();
 	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
 
 	//* 3. write the test data
@@ -0,0 +1,144 @@
+#include "test_config.hpp"
+
+//* setup
+constexpr size_t sample_freq = 1e2;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr size_t t_dim = 1e3 + 1;
+constexpr size_t x_dim = 64;
+constexpr size_t large_x_dim = rk4_solver::simd::min_dim + 6; //* vectorized update with tails
+constexpr size_t history_t_dim = 11;
+
+//* the AVX-512 stage kernels of `Integrator` may fuse multiply-adds
+constexpr Real_T large_error_thres = sizeof(Real_T) == sizeof(float) ? 1e-5 : 1e-13;
+
+template <size_t X_DIM> struct Dynamics {
+	/*
+	 * Ring of coupled oscillators:
+	 * dt_x_(2i) = x_(2i+1), dt_x_(2i+1) = -x_(2i) + (x_(2i-2) - x_(2i))/4
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = 0; i < X_DIM; i += 2) {
+			const size_t i_prev = i == 0 ? X_DIM - 2 : i - 2;
+			dt_x[i] = x[i + 1];
+			dt_x[i + 1] = -x[i] + (x[i_prev] - x[i]) / 4;
+		}
+	}
+
+	//* the same with the stage input `x + a * k` formed on the fly
+	void
+	stage_fun(const Real_T, const Real_T (&x)[X_DIM], const Real_T (&k)[X_DIM], const Real_T a,
+	          Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = 0; i < X_DIM; i += 2) {
+			const size_t i_prev = i == 0 ? X_DIM - 2 : i - 2;
+			const Real_T x_i = x[i] + a * k[i];
+			dt_x[i] = x[i + 1] + a * k[i + 1];
+			dt_x[i + 1] = -x_i + ((x[i_prev] + a * k[i_prev]) - x_i) / 4;
+		}
+	}
+};
+
+template <size_t X_DIM>
+void
+init(Real_T (&x_init)[X_DIM])
+{
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+}
+
+//* largest difference of `arr` from `arr_ref`, relative to 1 or to `arr_ref`
+template <size_t N>
+Real_T
+compute_max_error(const Real_T (&arr)[N], const Real_T (&arr_ref)[N])
+{
+	Real_T max_error = 0;
+
+	for (size_t i = 0; i < N; ++i) {
+		const Real_T error = std::abs(arr[i] - arr_ref[i]);
+		max_error = std::fmax(max_error, error / std::fmax(1, std::abs(arr_ref[i])));
+	}
+	return max_error;
+}
+
+Dynamics<x_dim> dynamics;
+Dynamics<large_x_dim> large_dynamics;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data, the reference is `Integrator`
+
+	//* 2. test
+	Real_T x_init[x_dim];
+	Real_T t_ref;
+	Real_T x_ref[x_dim];
+	Real_T t;
+	Real_T x[x_dim];
+	init(x_init);
+
+	rk4_solver::Integrator<x_dim, Dynamics<x_dim>> ref_integrator(
+	    dynamics, &Dynamics<x_dim>::ode_fun, time_step);
+	rk4_solver::loop<t_dim>(ref_integrator, t_init, x_init, t_ref, x_ref);
+
+	//* member function pointer
+	rk4_solver::FusedIntegrator<x_dim, Dynamics<x_dim>> integrator(
+	    dynamics, &Dynamics<x_dim>::stage_fun, time_step);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	const Real_T member_error = std::fmax(compute_max_error(x, x_ref), std::abs(t - t_ref));
+
+	//* member function known at compile time, restarted after a reset
+	auto static_integrator =
+	    rk4_solver::make_fused_integrator<&Dynamics<x_dim>::stage_fun>(dynamics, time_step);
+	rk4_solver::loop<t_dim>(static_integrator, t_init, x_init, t, x);
+	rk4_solver::loop<t_dim>(static_integrator, t_init, x_init, t, x);
+	const Real_T static_error = std::fmax(compute_max_error(x, x_ref), std::abs(t - t_ref));
+
+	//* lambda, saving the history
+	auto callable_integrator = rk4_solver::make_fused_integrator<x_dim>(
+	    [](const Real_T t, const Real_T(&x)[x_dim], const Real_T(&k)[x_dim], const Real_T a,
+	       Real_T(&dt_x)[x_dim]) { dynamics.stage_fun(t, x, k, a, dt_x); },
+	    time_step);
+	Real_T t_arr[history_t_dim];
+	Real_T x_arr[history_t_dim][x_dim];
+	Real_T x_history_ref[x_dim];
+	rk4_solver::loop<history_t_dim>(ref_integrator, t_init, x_init, t_ref, x_history_ref);
+	rk4_solver::loop<history_t_dim>(callable_integrator, t_init, x_init, t_arr, x_arr);
+	const Real_T callable_error =
+	    std::fmax(compute_max_error(x_arr[history_t_dim - 1], x_history_ref),
+	              std::abs(t_arr[history_t_dim - 1] - t_ref));
+
+	//* the vectorized update of a larger system
+	Real_T large_x_init[large_x_dim];
+	Real_T large_x_ref[large_x_dim];
+	Real_T large_x[large_x_dim];
+	init(large_x_init);
+	auto large_ref_integrator = rk4_solver::make_integrator<&Dynamics<large_x_dim>::ode_fun>(
+	    large_dynamics, time_step);
+	rk4_solver::loop<t_dim>(large_ref_integrator, t_init, large_x_init, t_ref, large_x_ref);
+	auto large_integrator =
+	    rk4_solver::make_fused_integrator<&Dynamics<large_x_dim>::stage_fun>(large_dynamics,
+	                                                                          time_step);
+	rk4_solver::loop<t_dim>(large_integrator, t_init, large_x_init, t, large_x);
+	const Real_T large_error = compute_max_error(large_x, large_x_ref);
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	//* the fused stages form the same stage inputs as `Integrator`
+	if (integrator.is_good() && member_error == 0 && static_error == 0 && callable_error == 0 &&
+	    large_error < large_error_thres) {
+		return 0;
+	} else {
+		printf("member_error = %.3g\n", member_error);
+		printf("static_error = %.3g\n", static_error);
+		printf("callable_error = %.3g\n", callable_error);
+		printf("large_error = %.3g (threshold %.3g)\n", large_error, large_error_thres);
+		return 1;
+	}
+}
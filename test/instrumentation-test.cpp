@@ -0,0 +1,147 @@
+#include "test_config.hpp"
+#include <atomic>
+#include <thread>
+
+//* setup
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+
+struct Dynamics {
+	/*
+	 * Ball equations:
+	 * dt_x =  [x2; -g]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		if (x[0] <= 0) {
+			x_plus[0] = 0;
+			x_plus[1] = -e_restitution * x[1];
+			++bounce_count;
+			return true;
+		}
+		return false;
+	}
+	size_t bounce_count = 0;
+};
+Dynamics dynamics;
+
+using Instrumentation_T = rk4_solver::Instrumentation<true>;
+using EventBind_T = rk4_solver::MemberBinding<Dynamics, rk4_solver::EventFun_T<x_dim, Dynamics>>;
+using Event_T = rk4_solver::Event<x_dim, Dynamics, Real_T, EventBind_T, Instrumentation_T>;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t;
+	Real_T x[x_dim];
+	Real_T t_ref;
+	Real_T x_ref[x_dim];
+
+	//* uninstrumented reference
+	rk4_solver::Integrator<x_dim, Dynamics> ref_integrator(dynamics, &Dynamics::ode_fun,
+	                                                       time_step);
+	rk4_solver::Event<x_dim, Dynamics> ref_event(dynamics, &Dynamics::event_fun);
+	rk4_solver::loop<t_dim>(ref_integrator, ref_event, t_init, x_init, t_ref, x_ref);
+	const size_t bounce_count = dynamics.bounce_count;
+
+	//* instrumented, the event counts into the instrumentation of the integrator
+	auto integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun, Instrumentation_T>(dynamics, time_step);
+	Instrumentation_T &instrumentation = integrator.get_instrumentation();
+	Event_T event(dynamics, &Dynamics::event_fun, instrumentation);
+
+	//* snapshots from another thread while integrating must not go backwards
+	std::atomic<bool> is_done(false);
+	std::atomic<bool> is_monotonic(true);
+	std::thread reader([&]() {
+		uint64_t last_count = 0;
+
+		while (!is_done.load()) {
+			const uint64_t count = instrumentation.snapshot().ode_fun_count;
+
+			if (count < last_count) {
+				is_monotonic.store(false);
+			}
+			last_count = count;
+		}
+	});
+
+	dynamics.bounce_count = 0;
+	rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+	is_done.store(true);
+	reader.join();
+	const rk4_solver::InstrumentationSnapshot snapshot = instrumentation.snapshot();
+	const size_t instrumented_bounce_count = dynamics.bounce_count;
+
+	//* reset, then integrate again without the event
+	instrumentation.reset();
+	const rk4_solver::InstrumentationSnapshot reset_snapshot = instrumentation.snapshot();
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	const rk4_solver::InstrumentationSnapshot event_free_snapshot = instrumentation.snapshot();
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	bool is_good = is_monotonic.load() && bounce_count > 0 &&
+	               instrumented_bounce_count == bounce_count &&
+	               snapshot.step_count == t_dim - 1 &&
+	               snapshot.ode_fun_count == 4 * (t_dim - 1) &&
+	               snapshot.event_check_count == t_dim - 1 &&
+	               snapshot.event_hit_count == bounce_count &&
+	               snapshot.get_ticks(rk4_solver::Section::ode_fun) > 0 &&
+	               snapshot.get_ticks(rk4_solver::Section::stage) > 0 &&
+	               snapshot.get_ticks(rk4_solver::Section::event) > 0;
+
+	//* the reset snapshot is all zeros
+	is_good = is_good && reset_snapshot.step_count == 0 && reset_snapshot.ode_fun_count == 0 &&
+	          reset_snapshot.event_check_count == 0 && reset_snapshot.event_hit_count == 0 &&
+	          reset_snapshot.get_ticks(rk4_solver::Section::ode_fun) == 0;
+
+	is_good = is_good && event_free_snapshot.step_count == t_dim - 1 &&
+	          event_free_snapshot.event_check_count == 0 &&
+	          event_free_snapshot.get_ticks(rk4_solver::Section::event) == 0;
+
+	//* the instrumentation does not change the results of the event loop
+	Real_T max_error = 0;
+	rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+	max_error = std::fmax(max_error, std::abs(t - t_ref));
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		max_error = std::fmax(max_error, std::abs(x[i] - x_ref[i]));
+	}
+
+	if (is_good && max_error == 0) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("bounces: %zu (reference %zu)\n", instrumented_bounce_count, bounce_count);
+		printf("steps: %llu, ode_fun: %llu, event checks: %llu, event hits: %llu\n",
+		       static_cast<unsigned long long>(snapshot.step_count),
+		       static_cast<unsigned long long>(snapshot.ode_fun_count),
+		       static_cast<unsigned long long>(snapshot.event_check_count),
+		       static_cast<unsigned long long>(snapshot.event_hit_count));
+		printf("after reset: %llu steps\n",
+		       static_cast<unsigned long long>(reset_snapshot.step_count));
+		return 1;
+	}
+}
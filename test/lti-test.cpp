@@ -0,0 +1,143 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "lti-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0;
+constexpr Real_T t_final = 1;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 3;
+constexpr size_t u_dim = 1;
+constexpr Real_T x_init[x_dim] = {0, 0, 0};
+constexpr Real_T u_const[u_dim] = {1}; //* [V]
+
+constexpr Real_T R = 1.4;      //* [ohm]
+constexpr Real_T L = 1.7e-3;   //*  [ohm s]
+constexpr Real_T J = 1.29e-4;  //*  [kg m-2]
+constexpr Real_T b = 3.92e-4;  //*  [N m s]
+constexpr Real_T K_t = 6.4e-2; //*  [N m A-1]
+constexpr Real_T K_b = 6.4e-2; //*  [V s]
+constexpr Real_T A[x_dim][x_dim] = {{0, 1, 0}, {0, -b / J, K_t / J}, {0, -K_b / L, -R / L}};
+constexpr Real_T B[x_dim][u_dim] = {{0}, {0}, {1 / L}};
+
+//* undamped oscillator with a constant input for the exact discretization
+constexpr size_t osc_x_dim = 2;
+constexpr Real_T omega = 2 * M_PI;
+constexpr Real_T osc_A[osc_x_dim][osc_x_dim] = {{0, 1}, {-omega * omega, 0}};
+constexpr Real_T osc_B[osc_x_dim][u_dim] = {{0}, {1}};
+constexpr Real_T osc_x_init[osc_x_dim] = {1, 0};
+constexpr size_t osc_t_dim = 101;
+constexpr Real_T osc_time_step = 0.37; //* large step, requires scaling and squaring
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 1e-4;
+#else
+constexpr Real_T error_thres = 1e-10;
+#endif
+
+struct Dynamics {
+	/*
+	 * Motor equations with a constant input, see motor-test
+	 * dt_x = A*x + B*u
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		Real_T temp0[x_dim];
+		Real_T temp1[x_dim];
+
+		matrix_op::right_multiply(A, x, temp0);
+		matrix_op::right_multiply(B, u_const, temp1);
+		matrix_op::sum(temp0, temp1, dt_x);
+	}
+};
+Dynamics dynamics;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t;
+	Real_T x[x_dim];
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+	Real_T x_arr_ref[t_dim][x_dim];
+	Real_T u_arr[t_dim][u_dim];
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		u_arr[i][0] = u_const[0];
+	}
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr_ref);
+
+	rk4_solver::LtiIntegrator<x_dim, u_dim> lti_integrator(A, B, time_step);
+	rk4_solver::loop<t_dim>(lti_integrator, t_init, x_init, u_const, t, x);
+	rk4_solver::loop(lti_integrator, t_init, x_init, u_arr, t_arr[0], x_arr);
+
+	Real_T osc_t;
+	Real_T osc_x[osc_x_dim];
+	rk4_solver::LtiIntegrator<osc_x_dim, u_dim> osc_integrator(
+	    osc_A, osc_B, osc_time_step, t_init, rk4_solver::Discretization::exact);
+	rk4_solver::loop<osc_t_dim>(osc_integrator, t_init, osc_x_init, u_const, osc_t, osc_x);
+
+	//* a non-finite state matrix is reported instead of squaring without end
+	constexpr Real_T nan = std::numeric_limits<Real_T>::quiet_NaN();
+	constexpr Real_T inf = std::numeric_limits<Real_T>::infinity();
+	const Real_T nan_A[osc_x_dim][osc_x_dim] = {{0, 1}, {nan, 0}};
+	const Real_T inf_A[osc_x_dim][osc_x_dim] = {{0, 1}, {-inf, 0}};
+	rk4_solver::LtiIntegrator<osc_x_dim, u_dim> nan_integrator(
+	    nan_A, osc_B, osc_time_step, t_init, rk4_solver::Discretization::exact);
+	rk4_solver::LtiIntegrator<osc_x_dim, u_dim> inf_integrator(
+	    inf_A, osc_B, osc_time_step, t_init, rk4_solver::Discretization::exact);
+	const bool is_non_finite_bad = !nan_integrator.is_good() && !inf_integrator.is_good();
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	//* the Runge-Kutta 4th Order discretization against `Integrator`, relative to the state
+	Real_T max_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		for (size_t j = 0; j < x_dim; ++j) {
+			const Real_T error = std::abs(x_arr[i][j] - x_arr_ref[i][j]) /
+			                     std::fmax(std::abs(x_arr_ref[i][j]), 1);
+			max_error = std::fmax(max_error, error);
+		}
+	}
+
+	//* the exact discretization against the solution x_0 = u/w^2 + (x_0(0) - u/w^2)*cos(w*t)
+	const Real_T x_0_eq = u_const[0] / (omega * omega);
+	const Real_T osc_x_ref[osc_x_dim] = {
+	    x_0_eq + (osc_x_init[0] - x_0_eq) * std::cos(omega * osc_t),
+	    -omega * (osc_x_init[0] - x_0_eq) * std::sin(omega * osc_t)};
+	const Real_T osc_error = std::fmax(std::abs(osc_x[0] - osc_x_ref[0]),
+	                                   std::abs(osc_x[1] - osc_x_ref[1]) / omega);
+
+	//* loop vs cumulative loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[x_dim] = x_arr[t_dim - 1];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		max_loop_error = std::fmax(max_loop_error, std::abs(x_final[i] - x[i]));
+	}
+
+	if (max_error < error_thres && osc_error < error_thres && max_loop_error == 0 &&
+	    lti_integrator.is_good() && osc_integrator.is_good() && is_non_finite_bad) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("osc_error = %.3g\n", osc_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		printf("is_non_finite_bad = %d\n", is_non_finite_bad);
+		return 1;
+	}
+}
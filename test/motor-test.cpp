@@ -3,7 +3,6 @@
 //* setup
 const std::string test_name = "motor-test";
 const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
-const std::string ref_dat_prefix = test_config::ref_dat_dir + "/" + test_name + "-";
 
 constexpr size_t sample_freq = 1e3;
 constexpr Real_T time_step = 1. / sample_freq;
@@ -69,8 +68,8 @@ int
 main()
 {
 	//* 1. read the reference data
-	Real_T x_arr_ref[t_dim][x_dim];
-	matrix_rw::read(ref_dat_prefix + test_config::x_arr_ref_fname, x_arr_ref);
+	rk4_solver::TrajectoryReader<x_dim> x_arr_ref;
+	test_config::map_reference<t_dim>(test_name, t_init, time_step, x_arr_ref);
 
 	//* 2. test
 	Real_T t = 0;
@@ -80,7 +79,6 @@ main()
 	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
 
 	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
-	integrator.reset();
 	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
 
 	//* 3. write the test data
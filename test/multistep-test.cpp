@@ -0,0 +1,178 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "multistep-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr Real_T t_init = 0;
+
+//* harmonic oscillator for the observed order, x_0 = cos(omega*t)
+constexpr size_t osc_x_dim = 2;
+constexpr Real_T omega = 2 * M_PI;
+constexpr Real_T osc_x_init[osc_x_dim] = {1, 0};
+constexpr Real_T osc_t_final = 2;
+constexpr size_t coarse_t_dim = 81;
+constexpr Real_T coarse_time_step = (osc_t_final - t_init) / (coarse_t_dim - 1);
+constexpr size_t fine_t_dim = 2 * coarse_t_dim - 1;
+constexpr Real_T fine_time_step = coarse_time_step / 2;
+
+//* bouncing ball, see ball-test
+constexpr size_t ball_x_dim = 2;
+constexpr Real_T ball_x_init[ball_x_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+constexpr size_t ball_t_dim = 2001;
+constexpr Real_T ball_time_step = 1e-3;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T ball_error_thres = 1e-2;
+#else
+constexpr Real_T ball_error_thres = 1e-9;
+#endif
+constexpr Real_T order_thres = .3;
+
+struct Dynamics {
+	//* dt_x = [x_1; -omega^2*x_0]
+	void
+	osc_ode_fun(const Real_T, const Real_T (&x)[osc_x_dim], Real_T (&dt_x)[osc_x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -omega * omega * x[0];
+		++evaluation_count;
+	}
+
+	//* dt_x = [x_1; -g]
+	void
+	ball_ode_fun(const Real_T, const Real_T (&x)[ball_x_dim], Real_T (&dt_x)[ball_x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&x)[ball_x_dim], Real_T (&x_plus)[ball_x_dim])
+	{
+		bool did_occur = false;
+
+		if (x[0] <= 0) {
+			x_plus[0] = 0;
+			x_plus[1] = -e_restitution * x[1];
+			did_occur = true;
+		}
+		return did_occur;
+	}
+
+	size_t evaluation_count = 0;
+};
+Dynamics dynamics;
+
+//* error of the position and the scaled velocity, i.e. the phase and the amplitude error
+Real_T
+compute_osc_error(const Real_T t, const Real_T (&x)[osc_x_dim])
+{
+	const Real_T x_0_error = x[0] - std::cos(omega * t);
+	const Real_T x_1_error = x[1] / omega + std::sin(omega * t);
+	return std::sqrt(x_0_error * x_0_error + x_1_error * x_1_error);
+}
+
+/*
+ * Observed order on the harmonic oscillator
+ *
+ * 1. `mode`: evaluations per step
+ *
+ * OUT:
+ * 2. `evaluation_count`: evaluations of the ODE function in the coarse run
+ */
+Real_T
+compute_observed_order(const rk4_solver::PredictorCorrector mode, size_t &evaluation_count)
+{
+	using Integrator_T = rk4_solver::MultistepIntegrator<osc_x_dim, Dynamics>;
+	Real_T t;
+	Real_T x_coarse[osc_x_dim];
+	Real_T x_fine[osc_x_dim];
+
+	Integrator_T coarse_integrator(dynamics, &Dynamics::osc_ode_fun, coarse_time_step, t_init,
+	                               mode);
+	dynamics.evaluation_count = 0;
+	rk4_solver::loop<coarse_t_dim>(coarse_integrator, t_init, osc_x_init, t, x_coarse);
+	evaluation_count = dynamics.evaluation_count;
+	const Real_T coarse_error = compute_osc_error(t, x_coarse);
+
+	Integrator_T fine_integrator(dynamics, &Dynamics::osc_ode_fun, fine_time_step, t_init,
+	                             mode);
+	rk4_solver::loop<fine_t_dim>(fine_integrator, t_init, osc_x_init, t, x_fine);
+	const Real_T fine_error = compute_osc_error(t, x_fine);
+
+	return std::log2(coarse_error / fine_error);
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	size_t pece_evaluation_count;
+	size_t pec_evaluation_count;
+	const Real_T pece_order =
+	    compute_observed_order(rk4_solver::PredictorCorrector::pece, pece_evaluation_count);
+	const Real_T pec_order =
+	    compute_observed_order(rk4_solver::PredictorCorrector::pec, pec_evaluation_count);
+
+	//* bouncing ball with events against `Integrator`, both are exact between the bounces
+	Real_T t;
+	Real_T x[ball_x_dim];
+	Real_T t_arr[1][ball_t_dim];
+	Real_T x_arr[ball_t_dim][ball_x_dim];
+	Real_T x_arr_ref[ball_t_dim][ball_x_dim];
+
+	rk4_solver::Event<ball_x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+	rk4_solver::MultistepIntegrator<ball_x_dim, Dynamics> ball_integrator(
+	    dynamics, &Dynamics::ball_ode_fun, ball_time_step);
+	rk4_solver::loop<ball_t_dim>(ball_integrator, event, t_init, ball_x_init, t, x);
+	rk4_solver::loop(ball_integrator, event, t_init, ball_x_init, t_arr[0], x_arr);
+
+	rk4_solver::Integrator<ball_x_dim, Dynamics> integrator(dynamics, &Dynamics::ball_ode_fun,
+	                                                        ball_time_step);
+	rk4_solver::loop(integrator, event, t_init, ball_x_init, t_arr[0], x_arr_ref);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	//* 3 bootstrap steps with 6, 5 and 5 evaluations, then 2 (PECE) or 1 (PEC) per step
+	constexpr size_t step_dim = coarse_t_dim - 1;
+	const bool is_count_good = pece_evaluation_count == 16 + 2 * (step_dim - 3) &&
+	                           pec_evaluation_count == 16 + (step_dim - 3);
+
+	//* the height, since a bounce can be detected a step apart in single precision
+	Real_T ball_error = 0;
+
+	for (size_t i = 0; i < ball_t_dim; ++i) {
+		ball_error = std::fmax(ball_error, std::abs(x_arr[i][0] - x_arr_ref[i][0]));
+	}
+
+	//* loop vs cumulative loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[ball_x_dim] = x_arr[ball_t_dim - 1];
+
+	for (size_t i = 0; i < ball_x_dim; ++i) {
+		max_loop_error = std::fmax(max_loop_error, std::abs(x_final[i] - x[i]));
+	}
+
+	//* the error of PEC converges from above at these steps, so only the lower bound is checked
+	if (std::abs(pece_order - 4) < order_thres && pec_order > 4 - order_thres &&
+	    is_count_good && ball_error < ball_error_thres && max_loop_error == 0 &&
+	    ball_integrator.is_good()) {
+		return 0;
+	} else {
+		printf("pece_order = %.3g, pec_order = %.3g\n", pece_order, pec_order);
+		printf("pece_evaluation_count = %zu, pec_evaluation_count = %zu\n",
+		       pece_evaluation_count, pec_evaluation_count);
+		printf("ball_error = %.3g\n", ball_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		return 1;
+	}
+}
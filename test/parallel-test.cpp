@@ -0,0 +1,152 @@
+#include "test_config.hpp"
+
+//* setup
+constexpr size_t sample_freq = 1e2;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr size_t t_dim = 2e2 + 1;
+constexpr size_t thread_count = 4;
+//* 3 partitions of `min_partition_dim` states, which do not end at a multiple of the vector widths
+constexpr size_t x_dim = 3 * 4096 + 42;
+constexpr size_t small_x_dim = 64;
+constexpr size_t history_t_dim = 11;
+
+//* the AVX-512 stage kernels may fuse multiply-adds, which differ at the ends of the partitions
+constexpr Real_T error_thres = sizeof(Real_T) == sizeof(float) ? 1e-5 : 1e-13;
+
+template <size_t X_DIM> struct Dynamics {
+	/*
+	 * Ring of coupled oscillators:
+	 * dt_x_(2i) = x_(2i+1), dt_x_(2i+1) = -x_(2i) + (x_(2i-2) + x_(2i+2) - 2*x_(2i))/4
+	 */
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[X_DIM], Real_T (&dt_x)[X_DIM])
+	{
+		range_ode_fun(t, x, 0, X_DIM, dt_x);
+	}
+
+	//* `begin` and `end` are even, since the partitions start at cache lines
+	void
+	range_ode_fun(const Real_T, const Real_T (&x)[X_DIM], const size_t begin, const size_t end,
+	              Real_T (&dt_x)[X_DIM])
+	{
+		for (size_t i = begin; i < end; i += 2) {
+			const size_t i_prev = i == 0 ? X_DIM - 2 : i - 2;
+			const size_t i_next = i == X_DIM - 2 ? 0 : i + 2;
+			dt_x[i] = x[i + 1];
+			dt_x[i + 1] = -x[i] + (x[i_prev] + x[i_next] - 2 * x[i]) / 4;
+		}
+	}
+};
+
+template <size_t X_DIM>
+void
+init(Real_T (&x_init)[X_DIM])
+{
+	for (size_t i = 0; i < X_DIM; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+}
+
+//* largest difference of `arr` from `arr_ref`, relative to 1 or to `arr_ref`
+template <size_t N>
+Real_T
+compute_max_error(const Real_T (&arr)[N], const Real_T (&arr_ref)[N])
+{
+	Real_T max_error = 0;
+
+	for (size_t i = 0; i < N; ++i) {
+		const Real_T error = std::abs(arr[i] - arr_ref[i]);
+		max_error = std::fmax(max_error, error / std::fmax(1, std::abs(arr_ref[i])));
+	}
+	return max_error;
+}
+
+Dynamics<x_dim> dynamics;
+Dynamics<small_x_dim> small_dynamics;
+Real_T x_init[x_dim];
+Real_T x_ref[x_dim];
+Real_T x[x_dim];
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data, the reference is `Integrator`
+
+	//* 2. test
+	rk4_solver::ThreadPool pool(thread_count);
+	Real_T t_ref;
+	Real_T t;
+	init(x_init);
+
+	auto ref_integrator =
+	    rk4_solver::make_integrator<&Dynamics<x_dim>::ode_fun>(dynamics, time_step);
+	rk4_solver::loop<t_dim>(ref_integrator, t_init, x_init, t_ref, x_ref);
+
+	//* member function pointer, restarted after a reset
+	rk4_solver::ParallelIntegrator<x_dim, Dynamics<x_dim>> integrator(
+	    pool, dynamics, &Dynamics<x_dim>::range_ode_fun, time_step);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
+	const Real_T member_error = std::fmax(compute_max_error(x, x_ref), std::abs(t - t_ref));
+
+	//* the partitions cover the state and start at cache lines
+	bool is_partitioned = integrator.get_partition_dim() == 3 &&
+	                      integrator.get_partition_begin(0) == 0 &&
+	                      integrator.get_partition_begin(3) == x_dim;
+
+	for (size_t i = 1; i < 3; ++i) {
+		const size_t begin = integrator.get_partition_begin(i);
+		is_partitioned = is_partitioned && begin > integrator.get_partition_begin(i - 1) &&
+		                 begin * sizeof(Real_T) % rk4_solver::cache_line_size == 0;
+	}
+
+	//* member function known at compile time, with more threads than partitions
+	rk4_solver::ThreadPool large_pool(2 * thread_count);
+	constexpr auto range_ode_fun = &Dynamics<x_dim>::range_ode_fun;
+	auto static_integrator =
+	    rk4_solver::make_parallel_integrator<range_ode_fun>(large_pool, dynamics, time_step);
+	rk4_solver::loop<t_dim>(static_integrator, t_init, x_init, t, x);
+	const Real_T static_error = std::fmax(compute_max_error(x, x_ref), std::abs(t - t_ref));
+
+	//* lambda on a single partition, which is the same as `Integrator`, saving the history
+	auto small_integrator = rk4_solver::make_parallel_integrator<small_x_dim>(
+	    pool,
+	    [](const Real_T t, const Real_T(&x)[small_x_dim], const size_t begin, const size_t end,
+	       Real_T(&dt_x)[small_x_dim]) {
+		    small_dynamics.range_ode_fun(t, x, begin, end, dt_x);
+	    },
+	    time_step);
+	auto small_ref_integrator = rk4_solver::make_integrator<&Dynamics<small_x_dim>::ode_fun>(
+	    small_dynamics, time_step);
+	Real_T small_x_init[small_x_dim];
+	Real_T small_x_ref[small_x_dim];
+	Real_T t_arr[history_t_dim];
+	Real_T x_arr[history_t_dim][small_x_dim];
+	init(small_x_init);
+	rk4_solver::loop<history_t_dim>(small_ref_integrator, t_init, small_x_init, t_ref,
+	                                small_x_ref);
+	rk4_solver::loop<history_t_dim>(small_integrator, t_init, small_x_init, t_arr, x_arr);
+	const Real_T small_error =
+	    std::fmax(compute_max_error(x_arr[history_t_dim - 1], small_x_ref),
+	              std::abs(t_arr[history_t_dim - 1] - t_ref));
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (integrator.is_good() && is_partitioned && member_error < error_thres &&
+	    static_error < error_thres && small_integrator.get_partition_dim() == 1 &&
+	    small_error == 0) {
+		return 0;
+	} else {
+		printf("member_error = %.3g\n", member_error);
+		printf("static_error = %.3g\n", static_error);
+		printf("small_error = %.3g\n", small_error);
+		printf("partitions: %zu, %zu, %zu, %zu\n", integrator.get_partition_dim(),
+		       integrator.get_partition_begin(1), integrator.get_partition_begin(2),
+		       integrator.get_partition_begin(3));
+		return 1;
+	}
+}
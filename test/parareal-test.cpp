@@ -0,0 +1,108 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "parareal-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0;
+constexpr Real_T t_final = 20;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {2, 0};
+constexpr Real_T mu = 1;
+constexpr size_t slice_dim = 20;
+constexpr size_t slice_step_dim = (t_dim - 1) / slice_dim;
+constexpr size_t coarse_ratio = 100;
+constexpr size_t thread_dim = 4;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 1e-2;
+constexpr Real_T exact_error_thres = 1e-3;
+#else
+constexpr Real_T error_thres = 1e-6;
+constexpr Real_T exact_error_thres = 1e-10;
+#endif
+
+struct Dynamics {
+	/*
+	 * Van der Pol oscillator:
+	 * dt_x = [x_1; mu*(1 - x_0^2)*x_1 - x_0]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = mu * (1 - x[0] * x[0]) * x[1] - x[0];
+	}
+};
+Dynamics dynamics;
+
+//* largest relative difference of the slice boundaries to the serial trajectory
+Real_T
+compute_max_error(const Real_T (&x_arr)[slice_dim + 1][x_dim],
+                  const Real_T (&x_arr_ref)[t_dim][x_dim])
+{
+	Real_T max_error = 0;
+
+	for (size_t i = 0; i <= slice_dim; ++i) {
+		for (size_t j = 0; j < x_dim; ++j) {
+			const Real_T x_ref = x_arr_ref[i * slice_step_dim][j];
+			const Real_T error =
+			    std::abs(x_arr[i][j] - x_ref) / std::fmax(std::abs(x_ref), 1);
+			max_error = std::fmax(max_error, error);
+		}
+	}
+	return max_error;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	static Real_T t_arr_ref[1][t_dim];
+	static Real_T x_arr_ref[t_dim][x_dim];
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr_ref[0], x_arr_ref);
+
+	rk4_solver::ThreadPool pool(thread_dim);
+	rk4_solver::Parareal<slice_dim, x_dim, Dynamics> parareal(dynamics, &Dynamics::ode_fun,
+	                                                          time_step, coarse_ratio);
+	Real_T t_arr[1][slice_dim + 1];
+	Real_T x_arr[slice_dim + 1][x_dim];
+	const size_t iter_dim = parareal.solve<t_dim>(pool, x_init, t_arr[0], x_arr);
+	const Real_T max_error = compute_max_error(x_arr, x_arr_ref);
+
+	//* without a tolerance, it iterates until the boundaries stop changing
+	Real_T exact_t_arr[slice_dim + 1];
+	Real_T exact_x_arr[slice_dim + 1][x_dim];
+	const size_t exact_iter_dim =
+	    parareal.solve<t_dim>(pool, x_init, exact_t_arr, exact_x_arr, 0);
+	const Real_T exact_error = compute_max_error(exact_x_arr, x_arr_ref);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	Real_T max_t_error = 0;
+
+	for (size_t i = 0; i <= slice_dim; ++i) {
+		const Real_T t_error = std::abs(t_arr[0][i] - t_arr_ref[0][i * slice_step_dim]);
+		max_t_error = std::fmax(max_t_error, t_error);
+	}
+
+	if (max_error < error_thres && iter_dim < slice_dim && exact_error < exact_error_thres &&
+	    exact_iter_dim <= slice_dim && max_t_error == 0 && parareal.is_good()) {
+		return 0;
+	} else {
+		printf("max_error = %.3g after %zu iterations\n", max_error, iter_dim);
+		printf("exact_error = %.3g after %zu iterations\n", exact_error, exact_iter_dim);
+		printf("max_t_error = %.3g\n", max_t_error);
+		return 1;
+	}
+}
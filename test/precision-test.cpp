@@ -0,0 +1,184 @@
+#include "test_config.hpp"
+
+//* setup
+constexpr size_t sample_freq = 1e4;
+constexpr size_t t_dim = 1e4 + 1; //* 1 s
+constexpr size_t x_dim = 1;
+constexpr double sine_freq = 5.;
+constexpr double x_offset = 1e2; //* increments are lost against a large state
+constexpr double double_x_init[x_dim] = {x_offset};
+constexpr float float_x_init[x_dim] = {x_offset};
+
+constexpr double double_error_thres = 1e-9;
+constexpr double float_error_thres = 1e-3;
+constexpr double widened_error_thres = 1e-5;
+constexpr double crossing_error_thres = 1e-4;
+constexpr size_t chunk_dim = 16;
+constexpr size_t ring_dim = 64;
+
+struct Dynamics {
+	/*
+	 * dt_x = f(t, x) = 2*pi*f*cos(t*2*pi*f)
+	 * x = x_offset + sin(t*2*pi*f)
+	 */
+	template <typename R>
+	void
+	ode_fun(const R t, const R (&)[x_dim], R (&dt_x)[x_dim])
+	{
+		dt_x[0] = 2 * M_PI * sine_freq * std::cos(t * 2 * M_PI * sine_freq);
+	}
+
+	//* reflects the state at x_offset + 1/2
+	template <typename R>
+	bool
+	event_fun(const R, const R (&x)[x_dim], R (&x_plus)[x_dim])
+	{
+		if (x[0] > x_offset + .5) {
+			x_plus[0] = 2 * x_offset + 1 - x[0];
+			return true;
+		}
+		return false;
+	}
+
+	//* falls through zero when the state reaches x_offset + 1/2
+	template <typename R>
+	R
+	guard_fun(const R, const R (&x)[x_dim])
+	{
+		return x_offset + .5 - x[0];
+	}
+
+	template <typename R>
+	void
+	stop_fun(const R, const R (&x)[x_dim], R (&x_plus)[x_dim])
+	{
+		x_plus[0] = x[0];
+	}
+};
+Dynamics dynamics;
+
+//* maximum error of `x_arr` from the analytic solution
+template <typename R>
+double
+compute_max_error(const R (&t_arr)[t_dim], const R (&x_arr)[t_dim][x_dim])
+{
+	double max_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		const double t = t_arr[i];
+		const double x_ref = x_offset + std::sin(t * 2 * M_PI * sine_freq);
+		max_error = std::fmax(max_error, std::abs(x_arr[i][0] - x_ref));
+	}
+	return max_error;
+}
+
+float float_t_arr[t_dim];
+float float_x_arr[t_dim][x_dim];
+double double_t_arr[t_dim];
+double double_x_arr[t_dim][x_dim];
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	using rk4_solver::NoInstrumentation;
+	using rk4_solver::summation::None;
+	using rk4_solver::summation::Widened;
+
+	//* double precision, regardless of `USE_SINGLE_PRECISION`
+	auto double_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun<double>>(dynamics, 1. / sample_freq);
+	rk4_solver::loop(double_integrator, 0, double_x_init, double_t_arr, double_x_arr);
+	const double double_error = compute_max_error(double_t_arr, double_x_arr);
+
+	//* single precision in the same program, without compensation
+	auto float_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun<float>, NoInstrumentation, None>(
+		dynamics, 1.f / sample_freq);
+	rk4_solver::loop(float_integrator, 0, float_x_init, float_t_arr, float_x_arr);
+	const double float_error = compute_max_error(float_t_arr, float_x_arr);
+
+	//* single precision state, double precision accumulator
+	auto widened_integrator =
+	    rk4_solver::make_integrator<&Dynamics::ode_fun<float>, NoInstrumentation,
+	                                Widened<double>>(dynamics, 1.f / sample_freq);
+	rk4_solver::loop(widened_integrator, 0, float_x_init, float_t_arr, float_x_arr);
+	const double widened_error = compute_max_error(float_t_arr, float_x_arr);
+
+	//* member function pointers of another scalar type
+	rk4_solver::Integrator<x_dim, Dynamics, float> member_integrator(
+	    dynamics, &Dynamics::ode_fun<float>, 1.f / sample_freq);
+	rk4_solver::Event<x_dim, Dynamics, float> float_event(dynamics,
+	                                                      &Dynamics::event_fun<float>);
+	rk4_solver::loop(member_integrator, float_event, 0, float_x_init, float_t_arr, float_x_arr);
+	float float_max_x = x_offset;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		float_max_x = std::fmax(float_max_x, float_x_arr[i][0]);
+	}
+
+	//* the same event in double precision from a callable
+	auto double_event = rk4_solver::make_event<x_dim, double>(
+	    [](const double t, const double (&x)[x_dim], double (&x_plus)[x_dim]) {
+		    return dynamics.event_fun(t, x, x_plus);
+	    });
+	rk4_solver::loop(double_integrator, double_event, 0, double_x_init, double_t_arr,
+	                 double_x_arr);
+	double double_max_x = x_offset;
+	double max_event_error = 0;
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		double_max_x = std::fmax(double_max_x, double_x_arr[i][0]);
+		max_event_error =
+		    std::fmax(max_event_error, std::abs(double_x_arr[i][0] - float_x_arr[i][0]));
+	}
+
+	//* a terminal zero-crossing event, an event set and a sink in single precision
+	using rk4_solver::Crossing;
+	constexpr double t_cross = 1. / (12 * sine_freq); //* sin(t*2*pi*f) = 1/2
+	float float_t;
+	float float_x[x_dim];
+	rk4_solver::ZeroCrossingEvent<x_dim, Dynamics, float> crossing_event(
+	    dynamics, &Dynamics::guard_fun<float>, &Dynamics::stop_fun<float>, Crossing::falling,
+	    true);
+	rk4_solver::loop<t_dim>(member_integrator, crossing_event, 0, float_x_init, float_t,
+	                        float_x);
+	double crossing_error = std::abs(float_t - t_cross);
+
+	rk4_solver::EventSet<x_dim, Dynamics, 1, float> events(dynamics);
+	events.add(&Dynamics::guard_fun<float>, &Dynamics::stop_fun<float>, Crossing::falling, 0,
+	           true);
+	rk4_solver::loop<t_dim>(member_integrator, events, 0, float_x_init, float_t, float_x);
+	crossing_error = std::fmax(crossing_error, std::abs(float_t - t_cross));
+
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> sink;
+	rk4_solver::loop<t_dim>(member_integrator, 0, float_x_init, sink);
+	rk4_solver::loop<t_dim>(member_integrator, 0, float_x_init, float_t, float_x);
+	rk4_solver::Real_T sink_t;
+	rk4_solver::Real_T sink_x[x_dim];
+	sink.get(ring_dim - 1, sink_t, sink_x);
+	const bool is_sink_good =
+	    sink.get_total_count() == t_dim && sink_t == float_t && sink_x[0] == float_x[0];
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (double_error < double_error_thres && float_error < float_error_thres &&
+	    widened_error < widened_error_thres && widened_error < float_error / 10 &&
+	    float_max_x < x_offset + .51 && double_max_x < x_offset + .51 &&
+	    max_event_error < 1e-3 && crossing_error < crossing_error_thres && is_sink_good) {
+		return 0;
+	} else {
+		printf("double_error = %.3g\n", double_error);
+		printf("float_error = %.3g\n", float_error);
+		printf("widened_error = %.3g\n", widened_error);
+		printf("float_max_x = %.3g, double_max_x = %.3g\n", float_max_x, double_max_x);
+		printf("max_event_error = %.3g\n", max_event_error);
+		printf("crossing_error = %.3g, is_sink_good = %d\n", crossing_error, is_sink_good);
+		return 1;
+	}
+}
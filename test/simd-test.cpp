@@ -0,0 +1,153 @@
+#include "test_config.hpp"
+
+//* setup
+constexpr size_t sample_freq = 1e2;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t t_dim = 1e3 + 1;
+constexpr size_t x_dim = rk4_solver::simd::min_dim + 3; //* with tails for every vector width
+constexpr size_t kernel_dim = 41;
+
+//* the AVX-512 kernels may fuse multiply-adds, so the results may differ in the last bits
+constexpr double double_error_thres = 1e-13;
+constexpr float float_error_thres = 1e-5;
+
+template <typename R> struct Dynamics {
+	/*
+	 * dt_x_i = -x_i + x_(i-1)/2
+	 */
+	void
+	ode_fun(const R, const R (&x)[x_dim], R (&dt_x)[x_dim])
+	{
+		dt_x[0] = -x[0] + x[x_dim - 1] / 2;
+
+		for (size_t i = 1; i < x_dim; ++i) {
+			dt_x[i] = -x[i] + x[i - 1] / 2;
+		}
+	}
+};
+
+/*
+ * Integrates the ring with the instruction set `isa`.
+ *
+ * OUT:
+ * 2. `x`: final state
+ */
+template <typename R>
+void
+integrate(const rk4_solver::simd::Isa isa, R (&x)[x_dim])
+{
+	Dynamics<R> dynamics;
+	R x_init[x_dim];
+	R t;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		x_init[i] = 1 + i % 7;
+	}
+	rk4_solver::simd::set_isa(isa);
+	auto integrator =
+	    rk4_solver::make_integrator<&Dynamics<R>::ode_fun>(dynamics, static_cast<R>(time_step));
+	rk4_solver::loop<t_dim>(integrator, 0, x_init, t, x);
+}
+
+//* largest difference of `arr` from `arr_ref`, relative to 1 or to `arr_ref`
+template <typename R, size_t N>
+R
+compute_max_error(const R (&arr)[N], const R (&arr_ref)[N])
+{
+	R max_error = 0;
+
+	for (size_t i = 0; i < N; ++i) {
+		const R error = std::abs(arr[i] - arr_ref[i]) / std::fmax(1, std::abs(arr_ref[i]));
+		max_error = std::fmax(max_error, error);
+	}
+	return max_error;
+}
+
+//* largest difference of the kernels with `isa` from the scalar loops for all sizes
+template <typename R>
+R
+compare_kernels(const rk4_solver::simd::Isa isa)
+{
+	R x[kernel_dim];
+	R k[4][kernel_dim];
+	R x_stage[2][kernel_dim];
+	R c[2][kernel_dim];
+	R x_next[2][kernel_dim];
+	R max_error = 0;
+
+	for (size_t i = 0; i < kernel_dim; ++i) {
+		x[i] = 1 + std::sin(static_cast<R>(i));
+
+		for (size_t j = 0; j < 4; ++j) {
+			k[j][i] = std::cos(static_cast<R>(i + j));
+		}
+	}
+
+	for (size_t n = 0; n <= kernel_dim; ++n) {
+		for (size_t m = 0; m < 2; ++m) {
+			rk4_solver::simd::set_isa(m == 0 ? rk4_solver::simd::Isa::scalar : isa);
+
+			for (size_t i = 0; i < kernel_dim; ++i) {
+				x_stage[m][i] = 0;
+				c[m][i] = 1e-9 * i;
+				x_next[m][i] = 0;
+			}
+			rk4_solver::simd::stage_input<R>(n, x, .5, k[0], x_stage[m]);
+			rk4_solver::simd::kahan_update<R>(n, x, 1e-3, k[0], k[1], k[2], k[3], c[m],
+			                                  x_next[m]);
+		}
+		max_error = std::fmax(max_error, compute_max_error(x_stage[1], x_stage[0]));
+		max_error = std::fmax(max_error, compute_max_error(x_next[1], x_next[0]));
+	}
+	return max_error;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	using rk4_solver::simd::Isa;
+	const Isa detected_isa = rk4_solver::simd::get_isa();
+	double scalar_x[x_dim];
+	float scalar_float_x[x_dim];
+	integrate(Isa::scalar, scalar_x);
+	integrate(Isa::scalar, scalar_float_x);
+	bool is_good = true;
+
+	//* every supported instruction set gives the results of the inlined loops
+	for (const Isa isa : {Isa::sse2, Isa::avx2, Isa::avx512}) {
+		if (isa > detected_isa) {
+			is_good = is_good && !rk4_solver::simd::set_isa(isa);
+			continue;
+		}
+		double x[x_dim];
+		float float_x[x_dim];
+		integrate(isa, x);
+		integrate(isa, float_x);
+		const double max_error = std::fmax(compute_max_error(x, scalar_x),
+		                                   compare_kernels<double>(isa));
+		const float float_max_error = std::fmax(compute_max_error(float_x, scalar_float_x),
+		                                        compare_kernels<float>(isa));
+
+		if (max_error >= double_error_thres || float_max_error >= float_error_thres) {
+			printf("%s: max_error = %.3g, float_max_error = %.3g\n",
+			       rk4_solver::simd::get_isa_name(isa), max_error, float_max_error);
+			is_good = false;
+		}
+	}
+	rk4_solver::simd::set_isa(detected_isa);
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	if (is_good && rk4_solver::simd::get_isa() == detected_isa) {
+		return 0;
+	} else {
+		printf("detected: %s\n", rk4_solver::simd::get_isa_name(detected_isa));
+		return 1;
+	}
+}
@@ -47,8 +47,10 @@ main()
 	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
 	rk4_solver::loop<t_dim>(integrator, t_init, x_init, t, x);
 
-	integrator.reset();
+	//* the second loop starts from the first step again
 	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+	const bool is_restarted =
+	    integrator.get_step_count() == t_dim - 1 && t_arr[0][t_dim - 1] == t;
 
 	//* 3. write the test data
 	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
@@ -76,11 +78,13 @@ main()
 		}
 	}
 
-	if (max_error < error_thres && max_loop_error <= std::numeric_limits<Real_T>::epsilon()) {
+	if (max_error < error_thres && max_loop_error <= std::numeric_limits<Real_T>::epsilon() &&
+	    is_restarted) {
 		return 0;
 	} else {
 		printf("max_error = %.3g\n", max_error);
 		printf("max_loop_error = %.3g\n", max_loop_error);
+		printf("is_restarted = %d\n", is_restarted);
 		return 1;
 	}
 }
@@ -0,0 +1,123 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "sink-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+const std::string bin_fname = dat_prefix + "tx_arr.bin";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 1.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 1;
+constexpr Real_T x_init[x_dim] = {1.};
+constexpr Real_T a_const = 1.;
+constexpr size_t decimation = 7;
+constexpr size_t chunk_dim = 16;
+constexpr size_t ring_dim = 10;
+constexpr size_t saved_dim = (t_dim - 1) / decimation + 1;
+
+struct Dynamics {
+	/*
+	 * dt_x = f(t, x) = a*x
+	 * x = exp(a*t)
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = a_const * x[0];
+	}
+};
+Dynamics dynamics;
+
+//* collects the chunks in arrays
+struct Collector {
+	void
+	sink_fun(const Real_T (&t)[chunk_dim], const Real_T (&x)[chunk_dim][x_dim],
+	         const size_t count)
+	{
+		for (size_t i = 0; i < count && sample_count < saved_dim; ++i, ++sample_count) {
+			t_arr[0][sample_count] = t[i];
+			matrix_op::replace_row(sample_count, x[i], x_arr);
+		}
+	}
+	size_t sample_count = 0;
+	Real_T t_arr[1][saved_dim];
+	Real_T x_arr[saved_dim][x_dim];
+};
+Collector collector;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+
+	rk4_solver::CallbackSink<chunk_dim, x_dim, Collector> callback_sink(collector,
+	                                                                    &Collector::sink_fun);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, callback_sink, decimation);
+
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> ring_sink;
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, ring_sink);
+
+	//* a decimation of 0 saves every point
+	rk4_solver::RingBufferSink<ring_dim, chunk_dim, x_dim> undecimated_sink;
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, undecimated_sink, 0);
+
+	rk4_solver::FileSink<chunk_dim, x_dim> file_sink(bin_fname.c_str(), t_init, time_step);
+	rk4_solver::loop<t_dim>(integrator, t_init, x_init, file_sink);
+	file_sink.close();
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, collector.t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, collector.x_arr);
+
+	//* 4. verify the results against the cumulative loop
+	Real_T max_error = 0.;
+
+	//* callback sink: every `decimation`th point
+	for (size_t i = 0; i < saved_dim; ++i) {
+		const size_t j = i * decimation;
+		max_error = std::fmax(max_error, std::abs(collector.t_arr[0][i] - t_arr[0][j]));
+		max_error = std::fmax(max_error, std::abs(collector.x_arr[i][0] - x_arr[j][0]));
+	}
+
+	//* ring buffer sink: last `ring_dim` points
+	for (size_t i = 0; i < ring_sink.get_count(); ++i) {
+		Real_T t;
+		Real_T x[x_dim];
+		ring_sink.get(i, t, x);
+		max_error = std::fmax(max_error, std::abs(t - t_arr[0][t_dim - ring_dim + i]));
+		max_error = std::fmax(max_error, std::abs(x[0] - x_arr[t_dim - ring_dim + i][0]));
+	}
+
+	//* file sink: all points read back from the mapped file
+	rk4_solver::TrajectoryReader<x_dim> reader(bin_fname.c_str());
+	const size_t row_count = reader.get_t_dim();
+
+	for (size_t i = 0; i < row_count && i < t_dim; ++i) {
+		max_error = std::fmax(max_error, std::abs(reader.get_t(i) - t_arr[0][i]));
+		max_error = std::fmax(max_error, std::abs(reader.get_x(i)[0] - x_arr[i][0]));
+	}
+
+	if (max_error == 0 && collector.sample_count == saved_dim &&
+	    ring_sink.get_total_count() == t_dim && undecimated_sink.get_total_count() == t_dim &&
+	    row_count == t_dim && file_sink.is_good() && reader.is_good() &&
+	    reader.get_t_init() == t_init && reader.get_time_step() == time_step) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("callback sample count = %zu\n", collector.sample_count);
+		printf("ring buffer sample count = %zu\n", ring_sink.get_total_count());
+		printf("file row count = %zu\n", row_count);
+		return 1;
+	}
+}
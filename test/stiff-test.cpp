@@ -0,0 +1,212 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "stiff-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr Real_T t_init = 0;
+constexpr Real_T t_final = .2; //* before the slow mode settles
+constexpr size_t x_dim = 3;
+constexpr size_t u_dim = 1;
+constexpr Real_T x_init[x_dim] = {0, 0, 0};
+constexpr Real_T u_const[u_dim] = {1}; //* [V]
+
+//* motor equations, see motor-test, the eigenvalues are about -26.5 and -800 s^-1
+constexpr Real_T R = 1.4;      //* [ohm]
+constexpr Real_T L = 1.7e-3;   //*  [ohm s]
+constexpr Real_T J = 1.29e-4;  //*  [kg m-2]
+constexpr Real_T b = 3.92e-4;  //*  [N m s]
+constexpr Real_T K_t = 6.4e-2; //*  [N m A-1]
+constexpr Real_T K_b = 6.4e-2; //*  [V s]
+constexpr Real_T A[x_dim][x_dim] = {{0, 1, 0}, {0, -b / J, K_t / J}, {0, -K_b / L, -R / L}};
+constexpr Real_T B[x_dim][u_dim] = {{0}, {0}, {1 / L}};
+
+//* the Runge-Kutta 4th Order method is unstable for time steps above 2.785/800 s
+constexpr size_t large_t_dim = 21;
+constexpr Real_T large_time_step = (t_final - t_init) / (large_t_dim - 1);
+
+//* the order is observed at smaller steps
+constexpr size_t coarse_t_dim = 101;
+constexpr Real_T coarse_time_step = (t_final - t_init) / (coarse_t_dim - 1);
+constexpr size_t fine_t_dim = 2 * coarse_t_dim - 1;
+constexpr Real_T fine_time_step = coarse_time_step / 2;
+
+//* Prothero-Robinson problem, dt_x = -lambda*(x - cos(t)) - sin(t), x = cos(t)
+constexpr size_t pr_x_dim = 1;
+constexpr Real_T lambda = 1e6;
+constexpr Real_T pr_x_init[pr_x_dim] = {1};
+constexpr Real_T pr_t_final = 1;
+constexpr size_t pr_t_dim = 11;
+constexpr Real_T pr_time_step = (pr_t_final - t_init) / (pr_t_dim - 1);
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T jacobian_error_thres = 1e-2;
+#else
+constexpr Real_T jacobian_error_thres = 1e-6;
+#endif
+constexpr Real_T order_thres = .2;
+constexpr Real_T error_thres = 1e-2; //* at the large steps
+
+struct Dynamics {
+	//* dt_x = A*x + B*u
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		Real_T temp0[x_dim];
+		Real_T temp1[x_dim];
+
+		matrix_op::right_multiply(A, x, temp0);
+		matrix_op::right_multiply(B, u_const, temp1);
+		matrix_op::sum(temp0, temp1, dt_x);
+	}
+
+	//* jac = A
+	void
+	jacobian_fun(const Real_T, const Real_T (&)[x_dim], Real_T (&jac)[x_dim][x_dim])
+	{
+		for (size_t i = 0; i < x_dim; ++i) {
+			for (size_t j = 0; j < x_dim; ++j) {
+				jac[i][j] = A[i][j];
+			}
+		}
+	}
+
+	void
+	pr_ode_fun(const Real_T t, const Real_T (&x)[pr_x_dim], Real_T (&dt_x)[pr_x_dim])
+	{
+		dt_x[0] = -lambda * (x[0] - std::cos(t)) - std::sin(t);
+	}
+};
+Dynamics dynamics;
+
+//* relative error of the state at `t_final` against the exact discretization
+template <size_t T_DIM>
+Real_T
+compute_final_error(const Real_T time_step, const Real_T (&x)[x_dim])
+{
+	Real_T t_ref;
+	Real_T x_ref[x_dim];
+	rk4_solver::LtiIntegrator<x_dim, u_dim> lti_integrator(A, B, time_step, t_init,
+	                                                       rk4_solver::Discretization::exact);
+	rk4_solver::loop<T_DIM>(lti_integrator, t_init, x_init, u_const, t_ref, x_ref);
+
+	Real_T error = 0;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		const Real_T error_i = std::abs(x[i] - x_ref[i]) / std::fmax(std::abs(x_ref[i]), 1);
+		error = std::fmax(error, error_i);
+	}
+	return error;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t;
+	Real_T x_large[x_dim];
+	Real_T x_fd[x_dim];
+	Real_T x_rk4[x_dim];
+	Real_T x_coarse[x_dim];
+	Real_T x_fine[x_dim];
+	Real_T t_arr[1][large_t_dim];
+	Real_T x_arr[large_t_dim][x_dim];
+
+	//* the system is linear, so the Jacobian is computed once
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> large_integrator(
+	    dynamics, &Dynamics::ode_fun, &Dynamics::jacobian_fun, large_time_step, t_init,
+	    large_t_dim);
+	const bool is_large_good =
+	    rk4_solver::loop<large_t_dim>(large_integrator, t_init, x_init, t, x_large);
+	const bool is_arr_good =
+	    rk4_solver::loop(large_integrator, t_init, x_init, t_arr[0], x_arr);
+
+	//* finite difference Jacobian, recomputed every step
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> fd_integrator(
+	    dynamics, &Dynamics::ode_fun, large_time_step);
+	const bool is_fd_good =
+	    rk4_solver::loop<large_t_dim>(fd_integrator, t_init, x_init, t, x_fd);
+
+	//* the Runge-Kutta 4th Order method at the same step for comparison
+	rk4_solver::Integrator<x_dim, Dynamics> rk4_integrator(dynamics, &Dynamics::ode_fun,
+	                                                       large_time_step);
+	rk4_solver::loop<large_t_dim>(rk4_integrator, t_init, x_init, t, x_rk4);
+
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> coarse_integrator(
+	    dynamics, &Dynamics::ode_fun, &Dynamics::jacobian_fun, coarse_time_step);
+	const bool is_coarse_good =
+	    rk4_solver::loop<coarse_t_dim>(coarse_integrator, t_init, x_init, t, x_coarse);
+
+	rk4_solver::RosenbrockIntegrator<x_dim, Dynamics> fine_integrator(
+	    dynamics, &Dynamics::ode_fun, &Dynamics::jacobian_fun, fine_time_step);
+	const bool is_fine_good =
+	    rk4_solver::loop<fine_t_dim>(fine_integrator, t_init, x_init, t, x_fine);
+
+	//* time-varying, very stiff problem, bound as a lambda
+	Real_T pr_t;
+	Real_T pr_x[pr_x_dim];
+	auto pr_ode_fun = [](const Real_T t, const Real_T(&x)[pr_x_dim], Real_T(&dt_x)[pr_x_dim]) {
+		dynamics.pr_ode_fun(t, x, dt_x);
+	};
+	using PrBind_T = rk4_solver::CallableBinding<decltype(pr_ode_fun)>;
+	rk4_solver::RosenbrockIntegrator<pr_x_dim, PrBind_T, PrBind_T> pr_integrator(
+	    PrBind_T(pr_ode_fun), pr_time_step);
+	const bool is_pr_good =
+	    rk4_solver::loop<pr_t_dim>(pr_integrator, t_init, pr_x_init, pr_t, pr_x);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	//* stable and accurate at the large step, where the Runge-Kutta 4th Order method diverges
+	const Real_T large_error = compute_final_error<large_t_dim>(large_time_step, x_large);
+	const Real_T rk4_error = compute_final_error<large_t_dim>(large_time_step, x_rk4);
+	bool is_rk4_diverged = false;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		is_rk4_diverged = is_rk4_diverged || !std::isfinite(x_rk4[i]);
+	}
+	is_rk4_diverged = is_rk4_diverged || rk4_error > 1;
+
+	//* finite difference against the exact Jacobian
+	Real_T jacobian_error = 0;
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		jacobian_error = std::fmax(jacobian_error, std::abs(x_fd[i] - x_large[i]) /
+		                                               std::fmax(std::abs(x_large[i]), 1));
+	}
+
+	//* 2nd order convergence against the exact discretization
+	const Real_T coarse_error = compute_final_error<coarse_t_dim>(coarse_time_step, x_coarse);
+	const Real_T fine_error = compute_final_error<fine_t_dim>(fine_time_step, x_fine);
+	const Real_T observed_order = std::log2(coarse_error / fine_error);
+
+	const Real_T pr_error = std::abs(pr_x[0] - std::cos(pr_t));
+
+	//* loop vs cumulative loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[x_dim] = x_arr[large_t_dim - 1];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		max_loop_error = std::fmax(max_loop_error, std::abs(x_final[i] - x_large[i]));
+	}
+
+	if (large_error < error_thres && is_rk4_diverged && jacobian_error < jacobian_error_thres &&
+	    std::abs(observed_order - large_integrator.order) < order_thres &&
+	    pr_error < error_thres && max_loop_error == 0 && is_large_good && is_arr_good &&
+	    is_fd_good && is_coarse_good && is_fine_good && is_pr_good) {
+		return 0;
+	} else {
+		printf("large_error = %.3g, rk4_error = %.3g\n", large_error, rk4_error);
+		printf("jacobian_error = %.3g\n", jacobian_error);
+		printf("coarse_error = %.3g, fine_error = %.3g\n", coarse_error, fine_error);
+		printf("observed_order = %.3g\n", observed_order);
+		printf("pr_error = %.3g\n", pr_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		return 1;
+	}
+}
@@ -0,0 +1,275 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string motor_ref_fname =
+    test_config::ref_dat_dir + "/motor-test-" + test_config::x_arr_ref_fname;
+const std::string ball_ref_fname =
+    test_config::ref_dat_dir + "/ball-test-" + test_config::x_arr_ref_fname;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T sine_error_thres = 1e-5;
+constexpr Real_T motor_error_thres = 1e-5;
+constexpr Real_T ball_error_thres = 2e-3;
+#else
+constexpr Real_T sine_error_thres = 1e-9;
+constexpr Real_T motor_error_thres = 1e-12;
+constexpr Real_T ball_error_thres = 1e-3;
+#endif
+constexpr Real_T epsilon = std::numeric_limits<Real_T>::epsilon();
+
+//* the problems of sine-test, motor-test and ball-test
+namespace sine
+{
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t t_dim = 1e3 + 1;
+constexpr size_t x_dim = 1;
+constexpr Real_T x_init[x_dim] = {0.};
+constexpr Real_T sine_freq = 5.;
+
+struct Dynamics {
+	void
+	ode_fun(const Real_T t, const Real_T (&)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = 2 * M_PI * sine_freq * cos(t * 2 * M_PI * sine_freq);
+	}
+};
+} // namespace sine
+
+namespace motor
+{
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t t_dim = 1e3 + 1;
+constexpr size_t x_dim = 3;
+constexpr size_t u_dim = 1;
+constexpr Real_T x_init[x_dim] = {0, 0, 0};
+
+constexpr Real_T R = 1.4;
+constexpr Real_T L = 1.7e-3;
+constexpr Real_T J = 1.29e-4;
+constexpr Real_T b = 3.92e-4;
+constexpr Real_T K_t = 6.4e-2;
+constexpr Real_T K_b = 6.4e-2;
+constexpr Real_T A[x_dim][x_dim] = {{0, 1, 0}, {0, -b / J, K_t / J}, {0, -K_b / L, -R / L}};
+constexpr Real_T B[x_dim][u_dim] = {{0}, {0}, {1 / L}};
+constexpr Real_T since_ampl = 10;
+constexpr Real_T sine_freq = 10;
+
+struct Dynamics {
+	void
+	ode_fun(const Real_T t, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		Real_T temp0[x_dim];
+		Real_T temp1[x_dim];
+
+		const Real_T u[u_dim] = {
+		    static_cast<Real_T>(since_ampl * std::sin(t * 2 * M_PI * sine_freq))};
+		matrix_op::right_multiply(A, x, temp0);
+		matrix_op::right_multiply(B, u, temp1);
+		matrix_op::sum(temp0, temp1, dt_x);
+	}
+};
+Real_T x_arr_ref[t_dim][x_dim];
+} // namespace motor
+
+namespace ball
+{
+constexpr size_t sample_freq = 1e4;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr size_t t_dim = 2e4 + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+constexpr size_t verify_idx = 0;
+
+struct Dynamics {
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		if (x[0] <= 0) {
+			x_plus[0] = 0;
+			x_plus[1] = -e_restitution * x[1];
+			return true;
+		}
+		return false;
+	}
+};
+Real_T x_arr_ref[t_dim][x_dim];
+Real_T t_arr[t_dim];
+Real_T x_arr[t_dim][x_dim];
+} // namespace ball
+
+//* errors of a summation policy
+struct Errors {
+	Real_T sine;
+	Real_T motor;
+	Real_T ball;
+	Real_T small_dx; //* sum of many increments below the resolution of the state
+	Real_T large_dx; //* sum of increments much larger than the state
+};
+
+//* sums `dx_arr` starting from zero with `Summation_T`
+template <typename Summation_T, size_t N>
+Real_T
+sum(const Real_T (&dx_arr)[N])
+{
+	typename Summation_T::template Accumulator<Real_T> acc;
+	Summation_T::reset(acc);
+	Real_T x = 0;
+
+	for (size_t i = 0; i < N; ++i) {
+		x = Summation_T::add(x, dx_arr[i], acc);
+	}
+	return x;
+}
+
+template <typename Summation_T>
+Errors
+compute_errors()
+{
+	using rk4_solver::NoInstrumentation;
+	Errors errors;
+
+	{
+		using namespace sine;
+		Dynamics dynamics;
+		Real_T t_arr[t_dim];
+		Real_T x_arr[t_dim][x_dim];
+		Real_T x_arr_ref[t_dim][x_dim];
+		auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun, NoInstrumentation,
+		                                              Summation_T>(dynamics, time_step);
+		rk4_solver::loop(integrator, 0, x_init, t_arr, x_arr);
+
+		for (size_t i = 0; i < t_dim; ++i) {
+			x_arr_ref[i][0] = std::sin(t_arr[i] * 2 * M_PI * sine_freq);
+		}
+		errors.sine = test_config::compute_max_error(x_arr, x_arr_ref);
+	}
+	{
+		using namespace motor;
+		Dynamics dynamics;
+		Real_T t_arr[t_dim];
+		Real_T x_arr[t_dim][x_dim];
+		auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun, NoInstrumentation,
+		                                              Summation_T>(dynamics, time_step);
+		rk4_solver::loop(integrator, 0, x_init, t_arr, x_arr);
+		errors.motor = test_config::compute_max_error(x_arr, x_arr_ref);
+	}
+	{
+		using namespace ball;
+		Dynamics dynamics;
+		auto integrator = rk4_solver::make_integrator<&Dynamics::ode_fun, NoInstrumentation,
+		                                              Summation_T>(dynamics, time_step);
+		rk4_solver::Event<x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+		rk4_solver::loop(integrator, event, 0, x_init, t_arr, x_arr);
+
+		errors.ball = 0;
+
+		for (size_t i = 0; i < t_dim; ++i) {
+			const Real_T error = std::abs(x_arr[i][verify_idx] - x_arr_ref[i][verify_idx]);
+			errors.ball = std::fmax(errors.ball, error);
+		}
+	}
+	{
+		//* 1 + 2^20 * eps/4 is exact, but eps/4 alone is lost when added to 1
+		constexpr size_t dx_dim = 1 << 20;
+		static Real_T dx_arr[dx_dim + 1];
+		dx_arr[0] = 1;
+
+		for (size_t i = 1; i <= dx_dim; ++i) {
+			dx_arr[i] = epsilon / 4;
+		}
+		errors.small_dx = std::abs(sum<Summation_T>(dx_arr) - (1 + dx_dim * epsilon / 4));
+	}
+	{
+		//* 1 + big + 1 - big = 2
+		const Real_T big = 1 / epsilon / epsilon;
+		const Real_T dx_arr[] = {1, big, 1, -big};
+		errors.large_dx = std::abs(sum<Summation_T>(dx_arr) - 2);
+	}
+	return errors;
+}
+
+void
+print_errors(const char *name, const Errors &errors)
+{
+	printf("%-14s %12.3g %12.3g %12.3g %12.3g %12.3g\n", name, errors.sine, errors.motor,
+	       errors.ball, errors.small_dx, errors.large_dx);
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	matrix_rw::read(motor_ref_fname, motor::x_arr_ref);
+	matrix_rw::read(ball_ref_fname, ball::x_arr_ref);
+
+	//* 2. test
+	const Errors none = compute_errors<rk4_solver::summation::None>();
+	const Errors kahan = compute_errors<rk4_solver::summation::Kahan>();
+	const Errors neumaier = compute_errors<rk4_solver::summation::Neumaier>();
+	const Errors double_double = compute_errors<rk4_solver::summation::DoubleDouble>();
+
+	//* the default is Kahan's summation, bit for bit
+	Real_T default_error = 0;
+	{
+		using namespace ball;
+		Dynamics dynamics;
+		Real_T x_arr_kahan[t_dim][x_dim];
+		rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+		                                                   time_step);
+		rk4_solver::Event<x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+		rk4_solver::loop(integrator, event, 0, x_init, t_arr, x_arr);
+
+		for (size_t i = 0; i < t_dim; ++i) {
+			matrix_op::replace_row(i, x_arr[i], x_arr_kahan);
+		}
+
+		auto kahan_integrator =
+		    rk4_solver::make_integrator<&Dynamics::ode_fun, rk4_solver::NoInstrumentation,
+		                                rk4_solver::summation::Kahan>(dynamics, time_step);
+		rk4_solver::loop(kahan_integrator, event, 0, x_init, t_arr, x_arr);
+		default_error = test_config::compute_max_error(x_arr, x_arr_kahan);
+	}
+
+	//* 3. write the test data
+	//* no test data
+
+	//* 4. verify the results
+	printf("%-14s %12s %12s %12s %12s %12s\n", "Summation", "sine", "motor", "ball", "small dx",
+	       "large dx");
+	print_errors("none", none);
+	print_errors("Kahan", kahan);
+	print_errors("Neumaier", neumaier);
+	print_errors("double-double", double_double);
+
+	bool is_good = default_error == 0;
+
+	for (const Errors *errors : {&kahan, &neumaier, &double_double}) {
+		is_good = is_good && errors->sine < sine_error_thres &&
+		          errors->ball < ball_error_thres && errors->small_dx <= epsilon;
+#ifndef USE_SINGLE_PRECISION
+		//* the reference of the motor is only met in double precision, as in motor-test
+		is_good = is_good && errors->motor < motor_error_thres;
+#endif
+	}
+	//* only Neumaier's and the double-double summations handle the larger increments
+	is_good = is_good && neumaier.large_dx == 0 && double_double.large_dx == 0 &&
+	          kahan.large_dx > 0 && none.small_dx > epsilon;
+
+	if (is_good) {
+		return 0;
+	} else {
+		printf("default_error = %.3g\n", default_error);
+		return 1;
+	}
+}
@@ -0,0 +1,106 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "sweep-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr size_t task_dim = 101;
+constexpr size_t thread_dim = 4;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T gravity_const = 9.806;
+
+struct Dynamics {
+	/*
+	 * Ball equations:
+	 * dt_x =  [x2; -g]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		bool did_occur = false;
+
+		if (x[0] <= 0) {
+			x_plus[0] = 0;
+			x_plus[1] = -e_restitution * x[1];
+			did_occur = true;
+		}
+		return did_occur;
+	}
+	Real_T e_restitution = .75;
+};
+
+//* sweep the coefficient of restitution from 0 to 1
+Real_T
+param_gen(const size_t i)
+{
+	return static_cast<Real_T>(i) / (task_dim - 1);
+}
+
+Dynamics
+factory(const Real_T e_restitution)
+{
+	Dynamics dynamics;
+	dynamics.e_restitution = e_restitution;
+	return dynamics;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t_arr[1][task_dim];
+	Real_T x_arr[task_dim][x_dim];
+
+	rk4_solver::ThreadPool pool(thread_dim);
+	rk4_solver::sweep<t_dim>(pool, param_gen, factory, &Dynamics::ode_fun, &Dynamics::event_fun,
+	                         time_step, t_init, x_init, t_arr[0], x_arr);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results against the serial loop
+	Real_T x_arr_ref[task_dim][x_dim];
+	Real_T max_t_error = 0.;
+
+	for (size_t i = 0; i < task_dim; ++i) {
+		Dynamics dynamics = factory(param_gen(i));
+		rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun,
+		                                                   time_step);
+		rk4_solver::Event<x_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+		Real_T t;
+		rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x_arr_ref[i]);
+
+		const Real_T t_error = std::abs(t - t_arr[0][i]);
+
+		if (t_error > max_t_error) {
+			max_t_error = t_error;
+		}
+	}
+	Real_T max_error = test_config::compute_max_error(x_arr, x_arr_ref);
+
+	if (max_error <= std::numeric_limits<Real_T>::epsilon() &&
+	    max_t_error <= std::numeric_limits<Real_T>::epsilon()) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_t_error = %.3g\n", max_t_error);
+		return 1;
+	}
+}
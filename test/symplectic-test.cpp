@@ -0,0 +1,217 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "symplectic-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr Real_T t_init = 0;
+
+//* harmonic oscillator for the observed order, q = cos(omega*t)
+constexpr size_t osc_q_dim = 1;
+constexpr Real_T omega = 2 * M_PI;
+constexpr Real_T osc_x_init[2 * osc_q_dim] = {1, 0};
+constexpr Real_T osc_t_final = 2;
+constexpr size_t coarse_t_dim = 41;
+constexpr Real_T coarse_time_step = (osc_t_final - t_init) / (coarse_t_dim - 1);
+constexpr size_t fine_t_dim = 2 * coarse_t_dim - 1;
+constexpr Real_T fine_time_step = coarse_time_step / 2;
+
+//* Kepler orbit with the eccentricity 0.5 and the period 2*pi, starting at the periapsis
+constexpr size_t orbit_q_dim = 2;
+constexpr Real_T eccentricity = .5;
+constexpr Real_T orbit_x_init[2 * orbit_q_dim] = {1 - eccentricity, 0, 0, 1.7320508075688772};
+constexpr Real_T orbit_energy = -.5;
+constexpr size_t orbit_dim = 100;
+constexpr size_t orbit_step_dim = 200; //* steps per orbit
+constexpr size_t orbit_t_dim = orbit_dim * orbit_step_dim + 1;
+constexpr Real_T orbit_time_step = 2 * M_PI / orbit_step_dim;
+
+//* bouncing ball, see ball-test
+constexpr size_t ball_q_dim = 1;
+constexpr Real_T ball_x_init[2 * ball_q_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+constexpr size_t ball_t_dim = 2001;
+constexpr Real_T ball_time_step = 1e-3;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T verlet_energy_thres = 1e-2;
+constexpr Real_T yoshida_energy_thres = 1e-4;
+constexpr Real_T ball_error_thres = 1e-2;
+#else
+constexpr Real_T verlet_energy_thres = 1e-2;
+constexpr Real_T yoshida_energy_thres = 1e-4;
+constexpr Real_T ball_error_thres = 1e-9;
+#endif
+constexpr Real_T order_thres = .2;
+
+struct Dynamics {
+	//* dt_dt_q = -omega^2*q
+	void
+	osc_acceleration_fun(const Real_T, const Real_T (&q)[osc_q_dim],
+	                     const Real_T (&)[osc_q_dim], Real_T (&a)[osc_q_dim])
+	{
+		a[0] = -omega * omega * q[0];
+	}
+
+	//* dt_dt_q = -q/|q|^3
+	void
+	orbit_acceleration_fun(const Real_T, const Real_T (&q)[orbit_q_dim],
+	                       const Real_T (&)[orbit_q_dim], Real_T (&a)[orbit_q_dim])
+	{
+		const Real_T r = std::sqrt(q[0] * q[0] + q[1] * q[1]);
+		const Real_T r_cubed = r * r * r;
+		a[0] = -q[0] / r_cubed;
+		a[1] = -q[1] / r_cubed;
+	}
+
+	//* dt_dt_q = -g
+	void
+	ball_acceleration_fun(const Real_T, const Real_T (&)[ball_q_dim],
+	                      const Real_T (&)[ball_q_dim], Real_T (&a)[ball_q_dim])
+	{
+		a[0] = -gravity_const;
+	}
+
+	void
+	ball_ode_fun(const Real_T, const Real_T (&x)[2 * ball_q_dim],
+	             Real_T (&dt_x)[2 * ball_q_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	bool
+	event_fun(const Real_T, const Real_T (&x)[2 * ball_q_dim], Real_T (&x_plus)[2 * ball_q_dim])
+	{
+		bool did_occur = false;
+
+		if (x[0] <= 0) {
+			x_plus[0] = 0;
+			x_plus[1] = -e_restitution * x[1];
+			did_occur = true;
+		}
+		return did_occur;
+	}
+};
+Dynamics dynamics;
+
+//* error of the position and the scaled velocity, i.e. the phase and the amplitude error
+Real_T
+compute_osc_error(const Real_T t, const Real_T (&x)[2 * osc_q_dim])
+{
+	const Real_T q_error = x[0] - std::cos(omega * t);
+	const Real_T v_error = x[1] / omega + std::sin(omega * t);
+	return std::sqrt(q_error * q_error + v_error * v_error);
+}
+
+//* observed order of the method on the harmonic oscillator
+template <typename Method_T>
+Real_T
+compute_observed_order()
+{
+	using Integrator_T = rk4_solver::SymplecticIntegrator<osc_q_dim, Dynamics, Method_T>;
+	Real_T t;
+	Real_T x_coarse[2 * osc_q_dim];
+	Real_T x_fine[2 * osc_q_dim];
+
+	Integrator_T coarse_integrator(dynamics, &Dynamics::osc_acceleration_fun,
+	                               coarse_time_step);
+	rk4_solver::loop<coarse_t_dim>(coarse_integrator, t_init, osc_x_init, t, x_coarse);
+	const Real_T coarse_error = compute_osc_error(t, x_coarse);
+
+	Integrator_T fine_integrator(dynamics, &Dynamics::osc_acceleration_fun, fine_time_step);
+	rk4_solver::loop<fine_t_dim>(fine_integrator, t_init, osc_x_init, t, x_fine);
+	const Real_T fine_error = compute_osc_error(t, x_fine);
+
+	return std::log2(coarse_error / fine_error);
+}
+
+//* largest relative energy error of the orbit
+template <typename Method_T>
+Real_T
+compute_energy_error(Real_T (&t_arr)[orbit_t_dim], Real_T (&x_arr)[orbit_t_dim][2 * orbit_q_dim])
+{
+	rk4_solver::SymplecticIntegrator<orbit_q_dim, Dynamics, Method_T> integrator(
+	    dynamics, &Dynamics::orbit_acceleration_fun, orbit_time_step);
+	rk4_solver::loop(integrator, t_init, orbit_x_init, t_arr, x_arr);
+
+	Real_T energy_error = 0;
+
+	for (size_t i = 0; i < orbit_t_dim; ++i) {
+		const Real_T(&x)[2 * orbit_q_dim] = x_arr[i];
+		const Real_T r = std::sqrt(x[0] * x[0] + x[1] * x[1]);
+		const Real_T energy = (x[2] * x[2] + x[3] * x[3]) / 2 - 1 / r;
+		energy_error = std::fmax(energy_error, std::abs(energy / orbit_energy - 1));
+	}
+	return energy_error;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	const Real_T verlet_order = compute_observed_order<rk4_solver::symplectic::Verlet>();
+	const Real_T yoshida_order = compute_observed_order<rk4_solver::symplectic::Yoshida4>();
+
+	static Real_T orbit_t_arr[orbit_t_dim];
+	static Real_T orbit_x_arr[orbit_t_dim][2 * orbit_q_dim];
+	const Real_T verlet_energy_error =
+	    compute_energy_error<rk4_solver::symplectic::Verlet>(orbit_t_arr, orbit_x_arr);
+	const Real_T yoshida_energy_error =
+	    compute_energy_error<rk4_solver::symplectic::Yoshida4>(orbit_t_arr, orbit_x_arr);
+
+	//* bouncing ball with events against `Integrator`, both are exact between the bounces
+	Real_T t;
+	Real_T x[2 * ball_q_dim];
+	Real_T t_arr[1][ball_t_dim];
+	Real_T x_arr[ball_t_dim][2 * ball_q_dim];
+	Real_T x_arr_ref[ball_t_dim][2 * ball_q_dim];
+
+	rk4_solver::Event<2 * ball_q_dim, Dynamics> event(dynamics, &Dynamics::event_fun);
+	rk4_solver::SymplecticIntegrator<ball_q_dim, Dynamics> ball_integrator(
+	    dynamics, &Dynamics::ball_acceleration_fun, ball_time_step);
+	rk4_solver::loop<ball_t_dim>(ball_integrator, event, t_init, ball_x_init, t, x);
+	rk4_solver::loop(ball_integrator, event, t_init, ball_x_init, t_arr[0], x_arr);
+
+	rk4_solver::Integrator<2 * ball_q_dim, Dynamics> integrator(
+	    dynamics, &Dynamics::ball_ode_fun, ball_time_step);
+	rk4_solver::loop(integrator, event, t_init, ball_x_init, t_arr[0], x_arr_ref);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	//* the height, since a bounce can be detected a step apart in single precision
+	Real_T ball_error = 0;
+
+	for (size_t i = 0; i < ball_t_dim; ++i) {
+		ball_error = std::fmax(ball_error, std::abs(x_arr[i][0] - x_arr_ref[i][0]));
+	}
+
+	//* loop vs cumulative loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[2 * ball_q_dim] = x_arr[ball_t_dim - 1];
+
+	for (size_t i = 0; i < 2 * ball_q_dim; ++i) {
+		max_loop_error = std::fmax(max_loop_error, std::abs(x_final[i] - x[i]));
+	}
+
+	if (std::abs(verlet_order - 2) < order_thres && std::abs(yoshida_order - 4) < order_thres &&
+	    verlet_energy_error < verlet_energy_thres &&
+	    yoshida_energy_error < yoshida_energy_thres && ball_error < ball_error_thres &&
+	    max_loop_error == 0 && ball_integrator.is_good()) {
+		return 0;
+	} else {
+		printf("verlet_order = %.3g, yoshida_order = %.3g\n", verlet_order, yoshida_order);
+		printf("verlet_energy_error = %.3g, yoshida_energy_error = %.3g\n",
+		       verlet_energy_error, yoshida_energy_error);
+		printf("ball_error = %.3g\n", ball_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		return 1;
+	}
+}
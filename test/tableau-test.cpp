@@ -0,0 +1,103 @@
+#include "test_config.hpp"
+
+//* setup
+const std::string test_name = "tableau-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr size_t coarse_t_dim = 9;
+constexpr size_t fine_t_dim = 2 * coarse_t_dim - 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T order_tol = .2;
+
+struct Dynamics {
+	/*
+	 * dt_x = f(t, x) = [x_1; -x_0]
+	 * x = [cos(t); -sin(t)]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -x[0];
+	}
+};
+Dynamics dynamics;
+
+//* error of the final state with `T_DIM` points
+template <typename Tableau_T, size_t T_DIM>
+Real_T
+compute_final_error()
+{
+	constexpr Real_T time_step = (t_final - t_init) / (T_DIM - 1);
+	Real_T t;
+	Real_T x[x_dim];
+
+	rk4_solver::ExplicitIntegrator<x_dim, Dynamics, Tableau_T> integrator(
+	    dynamics, &Dynamics::ode_fun, time_step, t_init);
+	rk4_solver::loop<T_DIM>(integrator, t_init, x_init, t, x);
+
+	const Real_T x_ref[x_dim] = {std::cos(t), -std::sin(t)};
+	return std::fmax(std::abs(x[0] - x_ref[0]), std::abs(x[1] - x_ref[1]));
+}
+
+//* observed order of accuracy from halving the time step, compared with the order of the tableau
+template <typename Tableau_T>
+bool
+check_order(const char *name)
+{
+	const Real_T coarse_error = compute_final_error<Tableau_T, coarse_t_dim>();
+	const Real_T fine_error = compute_final_error<Tableau_T, fine_t_dim>();
+	const Real_T order = std::log2(coarse_error / fine_error);
+	const bool is_good = std::abs(order - Tableau_T::order) < order_tol;
+
+	if (!is_good) {
+		printf("%s: observed order = %.3g, expected %zu\n", name, order, Tableau_T::order);
+	}
+	return is_good;
+}
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	constexpr Real_T time_step = (t_final - t_init) / (fine_t_dim - 1);
+	Real_T t_arr[1][fine_t_dim];
+	Real_T x_arr[fine_t_dim][x_dim];
+	Real_T x_arr_ref[fine_t_dim][x_dim];
+
+	rk4_solver::ExplicitIntegrator<x_dim, Dynamics, rk4_solver::tableau::Rk4> integrator(
+	    dynamics, &Dynamics::ode_fun, time_step, t_init);
+	rk4_solver::loop(integrator, t_init, x_init, t_arr[0], x_arr);
+
+	rk4_solver::Integrator<x_dim, Dynamics> rk4_integrator(dynamics, &Dynamics::ode_fun,
+	                                                       time_step, t_init);
+	rk4_solver::loop(rk4_integrator, t_init, x_init, t_arr[0], x_arr_ref);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	//* the Rk4 tableau does the same arithmetic as the hand-written Runge-Kutta 4th Order
+	const Real_T max_error = test_config::compute_max_error(x_arr, x_arr_ref);
+
+	bool is_order_good = check_order<rk4_solver::tableau::Euler>("Euler");
+	is_order_good &= check_order<rk4_solver::tableau::Heun>("Heun");
+	is_order_good &= check_order<rk4_solver::tableau::Ralston>("Ralston");
+	is_order_good &= check_order<rk4_solver::tableau::Rk3>("Rk3");
+	is_order_good &= check_order<rk4_solver::tableau::Rk4>("Rk4");
+	is_order_good &= check_order<rk4_solver::tableau::Rk38>("Rk38");
+
+	if (max_error == 0 && is_order_good) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		return 1;
+	}
+}
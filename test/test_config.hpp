@@ -33,7 +33,10 @@
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <limits>
+#include <memory>
 #include <string>
+#include <sys/stat.h>
 
 using rk4_solver::Real_T;
 using rk4_solver::size_t;
@@ -50,6 +53,7 @@ const std::string ref_dat_dir = "../../test/reference_dat"; //* reference data d
 const std::string t_arr_fname = "t_arr.dat";                //* file name for the time array
 const std::string x_arr_fname = "x_arr.dat";                //* file name for the x array
 const std::string x_arr_ref_fname = "x_arr_ref.dat";        //* file name for the reference x array
+const std::string x_arr_ref_bin_fname = "x_arr_ref.bin";    //* file name for the cached reference
 
 template <size_t T_DIM, size_t X_DIM>
 Real_T
@@ -71,6 +75,87 @@ compute_max_error(const Real_T (&arr)[T_DIM][X_DIM], const Real_T (&arr_ref)[T_D
 	}
 	return max_error;
 }
+
+/*
+ * Computes the maximum error of the columns `[j_begin, j_end)` directly over the mapped reference.
+ * Returns infinity if the dimensions do not match.
+ */
+template <size_t T_DIM, size_t X_DIM>
+Real_T
+compute_max_error(const Real_T (&arr)[T_DIM][X_DIM],
+                  const rk4_solver::TrajectoryReader<X_DIM> &reader, const size_t j_begin = 0,
+                  const size_t j_end = X_DIM)
+{
+	if (!reader.is_good() || reader.get_t_dim() != T_DIM) {
+		return std::numeric_limits<Real_T>::infinity();
+	}
+	Real_T max_error = 0.;
+
+	for (size_t i = 0; i < T_DIM; ++i) {
+		const Real_T(&a)[X_DIM] = arr[i];
+		const Real_T(&a_ref)[X_DIM] = reader.get_x(i);
+
+		for (size_t j = j_begin; j < j_end; ++j) {
+			const Real_T error = std::abs(a[j] - a_ref[j]);
+
+			if (error > max_error) {
+				max_error = error;
+			}
+		}
+	}
+	return max_error;
+}
+
+/*
+ * Maps the reference x array of a test. The reference `.dat` file is parsed and cached as a binary
+ * trajectory in the temporary data directory, the cache is rebuilt if it is older than the `.dat`
+ * file. Nothing is cached if the `.dat` file is missing or not fully parsed.
+ */
+template <size_t T_DIM, size_t X_DIM>
+bool
+map_reference(const std::string &test_name, const Real_T t_init, const Real_T time_step,
+              rk4_solver::TrajectoryReader<X_DIM> &reader)
+{
+	const std::string dat_fname = ref_dat_dir + "/" + test_name + "-" + x_arr_ref_fname;
+	const std::string bin_fname = dat_dir + "/" + test_name + "-" + x_arr_ref_bin_fname;
+	struct stat dat_stat;
+	struct stat bin_stat;
+
+	if (stat(dat_fname.c_str(), &dat_stat) != 0) {
+		reader.close();
+		return false;
+	}
+	if (stat(bin_fname.c_str(), &bin_stat) == 0 && bin_stat.st_mtime >= dat_stat.st_mtime &&
+	    reader.open(bin_fname.c_str()) && reader.get_t_dim() == T_DIM) {
+		return true;
+	}
+	reader.close();
+	std::unique_ptr<Real_T[]> t_buf(new Real_T[T_DIM]);
+	std::unique_ptr<Real_T[][X_DIM]> x_buf(new Real_T[T_DIM][X_DIM]);
+	Real_T(&t_arr_ref)[T_DIM] = *(Real_T(*)[T_DIM])t_buf.get();
+	Real_T(&x_arr_ref)[T_DIM][X_DIM] = *(Real_T(*)[T_DIM][X_DIM])x_buf.get();
+
+	for (size_t i = 0; i < T_DIM; ++i) {
+		t_arr_ref[i] = t_init + i * time_step;
+
+		for (size_t j = 0; j < X_DIM; ++j) {
+			x_arr_ref[i][j] = std::numeric_limits<Real_T>::quiet_NaN();
+		}
+	}
+	matrix_rw::read(dat_fname, x_arr_ref);
+
+	//* a value left NaN was not parsed, e.g. the file is truncated
+	for (size_t i = 0; i < T_DIM; ++i) {
+		for (size_t j = 0; j < X_DIM; ++j) {
+			if (!std::isfinite(x_arr_ref[i][j])) {
+				return false;
+			}
+		}
+	}
+	return rk4_solver::write_trajectory(bin_fname.c_str(), t_init, time_step, t_arr_ref,
+	                                    x_arr_ref) &&
+	       reader.open(bin_fname.c_str()) && reader.get_t_dim() == T_DIM;
+}
 } // namespace test_config
 
 #endif
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "test_config.hpp"
+
+/*
+ * Same as ball-test, but the impacts are located within the steps, so a 10 times larger time step
+ * is used and the result is verified against the exact solution.
+ */
+
+//* setup
+const std::string test_name = "zero_crossing-test";
+const std::string dat_prefix = test_config::dat_dir + "/" + test_name + "-";
+
+constexpr size_t sample_freq = 1e3;
+constexpr Real_T time_step = 1. / sample_freq;
+constexpr Real_T t_init = 0.;
+constexpr Real_T t_final = 2.;
+constexpr size_t t_dim = sample_freq * (t_final - t_init) + 1;
+constexpr size_t x_dim = 2;
+constexpr Real_T x_init[x_dim] = {1., 0.};
+constexpr Real_T e_restitution = .75;
+constexpr Real_T gravity_const = 9.806;
+
+#ifdef USE_SINGLE_PRECISION
+constexpr Real_T error_thres = 2e-3;
+#else
+constexpr Real_T error_thres = 1e-9;
+#endif
+constexpr size_t verify_idx = 0;
+constexpr Real_T coarse_time_step = .6; //* the bounces before 3 s get shorter than a step
+constexpr size_t coarse_t_dim = 6;
+
+/*
+ * Exact height of the ball, found by stepping from impact to impact analytically.
+ */
+Real_T
+get_exact_height(const Real_T t)
+{
+	Real_T x_0 = x_init[0];
+	Real_T x_1 = x_init[1];
+	Real_T t_impact = t_init;
+
+	while (true) {
+		const Real_T t_fall =
+		    (x_1 + std::sqrt(x_1 * x_1 + 2 * gravity_const * x_0)) / gravity_const;
+
+		if (t_impact + t_fall >= t) {
+			const Real_T dt = t - t_impact;
+			return x_0 + x_1 * dt - gravity_const * dt * dt / 2;
+		}
+		x_1 = -e_restitution * (x_1 - gravity_const * t_fall);
+		x_0 = 0;
+		t_impact += t_fall;
+	}
+}
+
+struct Dynamics {
+	/*
+	 * Ball equations:
+	 * dt_x =  [x2; -g]
+	 */
+	void
+	ode_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&dt_x)[x_dim])
+	{
+		dt_x[0] = x[1];
+		dt_x[1] = -gravity_const;
+	}
+
+	//* impact when the height falls through zero
+	Real_T
+	guard_fun(const Real_T, const Real_T (&x)[x_dim])
+	{
+		return x[0];
+	}
+
+	void
+	reset_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		x_plus[0] = 0;
+		x_plus[1] = -e_restitution * x[1];
+	}
+
+	//* keeps the height, which is at or just below zero after the crossing was located
+	void
+	bounce_fun(const Real_T, const Real_T (&x)[x_dim], Real_T (&x_plus)[x_dim])
+	{
+		x_plus[0] = x[0];
+		x_plus[1] = -e_restitution * x[1];
+	}
+};
+Dynamics dynamics;
+
+int
+main()
+{
+	//* 1. read the reference data
+	//* no reference data
+
+	//* 2. test
+	Real_T t = 0;
+	Real_T x[x_dim];
+	Real_T t_arr[1][t_dim];
+	Real_T x_arr[t_dim][x_dim];
+
+	rk4_solver::Integrator<x_dim, Dynamics> integrator(dynamics, &Dynamics::ode_fun, time_step);
+	rk4_solver::ZeroCrossingEvent<x_dim, Dynamics> event(
+	    dynamics, &Dynamics::guard_fun, &Dynamics::reset_fun, rk4_solver::Crossing::falling);
+
+	rk4_solver::loop<t_dim>(integrator, event, t_init, x_init, t, x);
+
+	rk4_solver::loop(integrator, event, t_init, x_init, t_arr[0], x_arr);
+
+	//* 3. write the test data
+	matrix_rw::write(dat_prefix + test_config::t_arr_fname, t_arr);
+	matrix_rw::write(dat_prefix + test_config::x_arr_fname, x_arr);
+
+	//* 4. verify the results
+	Real_T x_0_arr[1][t_dim];
+	Real_T x_0_arr_ref[1][t_dim];
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		x_0_arr[0][i] = x_arr[i][verify_idx];
+		x_0_arr_ref[0][i] = get_exact_height(t_arr[0][i]);
+	}
+	Real_T max_error = test_config::compute_max_error(x_0_arr, x_0_arr_ref);
+
+	//* loop vs cum_loop sanity check
+	Real_T max_loop_error = 0.;
+	const Real_T(&x_final)[x_dim] = x_arr[t_dim - 1];
+
+	for (size_t i = 0; i < x_dim; ++i) {
+		const Real_T error = std::abs(x_final[i] - x[i]);
+
+		if (error > max_loop_error) {
+			max_loop_error = error;
+		}
+	}
+
+	//* terminal event sanity check, the first impact is at t = sqrt(2/g)
+	constexpr bool is_terminal = true;
+	rk4_solver::ZeroCrossingEvent<x_dim, Dynamics> terminal_event(
+	    dynamics, &Dynamics::guard_fun, &Dynamics::reset_fun, rk4_solver::Crossing::falling,
+	    is_terminal);
+	rk4_solver::loop<t_dim>(integrator, terminal_event, t_init, x_init, t, x);
+	const Real_T impact_error = std::abs(t - std::sqrt(2 / gravity_const));
+
+	//* in both directions, the bounce off the floor is not taken as a rising crossing
+	rk4_solver::ZeroCrossingEvent<x_dim, Dynamics> both_event(dynamics, &Dynamics::guard_fun,
+	                                                          &Dynamics::bounce_fun);
+	rk4_solver::loop(integrator, both_event, t_init, x_init, t_arr[0], x_arr);
+
+	for (size_t i = 0; i < t_dim; ++i) {
+		x_0_arr[0][i] = x_arr[i][verify_idx];
+	}
+	const Real_T both_error = test_config::compute_max_error(x_0_arr, x_0_arr_ref);
+
+	//* the ball bounces and falls back onto the floor within one step, several times
+	rk4_solver::Integrator<x_dim, Dynamics> coarse_integrator(dynamics, &Dynamics::ode_fun,
+	                                                          coarse_time_step);
+	Real_T coarse_error = 0;
+
+	for (const auto &coarse_event : {event, both_event}) {
+		rk4_solver::loop<coarse_t_dim>(coarse_integrator, coarse_event, t_init, x_init, t,
+		                               x);
+		coarse_error = std::fmax(coarse_error, std::abs(x[0] - get_exact_height(t)));
+	}
+
+	if (max_error < error_thres && max_loop_error <= std::numeric_limits<Real_T>::epsilon() &&
+	    impact_error < error_thres && both_error < error_thres && coarse_error < error_thres) {
+		return 0;
+	} else {
+		printf("max_error = %.3g\n", max_error);
+		printf("max_loop_error = %.3g\n", max_loop_error);
+		printf("impact_error = %.3g\n", impact_error);
+		printf("both_error = %.3g\n", both_error);
+		printf("coarse_error = %.3g\n", coarse_error);
+		return 1;
+	}
+}